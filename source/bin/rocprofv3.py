@@ -309,6 +309,20 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         default=None,
         type=int,
     )
+
+    add_parser_bool_argument(
+        pc_sampling_options,
+        "--pc-sampling-aggregate",
+        help="Aggregate the PC samples per instruction (sample count, active lanes, first and last sample) while sampling instead of writing every sample. Only the aggregated table (and the samples retained by --pc-sampling-reservoir-size) is written. The table is written in the CSV and JSON output formats",
+    )
+
+    pc_sampling_options.add_argument(
+        "--pc-sampling-reservoir-size",
+        help="With --pc-sampling-aggregate, retain a uniform random sample of N raw PC samples which are written to the regular PC sampling outputs",
+        default=None,
+        type=int,
+        metavar="N",
+    )
     basic_tracing_options = parser.add_argument_group("Basic tracing options")
 
     # Add the arguments
@@ -396,6 +410,30 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         help="For collecting HSA API Traces (Finalizer-extension API), e.g. HSA functions prefixed with only 'hsa_ext_program_' (i.e. hsa_ext_program_create).",
     )
 
+    api_sampling_options = parser.add_argument_group("HIP and HSA API sampling options")
+
+    api_sampling_options.add_argument(
+        "--api-sampling-interval",
+        help="Only trace one out of every N calls to each HIP and HSA API function. The statistics (--stats, --summary) extrapolate the number of calls and the total duration from the sampled calls",
+        default=None,
+        type=int,
+        metavar="N",
+    )
+    api_sampling_options.add_argument(
+        "--api-sampling-first",
+        help="Trace the first K calls to each HIP and HSA API function before sampling one out of every N calls (see --api-sampling-interval)",
+        default=None,
+        type=int,
+        metavar="K",
+    )
+    api_sampling_options.add_argument(
+        "--api-sampling-rate-limit",
+        help="Trace at most this many calls per second to each HIP and HSA API function. Takes precedence over --api-sampling-interval",
+        default=None,
+        type=int,
+        metavar="CALLS_PER_SEC",
+    )
+
     counter_collection_options = parser.add_argument_group("Counter collection options")
 
     counter_collection_options.add_argument(
@@ -415,6 +453,11 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         "--stats",
         help="For collecting statistics of enabled tracing types. Must be combined with one or more tracing options. No default kernel stats unlike previous rocprof versions",
     )
+    add_parser_bool_argument(
+        post_processing_options,
+        "--aggregate",
+        help="Aggregate the durations of the enabled tracing types into per-operation statistics and latency histograms while the application runs instead of storing every record. Implies --stats. No trace files are written for the aggregated tracing types",
+    )
     add_parser_bool_argument(
         post_processing_options,
         "-S",
@@ -564,6 +607,14 @@ For MPI applications (or other job launchers such as SLURM), place rocprofv3 ins
         nargs="*",
     )
 
+    advanced_options.add_argument(
+        "--codeobj-cache-dir",
+        help="Directory for caching the symbols, source lines, and disassembled instructions of code objects between runs. Code objects are identified by a hash of their contents",
+        default=None,
+        type=str,
+        metavar="DIR",
+    )
+
     advanced_options.add_argument(
         "--att-library-path",
         default=os.environ.get(
@@ -914,6 +965,9 @@ def run(app_args, args, **kwargs):
 
     update_env("ROCPROF_OUTPUT_FILE_NAME", _output_file)
     update_env("ROCPROF_OUTPUT_PATH", _output_path)
+
+    if args.codeobj_cache_dir is not None:
+        update_env("ROCPROFILER_CODEOBJ_CACHE_DIR", os.path.abspath(args.codeobj_cache_dir))
     if app_pass is not None and args.sub_directory is not None:
         app_env["ROCPROF_OUTPUT_PATH"] = os.path.join(
             f"{_output_path}", f"{args.sub_directory}{app_pass}"
@@ -1005,6 +1059,7 @@ def run(app_args, args, **kwargs):
         # if no tracing was enabled but the options below were enabled, raise an error
         for oitr in [
             "stats",
+            "aggregate",
             "summary",
             "summary-per-domain",
             "summary-groups",
@@ -1035,6 +1090,7 @@ def run(app_args, args, **kwargs):
         _summary_output_fname = _summary_output_fname.lower()
 
     update_env("ROCPROF_STATS", args.stats, overwrite_if_true=True)
+    update_env("ROCPROF_AGGREGATE", args.aggregate, overwrite_if_true=True)
     update_env("ROCPROF_STATS_SUMMARY", args.summary, overwrite_if_true=True)
     update_env("ROCPROF_STATS_SUMMARY_UNITS", args.summary_units, overwrite=True)
     update_env("ROCPROF_STATS_SUMMARY_OUTPUT", _summary_output_fname, overwrite=True)
@@ -1054,6 +1110,27 @@ def run(app_args, args, **kwargs):
         args.truncate_kernels,
         overwrite_if_true=True,
     )
+    for opt, env_var in (
+        ["api_sampling_interval", "API_SAMPLING_INTERVAL"],
+        ["api_sampling_first", "API_SAMPLING_FIRST"],
+        ["api_sampling_rate_limit", "API_SAMPLING_RATE_LIMIT"],
+    ):
+        val = getattr(args, opt)
+        if val is not None:
+            if val < 0:
+                fatal_error(f"--{opt.replace('_', '-')} must not be negative")
+            update_env(f"ROCPROF_{env_var}", val, overwrite=True)
+
+    if (
+        args.api_sampling_first is not None
+        and args.api_sampling_first > 0
+        and (args.api_sampling_interval is None or args.api_sampling_interval <= 1)
+        and not args.api_sampling_rate_limit
+    ):
+        fatal_error(
+            "--api-sampling-first requires --api-sampling-interval with a value greater than 1"
+        )
+
     update_env(
         "ROCPROF_LIST_AVAIL",
         args.list_avail,
@@ -1204,6 +1281,19 @@ def run(app_args, args, **kwargs):
         update_env("ROCPROF_PC_SAMPLING_UNIT", args.pc_sampling_unit)
         update_env("ROCPROF_PC_SAMPLING_METHOD", args.pc_sampling_method)
         update_env("ROCPROF_PC_SAMPLING_INTERVAL", args.pc_sampling_interval)
+        update_env(
+            "ROCPROF_PC_SAMPLING_AGGREGATE",
+            args.pc_sampling_aggregate,
+            overwrite_if_true=True,
+        )
+        if args.pc_sampling_reservoir_size is not None:
+            if args.pc_sampling_reservoir_size < 0:
+                fatal_error("PC sampling reservoir size must not be negative.")
+            update_env(
+                "ROCPROF_PC_SAMPLING_RESERVOIR_SIZE",
+                args.pc_sampling_reservoir_size,
+                overwrite=True,
+            )
 
     if args.advanced_thread_trace:
 
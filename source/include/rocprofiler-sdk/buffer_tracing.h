@@ -50,6 +50,7 @@ typedef struct
     rocprofiler_timestamp_t           start_timestamp;  ///< start time in nanoseconds
     rocprofiler_timestamp_t           end_timestamp;    ///< end time in nanoseconds
     rocprofiler_thread_id_t           thread_id;        ///< id for thread generating this record
+    uint64_t                          sampling_weight;  ///< number of calls this record represents
 
     /// @var kind
     /// @brief ::ROCPROFILER_CALLBACK_TRACING_HSA_CORE_API,
@@ -60,6 +61,10 @@ typedef struct
     /// @brief Specification of the API function, e.g., ::rocprofiler_hsa_core_api_id_t,
     /// ::rocprofiler_hsa_amd_ext_api_id_t, ::rocprofiler_hsa_image_ext_api_id_t, or
     /// ::rocprofiler_hsa_finalize_ext_api_id_t
+    /// @var sampling_weight
+    /// @brief 1 unless sampling was configured via
+    /// ::rocprofiler_configure_buffer_tracing_sampling, in which case it is the number of calls to
+    /// the operation since the previous record for the operation (inclusive)
 } rocprofiler_buffer_tracing_hsa_api_record_t;
 
 /**
@@ -74,6 +79,7 @@ typedef struct
     rocprofiler_timestamp_t           start_timestamp;  ///< start time in nanoseconds
     rocprofiler_timestamp_t           end_timestamp;    ///< end time in nanoseconds
     rocprofiler_thread_id_t           thread_id;        ///< id for thread generating this record
+    uint64_t                          sampling_weight;  ///< number of calls this record represents
 
     /// @var kind
     /// @brief ::ROCPROFILER_CALLBACK_TRACING_HIP_RUNTIME_API or
@@ -81,6 +87,10 @@ typedef struct
     /// @var operation
     /// @brief Specification of the API function, e.g., ::rocprofiler_hip_runtime_api_id_t or
     /// ::rocprofiler_hip_compiler_api_id_t
+    /// @var sampling_weight
+    /// @brief 1 unless sampling was configured via
+    /// ::rocprofiler_configure_buffer_tracing_sampling, in which case it is the number of calls to
+    /// the operation since the previous record for the operation (inclusive)
 } rocprofiler_buffer_tracing_hip_api_record_t;
 
 /**
@@ -30,11 +30,13 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "codeobj_cache.hpp"
 #include "disassembly.hpp"
 #include "segment.hpp"
 
@@ -66,105 +68,44 @@ struct Instruction
 
 class CodeobjDecoderComponent
 {
-    struct ProtectedFd
-    {
-        ProtectedFd(std::string_view uri)
-        {
-#if defined(_GNU_SOURCE) && defined(MFD_ALLOW_SEALING) && defined(MFD_CLOEXEC)
-            m_fd = ::memfd_create(uri.data(), MFD_ALLOW_SEALING | MFD_CLOEXEC);
-#endif
-            if(m_fd == -1) m_fd = ::open("/tmp", O_TMPFILE | O_RDWR, 0666);
-            if(m_fd == -1) throw std::runtime_error("Could not create a file for codeobj!");
-        }
-        ~ProtectedFd()
-        {
-            if(m_fd != -1) ::close(m_fd);
-        }
-        int m_fd{-1};
-    };
-
 public:
     CodeobjDecoderComponent(const char* codeobj_data, uint64_t codeobj_size)
-    {
-        ProtectedFd prot("");
-        if(::write(prot.m_fd, codeobj_data, codeobj_size) != static_cast<int64_t>(codeobj_size))
-            throw std::runtime_error("Could not write to temporary file!");
-
-        ::lseek(prot.m_fd, 0, SEEK_SET);
-        fsync(prot.m_fd);
+    : CodeobjDecoderComponent(CodeobjView::copy(codeobj_data, codeobj_size))
+    {}
 
-        m_line_number_map = {};
+    explicit CodeobjDecoderComponent(std::shared_ptr<const CodeobjView> view)
+    {
+        if(auto cache_dir = CodeobjCache::get_directory(); !cache_dir.empty())
+            m_cache = std::make_unique<CodeobjCache>(cache_dir, *view);
 
-        std::unique_ptr<Dwarf, void (*)(Dwarf*)> dbg(dwarf_begin(prot.m_fd, DWARF_C_READ),
-                                                     [](Dwarf* _dbg) { dwarf_end(_dbg); });
+        // Can throw
+        disassembly = std::make_unique<DisassemblyInstance>(std::move(view));
 
-        if(dbg)
+        if(m_cache && m_cache->is_loaded())
         {
-            Dwarf_Off cu_offset{0}, next_offset;
-            size_t    header_size;
-
-            std::map<uint64_t, std::string> line_addrs;
-
-            while(
-                dwarf_nextcu(
-                    dbg.get(), cu_offset, &next_offset, &header_size, nullptr, nullptr, nullptr) ==
-                0)
-            {
-                Dwarf_Die die;
-                if(!dwarf_offdie(dbg.get(), cu_offset + header_size, &die)) continue;
-
-                Dwarf_Lines* lines;
-                size_t       line_count;
-                if(dwarf_getsrclines(&die, &lines, &line_count) != 0) continue;
-
-                for(size_t i = 0; i < line_count; ++i)
-                {
-                    Dwarf_Addr  addr;
-                    int         line_number;
-                    Dwarf_Line* line = dwarf_onesrcline(lines, i);
-
-                    if(line && dwarf_lineaddr(line, &addr) == 0 &&
-                       dwarf_lineno(line, &line_number) == 0 && line_number != 0)
-                    {
-                        std::string src        = dwarf_linesrc(line, nullptr, nullptr);
-                        auto        dwarf_line = src + ':' + std::to_string(line_number);
-
-                        if(line_addrs.find(addr) != line_addrs.end())
-                        {
-                            line_addrs.at(addr) += ' ' + dwarf_line;
-                            continue;
-                        }
-
-                        line_addrs.emplace(addr, std::move(dwarf_line));
-                    }
-                }
-                cu_offset = next_offset;
-            }
-
-            auto it = line_addrs.begin();
-            if(it != line_addrs.end())
-            {
-                while(std::next(it) != line_addrs.end())
-                {
-                    uint64_t delta   = std::next(it)->first - it->first;
-                    auto     segment = segment::address_range_t{it->first, delta, 0};
-                    m_line_number_map.emplace(segment, std::move(it->second));
-                    it++;
-                }
-                auto segment = segment::address_range_t{it->first, codeobj_size - it->first, 0};
-                m_line_number_map.emplace(segment, std::move(it->second));
-            }
+            m_symbol_map = m_cache->get_symbols();
+            return;
         }
 
-        // Can throw
-        disassembly = std::make_unique<DisassemblyInstance>(codeobj_data, codeobj_size);
         try
         {
             m_symbol_map = disassembly->GetKernelMap();  // Can throw
         } catch(...)
         {}
     }
-    ~CodeobjDecoderComponent() = default;
+
+    /// writes the instructions disassembled since the last flush to the cache
+    void flush_cache()
+    {
+        if(!m_cache || m_cached_instructions.size() == m_num_flushed) return;
+
+        try
+        {
+            m_cache->save(m_symbol_map, m_line_number_map, m_cached_instructions);
+            m_num_flushed = m_cached_instructions.size();
+        } catch(...)
+        {}
+    }
 
     std::optional<uint64_t> va2fo(uint64_t vaddr) const
     {
@@ -176,13 +117,23 @@ public:
     {
         if(!disassembly) throw std::exception();
 
-        auto pair   = disassembly->ReadInstruction(faddr);
+        auto pair = std::pair<std::string, size_t>{};
+        if(auto cached = (m_cache) ? m_cache->find_instruction(faddr) : std::nullopt)
+        {
+            pair = std::move(*cached);
+        }
+        else
+        {
+            pair = disassembly->ReadInstruction(faddr);
+            if(m_cache) m_cached_instructions.emplace(faddr, pair);
+        }
+
         auto inst   = std::make_unique<Instruction>(std::move(pair.first), pair.second);
         inst->faddr = faddr;
         inst->vaddr = vaddr;
 
-        auto it = m_line_number_map.find({vaddr, 0, 0});
-        if(it != m_line_number_map.end()) inst->comment = it->second;
+        std::call_once(m_line_number_once, [this]() { load_line_numbers(); });
+        if(const auto* line = m_line_number_map.find(vaddr)) inst->comment = *line;
 
         return inst;
     }
@@ -191,7 +142,89 @@ public:
     std::vector<std::shared_ptr<Instruction>> instructions{};
     std::unique_ptr<DisassemblyInstance>      disassembly{};
 
-    std::map<segment::address_range_t, std::string> m_line_number_map{};
+    segment::flat_range_map<std::string> m_line_number_map{};
+
+private:
+    // the DWARF line table is only parsed when the first instruction is disassembled
+    void load_line_numbers()
+    {
+        if(m_cache && m_cache->is_loaded())
+        {
+            m_cache->get_lines(m_line_number_map);
+            return;
+        }
+
+        const auto& view = disassembly->view;
+
+        elf_version(EV_CURRENT);
+        std::unique_ptr<Elf, int (*)(Elf*)> elf(
+            elf_memory(view->mutable_data(), view->size()), &elf_end);
+        if(!elf) return;
+
+        std::unique_ptr<Dwarf, int (*)(Dwarf*)> dbg(
+            dwarf_begin_elf(elf.get(), DWARF_C_READ, nullptr), &dwarf_end);
+        if(!dbg) return;
+
+        Dwarf_Off cu_offset{0}, next_offset;
+        size_t    header_size;
+
+        std::map<uint64_t, std::string> line_addrs;
+
+        while(dwarf_nextcu(
+                  dbg.get(), cu_offset, &next_offset, &header_size, nullptr, nullptr, nullptr) == 0)
+        {
+            Dwarf_Die die;
+            if(!dwarf_offdie(dbg.get(), cu_offset + header_size, &die)) continue;
+
+            Dwarf_Lines* lines;
+            size_t       line_count;
+            if(dwarf_getsrclines(&die, &lines, &line_count) != 0) continue;
+
+            for(size_t i = 0; i < line_count; ++i)
+            {
+                Dwarf_Addr  addr;
+                int         line_number;
+                Dwarf_Line* line = dwarf_onesrcline(lines, i);
+
+                if(line && dwarf_lineaddr(line, &addr) == 0 &&
+                   dwarf_lineno(line, &line_number) == 0 && line_number != 0)
+                {
+                    std::string src        = dwarf_linesrc(line, nullptr, nullptr);
+                    auto        dwarf_line = src + ':' + std::to_string(line_number);
+
+                    if(line_addrs.find(addr) != line_addrs.end())
+                    {
+                        line_addrs.at(addr) += ' ' + dwarf_line;
+                        continue;
+                    }
+
+                    line_addrs.emplace(addr, std::move(dwarf_line));
+                }
+            }
+            cu_offset = next_offset;
+        }
+
+        m_line_number_map.reserve(line_addrs.size());
+
+        auto it = line_addrs.begin();
+        if(it != line_addrs.end())
+        {
+            while(std::next(it) != line_addrs.end())
+            {
+                uint64_t delta   = std::next(it)->first - it->first;
+                auto     segment = segment::address_range_t{it->first, delta, 0};
+                m_line_number_map.emplace(segment, std::move(it->second));
+                it++;
+            }
+            auto segment = segment::address_range_t{it->first, view->size() - it->first, 0};
+            m_line_number_map.emplace(segment, std::move(it->second));
+        }
+    }
+
+    std::once_flag                  m_line_number_once{};
+    std::unique_ptr<CodeobjCache>   m_cache{};
+    CodeobjCache::instruction_map_t m_cached_instructions{};
+    size_t                          m_num_flushed = 0;
 };
 
 class LoadedCodeobjDecoder
@@ -207,23 +240,11 @@ public:
 
         if(fpath.rfind(".out") + 4 == fpath.size())
         {
-            std::ifstream file(filepath, std::ios::in | std::ios::binary);
-
-            if(!file.is_open()) throw std::runtime_error("Invalid file " + std::string(filepath));
-
-            std::vector<char> buffer;
-            file.seekg(0, file.end);
-            buffer.resize(file.tellg());
-            file.seekg(0, file.beg);
-            file.read(buffer.data(), buffer.size());
-
-            decoder = std::make_unique<CodeobjDecoderComponent>(buffer.data(), buffer.size());
+            decoder = std::make_unique<CodeobjDecoderComponent>(CodeobjView::map_file(filepath));
         }
         else
         {
-            std::unique_ptr<CodeObjectBinary> binary = std::make_unique<CodeObjectBinary>(filepath);
-            auto&                             buffer = binary->buffer;
-            decoder = std::make_unique<CodeobjDecoderComponent>(buffer.data(), buffer.size());
+            decoder = std::make_unique<CodeobjDecoderComponent>(CodeObjectBinary{filepath}.view);
         }
     }
     LoadedCodeobjDecoder(const void* data, uint64_t size, uint64_t _load_addr, size_t _memsize)
@@ -267,6 +288,11 @@ public:
         if(!decoder) throw std::exception();
         return decoder->m_symbol_map;
     }
+
+    void flush_cache()
+    {
+        if(decoder) decoder->flush_cache();
+    }
     const uint64_t load_addr;
 
 private:
@@ -302,7 +328,22 @@ public:
             std::make_shared<LoadedCodeobjDecoder>(data, memory_size, load_addr, memsize);
     }
 
-    virtual bool removeDecoderbyId(marker_id_t id) { return decoders.erase(id) != 0; }
+    virtual bool removeDecoderbyId(marker_id_t id)
+    {
+        auto it = decoders.find(id);
+        if(it == decoders.end()) return false;
+
+        it->second->flush_cache();
+        decoders.erase(it);
+        return true;
+    }
+
+    /// writes the disassembled instructions of all decoders to the code object cache
+    void flush_cache()
+    {
+        for(auto& [id, decoder] : decoders)
+            decoder->flush_cache();
+    }
 
     std::unique_ptr<Instruction> get(marker_id_t id, uint64_t offset)
     {
@@ -376,6 +417,13 @@ public:
         return this->Super::get(addr_range.id, vaddr - addr_range.addr);
     }
 
+    /// id of the code object loaded at the address, 0 if there is none
+    marker_id_t find_codeobj_id(uint64_t vaddr) const
+    {
+        auto addr_range = table.lookup(vaddr);
+        return (addr_range) ? addr_range->id : 0;
+    }
+
     std::unique_ptr<Instruction> get(marker_id_t id, uint64_t offset)
     {
         if(id == 0)
@@ -386,12 +434,12 @@ public:
 
     const char* getSymbolName(uint64_t vaddr)
     {
-        for(auto& [_, decoder] : decoders)
-        {
-            if(!decoder->inrange(vaddr)) continue;
-            return decoder->getSymbolName(vaddr);
-        }
-        return nullptr;
+        auto addr_range = table.lookup(vaddr);
+        if(!addr_range) return nullptr;
+
+        auto it = decoders.find(addr_range->id);
+        if(it == decoders.end()) return nullptr;
+        return it->second->getSymbolName(vaddr);
     }
 
     std::map<uint64_t, SymbolInfo> getSymbolMap() const
@@ -0,0 +1,410 @@
+// MIT License
+//
+// Copyright (c) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "disassembly.hpp"
+#include "segment.hpp"
+
+#include <rocprofiler-sdk/version.h>
+
+#include <amd_comgr/amd_comgr.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(CODEOBJ_CACHE_WARNING)
+#    define CODEOBJ_CACHE_WARNING(msg)                                                             \
+        std::cerr << __FILE__ << ':' << __LINE__ << " code object cache: " << msg << "\n"
+#endif
+
+namespace rocprofiler
+{
+namespace sdk
+{
+namespace codeobj
+{
+namespace disassembly
+{
+/**
+ * @brief On-disk cache of the symbols, source lines and disassembled instructions of a code object.
+ * Code objects mapped from files are keyed by the identity of the file (device, inode, size and
+ * modification time) and the mapped range, so opening them does not read the whole code object.
+ * Copied code objects are keyed by a hash of their contents. The cache directory is read from the
+ * ROCPROFILER_CODEOBJ_CACHE_DIR environment variable, caching is disabled if it is not set.
+ *
+ * A cache file is a header followed by arrays of fixed size records and a string table. The
+ * instruction records are sorted by file offset and are searched in the memory mapped file. The
+ * header records the versions of comgr and rocprofiler-sdk which wrote it, a cache file written
+ * by other versions is ignored and rewritten since their disassembly may differ.
+ */
+class CodeobjCache
+{
+public:
+    static constexpr uint32_t version = 3;
+
+    struct header_t
+    {
+        char     magic[8]            = {'R', 'O', 'C', 'P', 'C', 'O', 'D', 'E'};
+        uint32_t version             = CodeobjCache::version;
+        uint32_t reserved            = 0;
+        uint64_t codeobj_key         = 0;
+        uint64_t codeobj_size        = 0;
+        uint64_t toolchain_version   = 0;
+        uint64_t num_symbols         = 0;
+        uint64_t num_lines           = 0;
+        uint64_t num_instructions    = 0;
+        uint64_t symbols_offset      = 0;
+        uint64_t lines_offset        = 0;
+        uint64_t instructions_offset = 0;
+        uint64_t file_size           = 0;
+    };
+
+    struct string_ref_t
+    {
+        uint64_t offset = 0;
+        uint64_t length = 0;
+    };
+
+    struct symbol_record_t
+    {
+        uint64_t     vaddr    = 0;
+        uint64_t     faddr    = 0;
+        uint64_t     mem_size = 0;
+        string_ref_t name     = {};
+    };
+
+    struct line_record_t
+    {
+        uint64_t     addr = 0;
+        uint64_t     size = 0;
+        string_ref_t line = {};
+    };
+
+    struct instruction_record_t
+    {
+        uint64_t     faddr = 0;
+        uint64_t     size  = 0;
+        string_ref_t inst  = {};
+    };
+
+    using instruction_map_t = std::map<uint64_t, std::pair<std::string, size_t>>;
+    using line_map_t        = segment::flat_range_map<std::string>;
+
+    static std::string get_directory()
+    {
+        const char* _dir = std::getenv("ROCPROFILER_CODEOBJ_CACHE_DIR");
+        return (_dir) ? std::string{_dir} : std::string{};
+    }
+
+    /// 64-bit hash of the code object contents, processed in 8 byte words
+    static uint64_t hash(const char* data, size_t size)
+    {
+        constexpr uint64_t k0 = 0x9e3779b97f4a7c15ULL;
+        constexpr uint64_t k1 = 0xbf58476d1ce4e5b9ULL;
+
+        auto mix = [](uint64_t _val) {
+            _val ^= _val >> 31;
+            _val *= k1;
+            return _val ^ (_val >> 29);
+        };
+
+        uint64_t _hash = size * k0;
+        size_t   i     = 0;
+        for(; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+        {
+            uint64_t _word = 0;
+            std::memcpy(&_word, data + i, sizeof(uint64_t));
+            _hash ^= mix(_word);
+            _hash = ((_hash << 27) | (_hash >> 37)) * k0;
+        }
+
+        uint64_t _tail = 0;
+        if(i < size) std::memcpy(&_tail, data + i, size - i);
+        return mix(_hash ^ mix(_tail));
+    }
+
+    /// cache key of a code object
+    static uint64_t key(const CodeobjView& codeobj)
+    {
+        const auto& _id = codeobj.file_id();
+        if(_id.inode != 0) return hash(reinterpret_cast<const char*>(&_id), sizeof(_id));
+        return hash(codeobj.data(), codeobj.size());
+    }
+
+    /// versions of the comgr library which disassembles the instructions and of rocprofiler-sdk
+    static uint64_t get_toolchain_version()
+    {
+        size_t _major = 0;
+        size_t _minor = 0;
+        amd_comgr_get_version(&_major, &_minor);
+        return ((static_cast<uint64_t>(_major) & 0xffff) << 48) |
+               ((static_cast<uint64_t>(_minor) & 0xffff) << 32) |
+               static_cast<uint64_t>(ROCPROFILER_VERSION);
+    }
+
+    /// creates the directory and its missing parents
+    static bool create_directories(const std::string& directory)
+    {
+        for(size_t _pos = directory.find('/', 1);; _pos = directory.find('/', _pos + 1))
+        {
+            auto _dir = directory.substr(0, _pos);
+            if(!_dir.empty() && ::mkdir(_dir.c_str(), 0755) != 0 && errno != EEXIST)
+            {
+                CODEOBJ_CACHE_WARNING("could not create the directory " << _dir << ": "
+                                                                        << std::strerror(errno));
+                return false;
+            }
+            if(_pos == std::string::npos) return true;
+        }
+    }
+
+    CodeobjCache(const std::string& directory, const CodeobjView& codeobj)
+    : m_codeobj_key(key(codeobj))
+    , m_codeobj_size(codeobj.size())
+    , m_toolchain_version(get_toolchain_version())
+    {
+        char _name[64] = {};
+        std::snprintf(_name,
+                      sizeof(_name),
+                      "%016llx-%llx.rpcodeobj",
+                      static_cast<unsigned long long>(m_codeobj_key),
+                      static_cast<unsigned long long>(m_codeobj_size));
+        m_directory = directory;
+        m_path      = directory + "/" + _name;
+
+        if(::access(m_path.c_str(), R_OK) != 0) return;
+
+        try
+        {
+            m_file = CodeobjView::map_file(m_path);
+        } catch(std::runtime_error& e)
+        {
+            CODEOBJ_CACHE_WARNING("could not map " << m_path << ": " << e.what());
+            return;
+        }
+
+        if(!validate()) m_file.reset();
+    }
+
+    bool is_loaded() const { return m_file != nullptr; }
+
+    std::map<uint64_t, SymbolInfo> get_symbols() const
+    {
+        auto _symbols = std::map<uint64_t, SymbolInfo>{};
+        if(!m_file) return _symbols;
+
+        for(uint64_t i = 0; i < get_header().num_symbols; ++i)
+        {
+            const auto& _record = record<symbol_record_t>(get_header().symbols_offset, i);
+            _symbols.emplace(_record.vaddr,
+                             SymbolInfo{get_string(_record.name),
+                                        _record.faddr,
+                                        _record.vaddr,
+                                        _record.mem_size});
+        }
+        return _symbols;
+    }
+
+    void get_lines(line_map_t& lines) const
+    {
+        if(!m_file) return;
+
+        lines.reserve(get_header().num_lines);
+        for(uint64_t i = 0; i < get_header().num_lines; ++i)
+        {
+            const auto& _record = record<line_record_t>(get_header().lines_offset, i);
+            lines.emplace({_record.addr, _record.size, 0}, get_string(_record.line));
+        }
+    }
+
+    /// disassembled instruction and its size at the file offset, if it is in the cache
+    std::optional<std::pair<std::string, size_t>> find_instruction(uint64_t faddr) const
+    {
+        if(!m_file) return std::nullopt;
+
+        const auto& _header = get_header();
+        if(_header.num_instructions == 0) return std::nullopt;
+
+        const auto* _begin = &record<instruction_record_t>(_header.instructions_offset, 0);
+        const auto* _end   = _begin + _header.num_instructions;
+        const auto* _it    = std::lower_bound(
+            _begin, _end, faddr, [](const auto& lhs, uint64_t rhs) { return lhs.faddr < rhs; });
+
+        if(_it == _end || _it->faddr != faddr) return std::nullopt;
+        return std::make_pair(get_string(_it->inst), static_cast<size_t>(_it->size));
+    }
+
+    /// writes the cache file with the instructions of the current cache file and the given
+    /// instructions. The file is written to a temporary file and renamed so that concurrent
+    /// processes never read a partially written file.
+    void save(const std::map<uint64_t, SymbolInfo>& symbols,
+              const line_map_t&                     lines,
+              instruction_map_t                     instructions) const
+    {
+        if(m_file)
+        {
+            const auto& _header = get_header();
+            for(uint64_t i = 0; i < _header.num_instructions; ++i)
+            {
+                const auto& _record =
+                    record<instruction_record_t>(_header.instructions_offset, i);
+                instructions.emplace(_record.faddr,
+                                     std::make_pair(get_string(_record.inst), _record.size));
+            }
+        }
+
+        auto _header              = header_t{};
+        _header.codeobj_key       = m_codeobj_key;
+        _header.codeobj_size      = m_codeobj_size;
+        _header.toolchain_version = m_toolchain_version;
+        _header.num_symbols       = symbols.size();
+        _header.num_lines         = lines.size();
+        _header.num_instructions  = instructions.size();
+        _header.symbols_offset    = sizeof(header_t);
+        _header.lines_offset = _header.symbols_offset + symbols.size() * sizeof(symbol_record_t);
+        _header.instructions_offset =
+            _header.lines_offset + lines.size() * sizeof(line_record_t);
+
+        auto _records = std::string{};
+        auto _strings = std::string{};
+        auto _strings_offset =
+            _header.instructions_offset + instructions.size() * sizeof(instruction_record_t);
+        auto _add_string = [&_strings, _strings_offset](const std::string& _str) {
+            auto _ref = string_ref_t{_strings_offset + _strings.size(), _str.size()};
+            _strings.append(_str);
+            return _ref;
+        };
+        auto _add_record = [&_records](const auto& _record) {
+            _records.append(reinterpret_cast<const char*>(&_record), sizeof(_record));
+        };
+
+        for(const auto& [vaddr, symbol] : symbols)
+            _add_record(
+                symbol_record_t{vaddr, symbol.faddr, symbol.mem_size, _add_string(symbol.name)});
+        lines.for_each([&](const segment::address_range_t& range, const std::string& line) {
+            _add_record(line_record_t{range.addr, range.size, _add_string(line)});
+        });
+        for(const auto& [faddr, inst] : instructions)
+            _add_record(instruction_record_t{faddr, inst.second, _add_string(inst.first)});
+
+        _header.file_size = _strings_offset + _strings.size();
+
+        if(!create_directories(m_directory)) return;
+
+        auto _tmp_path = m_path + ".tmp." + std::to_string(::getpid());
+        {
+            std::ofstream _ofs{_tmp_path, std::ios::binary | std::ios::trunc};
+            if(!_ofs)
+            {
+                CODEOBJ_CACHE_WARNING("could not open " << _tmp_path << ": "
+                                                        << std::strerror(errno));
+                return;
+            }
+            _ofs.write(reinterpret_cast<const char*>(&_header), sizeof(_header));
+            _ofs.write(_records.data(), _records.size());
+            _ofs.write(_strings.data(), _strings.size());
+            if(!_ofs)
+            {
+                CODEOBJ_CACHE_WARNING("could not write " << _tmp_path);
+                _ofs.close();
+                ::unlink(_tmp_path.c_str());
+                return;
+            }
+        }
+
+        if(std::rename(_tmp_path.c_str(), m_path.c_str()) != 0)
+        {
+            CODEOBJ_CACHE_WARNING("could not rename " << _tmp_path << " to " << m_path << ": "
+                                                      << std::strerror(errno));
+            ::unlink(_tmp_path.c_str());
+        }
+    }
+
+private:
+    const header_t& get_header() const
+    {
+        return *reinterpret_cast<const header_t*>(m_file->data());
+    }
+
+    template <typename Tp>
+    const Tp& record(uint64_t offset, uint64_t idx) const
+    {
+        return *reinterpret_cast<const Tp*>(m_file->data() + offset + idx * sizeof(Tp));
+    }
+
+    // strings are bounds checked when they are read so that opening a cache file does not touch
+    // every record
+    std::string get_string(const string_ref_t& ref) const
+    {
+        if(ref.offset > m_file->size() || ref.length > m_file->size() - ref.offset) return {};
+        return std::string{m_file->data() + ref.offset, ref.length};
+    }
+
+    bool validate() const
+    {
+        if(m_file->size() < sizeof(header_t)) return false;
+
+        const auto& _header  = get_header();
+        auto        _default = header_t{};
+        if(std::memcmp(_header.magic, _default.magic, sizeof(_header.magic)) != 0 ||
+           _header.version != version || _header.codeobj_key != m_codeobj_key ||
+           _header.codeobj_size != m_codeobj_size ||
+           _header.toolchain_version != m_toolchain_version || _header.file_size != m_file->size())
+            return false;
+
+        auto _in_file = [this](uint64_t _offset, uint64_t _count, uint64_t _size) {
+            return _offset <= m_file->size() && _count <= (m_file->size() - _offset) / _size;
+        };
+
+        return _in_file(_header.symbols_offset, _header.num_symbols, sizeof(symbol_record_t)) &&
+               _in_file(_header.lines_offset, _header.num_lines, sizeof(line_record_t)) &&
+               _in_file(_header.instructions_offset,
+                        _header.num_instructions,
+                        sizeof(instruction_record_t));
+    }
+
+    uint64_t                           m_codeobj_key       = 0;
+    uint64_t                           m_codeobj_size      = 0;
+    uint64_t                           m_toolchain_version = 0;
+    std::string                        m_directory         = {};
+    std::string                        m_path              = {};
+    std::shared_ptr<const CodeobjView> m_file              = {};
+};
+
+}  // namespace disassembly
+}  // namespace codeobj
+}  // namespace sdk
+}  // namespace rocprofiler
@@ -38,6 +38,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -76,6 +77,112 @@ namespace codeobj
 {
 namespace disassembly
 {
+/**
+ * @brief Read-only bytes of a code object. Code objects in files are memory mapped instead of being
+ * read into a buffer, code objects in memory are copied once. The bytes are private to the
+ * process (copy-on-write for mapped files) so that libraries which take a non-const pointer,
+ * i.e. libelf, never modify the file or the caller's memory.
+ */
+class CodeobjView
+{
+public:
+    /// identifies the file region of a mapped code object, all zero for copied bytes
+    struct file_id_t
+    {
+        uint64_t device    = 0;
+        uint64_t inode     = 0;
+        uint64_t file_size = 0;
+        uint64_t mtime_ns  = 0;
+        uint64_t offset    = 0;
+        uint64_t size      = 0;
+    };
+
+    CodeobjView() = default;
+    ~CodeobjView()
+    {
+        if(m_mapping) ::munmap(m_mapping, m_mapping_size);
+    }
+
+    CodeobjView(const CodeobjView&) = delete;
+    CodeobjView& operator=(const CodeobjView&) = delete;
+
+    /// maps `size` bytes of the file starting at `offset`, or the rest of the file if `size` is 0
+    static std::shared_ptr<const CodeobjView> map_file(const std::string& path,
+                                                       size_t             offset = 0,
+                                                       size_t             size   = 0)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd == -1) throw std::runtime_error("could not open " + path);
+
+        struct stat file_stat = {};
+        if(::fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < offset)
+        {
+            ::close(fd);
+            throw std::runtime_error("invalid uri " + path);
+        }
+
+        // mapping past the end of the file would fault on access
+        auto file_size = static_cast<size_t>(file_stat.st_size);
+        if(size == 0 || size > file_size - offset) size = file_size - offset;
+
+        auto view       = std::make_shared<CodeobjView>();
+        view->m_file_id = {static_cast<uint64_t>(file_stat.st_dev),
+                           static_cast<uint64_t>(file_stat.st_ino),
+                           static_cast<uint64_t>(file_stat.st_size),
+                           (static_cast<uint64_t>(file_stat.st_mtim.tv_sec) * 1000000000ULL) +
+                               static_cast<uint64_t>(file_stat.st_mtim.tv_nsec),
+                           offset,
+                           size};
+        if(size > 0)
+        {
+            // the offset of the mapping must be a multiple of the page size
+            auto  page_offset = offset % static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+            auto  length      = size + page_offset;
+            auto  map_offset  = static_cast<off_t>(offset - page_offset);
+            void* mapping =
+                ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, map_offset);
+            if(mapping == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("could not map " + path);
+            }
+
+            view->m_mapping      = mapping;
+            view->m_mapping_size = length;
+            view->m_data         = static_cast<char*>(mapping) + page_offset;
+            view->m_size         = size;
+        }
+
+        ::close(fd);
+        return view;
+    }
+
+    static std::shared_ptr<const CodeobjView> copy(const void* data, size_t size)
+    {
+        auto view = std::make_shared<CodeobjView>();
+        view->m_copy.assign(static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        view->m_data = view->m_copy.data();
+        view->m_size = view->m_copy.size();
+        return view;
+    }
+
+    const char* data() const { return m_data; }
+    size_t      size() const { return m_size; }
+
+    /// private copy-on-write bytes for APIs taking a non-const pointer (e.g. elf_memory)
+    char* mutable_data() const { return m_data; }
+
+    const file_id_t& file_id() const { return m_file_id; }
+
+private:
+    void*             m_mapping      = nullptr;
+    size_t            m_mapping_size = 0;
+    char*             m_data         = nullptr;
+    size_t            m_size         = 0;
+    std::vector<char> m_copy         = {};
+    file_id_t         m_file_id      = {};
+};
+
 class CodeObjectBinary
 {
 public:
@@ -142,7 +249,7 @@ public:
             }
         });
 
-        buffer        = std::vector<char>{};
+        view          = std::make_shared<const CodeobjView>();
         size_t offset = 0;
         size_t size   = 0;
 
@@ -156,29 +263,26 @@ public:
             if((size = std::stoul(size_it->second, nullptr, 0)) == 0) return;
         }
 
-        if(protocol == "memory") throw std::runtime_error(protocol + " protocol not supported!");
-
-        std::ifstream file(decoded_path, std::ios::in | std::ios::binary);
-        if(!file || !file.is_open()) throw std::runtime_error("could not open " + decoded_path);
-
-        if(size == 0)
+        if(protocol == "memory")
         {
-            file.ignore(std::numeric_limits<std::streamsize>::max());
-            size_t bytes = file.gcount();
-            file.clear();
-
-            if(bytes < offset) throw std::runtime_error("invalid uri " + decoded_path);
+            // memory://<pid>#offset=<address>&size=<size> can only be read in the same process
+            if(size == 0 || std::stol(decoded_path) != ::getpid())
+                throw std::runtime_error("unsupported uri " + m_uri);
 
-            size = bytes - offset;
+            // NOLINTNEXTLINE(performance-no-int-to-ptr)
+            view = CodeobjView::copy(reinterpret_cast<const void*>(offset), size);
         }
-
-        file.seekg(offset, std::ios_base::beg);
-        buffer.resize(size);
-        file.read(buffer.data(), size);
+        else
+        {
+            view = CodeobjView::map_file(decoded_path, offset, size);
+        }
+        buffer = std::string_view{view->data(), view->size()};
     }
 
-    std::string       m_uri;
-    std::vector<char> buffer;
+    std::string                        m_uri;
+    std::shared_ptr<const CodeobjView> view;
+    /// bytes of the code object (read-only, owned by view)
+    std::string_view                   buffer = {};
 };
 
 struct SymbolInfo
@@ -193,12 +297,15 @@ class DisassemblyInstance
 {
 public:
     DisassemblyInstance(const char* codeobj_data, uint64_t codeobj_size)
-    {
-        buffer = std::vector<char>(codeobj_size, 0);
-        std::memcpy(buffer.data(), codeobj_data, codeobj_size);
+    : DisassemblyInstance(CodeobjView::copy(codeobj_data, codeobj_size))
+    {}
 
+    DisassemblyInstance(std::shared_ptr<const CodeobjView> _view)
+    : view(std::move(_view))
+    , buffer(view->data(), view->size())
+    {
         THROW_COMGR(amd_comgr_create_data(AMD_COMGR_DATA_KIND_EXECUTABLE, &data));
-        THROW_COMGR(amd_comgr_set_data(data, buffer.size(), buffer.data()));
+        THROW_COMGR(amd_comgr_set_data(data, view->size(), view->data()));
 
         size_t      isa_size = 128;
         std::string input_isa{};
@@ -221,7 +328,7 @@ public:
     std::pair<std::string, size_t> ReadInstruction(uint64_t faddr)
     {
         uint64_t size_read;
-        uint64_t addr_in_buffer = reinterpret_cast<uint64_t>(buffer.data()) + faddr;
+        uint64_t addr_in_buffer = reinterpret_cast<uint64_t>(view->data()) + faddr;
 
         THROW_COMGR(
             amd_comgr_disassemble_instruction(info, addr_in_buffer, (void*) this, &size_read));
@@ -266,8 +373,8 @@ public:
     static uint64_t memory_callback(uint64_t from, char* to, uint64_t size, void* user_data)
     {
         DisassemblyInstance& instance = *static_cast<DisassemblyInstance*>(user_data);
-        int64_t              copysize = reinterpret_cast<int64_t>(instance.buffer.data()) +
-                           instance.buffer.size() - static_cast<int64_t>(from);
+        int64_t              copysize = reinterpret_cast<int64_t>(instance.view->data()) +
+                           instance.view->size() - static_cast<int64_t>(from);
         copysize = std::min<int64_t>(size, copysize);
         // NOLINTNEXTLINE(performance-no-int-to-ptr)
         std::memcpy(to, (char*) from, copysize);
@@ -287,9 +394,9 @@ public:
 
     std::optional<uint64_t> va2fo(uint64_t va)
     {
-        CHECK_VA2FO(buffer.size() > sizeof(Elf64_Ehdr), "buffer is not large enough");
+        CHECK_VA2FO(view->size() > sizeof(Elf64_Ehdr), "buffer is not large enough");
 
-        uint8_t* e_ident = (uint8_t*) buffer.data();
+        const uint8_t* e_ident = (const uint8_t*) view->data();
         CHECK_VA2FO(e_ident, "e_ident is nullptr");
 
         CHECK_VA2FO(e_ident[EI_MAG0] == ELFMAG0 || e_ident[EI_MAG1] == ELFMAG1 ||
@@ -306,16 +413,16 @@ public:
                         e_ident[EI_ABIVERSION] == 4,    // ELFABIVERSION_AMDGPU_HSA_V6
                     "unexpected ei_abiversion");
 
-        Elf64_Ehdr* ehdr = (Elf64_Ehdr*) buffer.data();
+        const Elf64_Ehdr* ehdr = (const Elf64_Ehdr*) view->data();
         CHECK_VA2FO(ehdr, "ehdr is nullptr");
         CHECK_VA2FO(ehdr->e_type == ET_DYN, "unexpected e_type");
         CHECK_VA2FO(ehdr->e_machine == ELF::EM_AMDGPU, "unexpected e_machine");
         CHECK_VA2FO(ehdr->e_phoff != 0, "unexpected e_phoff");
 
-        CHECK_VA2FO(buffer.size() > ehdr->e_phoff + sizeof(Elf64_Phdr),
+        CHECK_VA2FO(view->size() > ehdr->e_phoff + sizeof(Elf64_Phdr),
                     "buffer is not large enough");
 
-        Elf64_Phdr* phdr = (Elf64_Phdr*) ((uint8_t*) buffer.data() + ehdr->e_phoff);
+        const auto* phdr = (const Elf64_Phdr*) ((const uint8_t*) view->data() + ehdr->e_phoff);
         CHECK_VA2FO(phdr, "phdr is nullptr");
 
         for(uint16_t i = 0; i < ehdr->e_phnum; ++i)
@@ -328,11 +435,13 @@ public:
         return std::nullopt;
     }
 
-    std::vector<char>              buffer;
-    std::string                    last_instruction;
-    amd_comgr_disassembly_info_t   info;
-    amd_comgr_data_t               data;
-    std::map<uint64_t, SymbolInfo> symbol_map;
+    std::shared_ptr<const CodeobjView> view;
+    /// bytes of the code object (read-only, owned by view)
+    std::string_view                   buffer;
+    std::string                        last_instruction;
+    amd_comgr_disassembly_info_t       info;
+    amd_comgr_data_t                   data;
+    std::map<uint64_t, SymbolInfo>     symbol_map;
 };
 
 }  // namespace disassembly
@@ -22,11 +22,17 @@
 
 #pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <optional>
 #include <random>
 #include <set>
 #include <string>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace rocprofiler
@@ -59,34 +65,237 @@ struct address_range_t
 };
 
 /**
- * @brief Finds a candidate codeobj for the given vaddr
+ * @brief Index of the last element in the sorted array which is less than or equal to `val`, or
+ * `size` if every element is greater than `val`. The search loop does not branch on the
+ * comparison so that it compiles to conditional moves.
  */
-class CodeobjTableTranslator : public std::set<address_range_t>
+inline size_t
+find_last_less_equal(const uint64_t* data, size_t size, uint64_t val)
 {
-    using Super = std::set<address_range_t>;
+    if(size == 0 || val < data[0]) return size;
 
+    const uint64_t* base = data;
+    while(size > 1)
+    {
+        const size_t half = size / 2;
+        base              = (base[half] <= val) ? base + half : base;
+        size -= half;
+    }
+    return static_cast<size_t>(base - data);
+}
+
+/**
+ * @brief Non-overlapping address ranges stored in flat arrays sorted by address, with a per-thread
+ * cache of the most recently found ranges. Follows the std::set<address_range_t> interface, where
+ * two ranges are equivalent if they overlap.
+ */
+class CodeobjTableTranslator
+{
 public:
-    address_range_t find_codeobj_in_range(uint64_t addr)
+    using value_type     = address_range_t;
+    using container_type = std::vector<address_range_t>;
+    using iterator       = container_type::const_iterator;
+    using const_iterator = container_type::const_iterator;
+
+    iterator begin() const { return m_ranges.begin(); }
+    iterator end() const { return m_ranges.end(); }
+    size_t   size() const { return m_ranges.size(); }
+    bool     empty() const { return m_ranges.empty(); }
+
+    /// inserts the range unless it overlaps a range in the table
+    std::pair<iterator, bool> insert(const address_range_t& range)
+    {
+        auto it = find(range);
+        if(it != end()) return {it, false};
+
+        auto idx = upper_bound_index(range.addr);
+        m_addrs.insert(m_addrs.begin() + idx, range.addr);
+        m_ranges.insert(m_ranges.begin() + idx, range);
+        update_generation();
+        return {m_ranges.begin() + idx, true};
+    }
+
+    /// removes the range which overlaps the given range (if any)
+    size_t erase(const address_range_t& range)
     {
-        if(!cached_segment.inrange(addr))
+        auto it = find(range);
+        if(it == end()) return 0;
+
+        auto idx = static_cast<size_t>(it - begin());
+        m_addrs.erase(m_addrs.begin() + idx);
+        m_ranges.erase(m_ranges.begin() + idx);
+        update_generation();
+        return 1;
+    }
+
+    void clear()
+    {
+        m_addrs.clear();
+        m_ranges.clear();
+        update_generation();
+    }
+
+    /// the range which overlaps the given range or end()
+    iterator find(const address_range_t& range) const
+    {
+        auto idx = find_last_less_equal(m_addrs.data(), m_addrs.size(), range.addr);
+        if(idx < size() && m_ranges[idx] == range) return begin() + idx;
+
+        // the range may start before the next range in the table and overlap it
+        auto next = (idx < size()) ? idx + 1 : 0;
+        if(next < size() && m_ranges[next] == range) return begin() + next;
+
+        return end();
+    }
+
+    /// the range containing the address or nullptr. The calling thread caches the last few ranges
+    /// it found, the cached entries are invalidated when the table is modified.
+    std::optional<address_range_t> lookup(uint64_t addr) const
+    {
+        auto& _cache = get_lookup_cache();
+
+        // scan every entry instead of returning at the first match so the scan does not branch.
+        // The unsigned subtraction wraps around for addresses below the start of the range.
+        auto _hit = _cache.entries.size();
+        for(size_t i = 0; i < _cache.entries.size(); ++i)
         {
-            auto it = this->find(address_range_t{addr, 0, 0});
-            if(it == this->end()) throw std::exception();
-            cached_segment = *it;
+            const auto& _entry = _cache.entries[i];
+            auto        _match = static_cast<size_t>(_entry.generation == m_generation) &
+                          static_cast<size_t>((addr - _entry.range.addr) < _entry.range.size);
+            _hit += (i - _hit) & (size_t{0} - _match);
         }
-        return cached_segment;
+
+        if(_hit < _cache.entries.size())
+        {
+            _cache.entries[_hit].last_use = ++_cache.clock;
+            return _cache.entries[_hit].range;
+        }
+
+        auto it = find(address_range_t{addr, 0, 0});
+        if(it == end()) return std::nullopt;
+
+        // replace the least recently used entry
+        auto _lru = std::min_element(
+            _cache.entries.begin(), _cache.entries.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.last_use < rhs.last_use;
+            });
+        *_lru = {m_generation, ++_cache.clock, *it};
+        return *it;
     }
 
-    void clear_cache() { cached_segment = {}; }
-    bool remove(const address_range_t& range)
+    address_range_t find_codeobj_in_range(uint64_t addr) const
     {
-        clear_cache();
-        return this->erase(range) != 0;
+        auto range = lookup(addr);
+        if(!range) throw std::exception();
+        return *range;
     }
+
+    void clear_cache() { update_generation(); }
+    bool remove(const address_range_t& range) { return erase(range) != 0; }
     bool remove(uint64_t addr) { return remove(address_range_t{addr, 0, 0}); }
 
 private:
-    address_range_t cached_segment{};
+    struct lookup_cache
+    {
+        struct entry
+        {
+            uint64_t        generation = 0;
+            uint64_t        last_use   = 0;
+            address_range_t range      = {};
+        };
+
+        uint64_t             clock   = 0;
+        std::array<entry, 4> entries = {};
+    };
+
+    static lookup_cache& get_lookup_cache()
+    {
+        static thread_local auto _v = lookup_cache{};
+        return _v;
+    }
+
+    // generations are unique across all tables so the per-thread cache entries of one table never
+    // match another table. Zero is reserved for the unused cache entries.
+    void update_generation()
+    {
+        static auto _generation = std::atomic<uint64_t>{0};
+        m_generation            = ++_generation;
+    }
+
+    size_t upper_bound_index(uint64_t addr) const
+    {
+        return static_cast<size_t>(std::upper_bound(m_addrs.begin(), m_addrs.end(), addr) -
+                                   m_addrs.begin());
+    }
+
+    uint64_t              m_generation = 0;
+    std::vector<uint64_t> m_addrs      = {};
+    container_type        m_ranges     = {};
+};
+
+/**
+ * @brief Maps non-overlapping address ranges to values. Ranges and values are stored in flat
+ * arrays sorted by address, inserting the ranges in address order only appends to the arrays.
+ * Like std::map::emplace with address_range_t keys, a range overlapping an existing range is not
+ * inserted.
+ */
+template <typename Tp>
+class flat_range_map
+{
+public:
+    size_t size() const { return m_ranges.size(); }
+    bool   empty() const { return m_ranges.empty(); }
+
+    void reserve(size_t n)
+    {
+        m_addrs.reserve(n);
+        m_ranges.reserve(n);
+        m_values.reserve(n);
+    }
+
+    void clear()
+    {
+        m_addrs.clear();
+        m_ranges.clear();
+        m_values.clear();
+    }
+
+    /// returns false if the range overlaps a range already in the map
+    bool emplace(const address_range_t& range, Tp value)
+    {
+        auto idx = static_cast<size_t>(
+            std::upper_bound(m_addrs.begin(), m_addrs.end(), range.addr) - m_addrs.begin());
+
+        // only the neighbors can overlap since the ranges in the map do not overlap
+        if(idx > 0 && m_ranges[idx - 1] == range) return false;
+        if(idx < size() && m_ranges[idx] == range) return false;
+
+        m_addrs.insert(m_addrs.begin() + idx, range.addr);
+        m_ranges.insert(m_ranges.begin() + idx, range);
+        m_values.insert(m_values.begin() + idx, std::move(value));
+        return true;
+    }
+
+    /// invokes the function with each range and value in address order
+    template <typename FuncT>
+    void for_each(FuncT&& func) const
+    {
+        for(size_t i = 0; i < size(); ++i)
+            func(m_ranges[i], m_values[i]);
+    }
+
+    /// the value of the range containing the address or nullptr
+    const Tp* find(uint64_t addr) const
+    {
+        auto idx = find_last_less_equal(m_addrs.data(), m_addrs.size(), addr);
+        if(idx < size() && m_ranges[idx].inrange(addr)) return &m_values[idx];
+        return nullptr;
+    }
+
+private:
+    std::vector<uint64_t>        m_addrs  = {};
+    std::vector<address_range_t> m_ranges = {};
+    std::vector<Tp>              m_values = {};
 };
 
 }  // namespace segment
@@ -89,6 +89,12 @@ typedef void (*rocprofiler_dispatch_counting_service_callback_t)(
  *        @ref rocprofiler_dispatch_counting_service_callback_t. Only used with
  *        @ref rocprofiler_configure_callback_dispatch_counting_service.
  *
+ *        The callback is invoked on one of the internal threads which process the completed
+ *        dispatches, not necessarily the same thread for every dispatch. Invocations are never
+ *        concurrent: they are serialized in the order the dispatches completed, so the callback
+ *        does not need to synchronize with itself but must not rely on thread-local state.
+ *        Blocking in the callback delays the records of the dispatches which completed later.
+ *
  * @param [in] dispatch_data      @see ::rocprofiler_dispatch_counting_service_data_t
  * @param [in] record_data        Counter record data.
  * @param [in] record_count       Number of counter records.
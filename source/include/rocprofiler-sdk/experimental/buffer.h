@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <rocprofiler-sdk/defines.h>
+#include <rocprofiler-sdk/fwd.h>
+
+ROCPROFILER_EXTERN_C_INIT
+
+/**
+ * @brief Statistics about how records were emplaced into a buffer.
+ */
+typedef struct rocprofiler_buffer_stats_t
+{
+    uint64_t size;         ///< size of this struct
+    uint64_t num_buffers;  ///< number of internal buffers currently allocated
+    uint64_t drop_count;   ///< number of records dropped because the buffer was full
+    uint64_t stall_count;  ///< number of times a producer blocked waiting for a free buffer
+    uint64_t stall_ns;     ///< total time (in nanoseconds) producers were blocked
+} rocprofiler_buffer_stats_t;
+
+/**
+ * @brief Configure how records are stored in a buffer until it is flushed. This function must be
+ *   called after @ref rocprofiler_create_buffer and before the tool finishes initialization.
+ *
+ * In ::ROCPROFILER_BUFFER_MODE_PER_THREAD mode, every thread which produces records writes into
+ * its own single-producer/single-consumer lane so no locks or shared atomics are used when a
+ * record is emplaced. The `size` and `watermark` provided to @ref rocprofiler_create_buffer apply
+ * to each lane. When the buffer is flushed, the records from every lane are merged and delivered
+ * in a single invocation of the buffer callback: records produced by the same thread are in
+ * order but records from different threads are not ordered with respect to each other.
+ *
+ * @param [in] buffer_id Identification handle for buffer
+ * @param [in] mode Storage mode for the buffer
+ * @return ::rocprofiler_status_t
+ * @retval ROCPROFILER_STATUS_SUCCESS if the mode was applied
+ * @retval ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED if invoked after initialization
+ * @retval ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND if the buffer does not exist
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if the mode is not valid
+ */
+rocprofiler_status_t
+rocprofiler_set_buffer_mode(rocprofiler_buffer_id_t   buffer_id,
+                            rocprofiler_buffer_mode_t mode) ROCPROFILER_API;
+
+/**
+ * @brief Configure the pool of internal buffers used by a buffer in
+ *   ::ROCPROFILER_BUFFER_MODE_SHARED mode. This function must be called after @ref
+ *   rocprofiler_create_buffer and before the tool finishes initialization.
+ *
+ * By default, a ::ROCPROFILER_BUFFER_POLICY_LOSSLESS buffer uses two internal buffers: when the
+ * current internal buffer is full, it is handed off to the callback thread and producers continue
+ * in the other one. With a pool of N internal buffers, producers only block when every other
+ * internal buffer is still waiting on the callback. When that happens and the total memory of the
+ * pool is below `max_bytes`, a new internal buffer is allocated instead of blocking.
+ *
+ * @param [in] buffer_id Identification handle for buffer
+ * @param [in] num_buffers Number of internal buffers (each of the size provided to @ref
+ *   rocprofiler_create_buffer) to allocate up front. Must be between 1 and 16.
+ * @param [in] max_bytes Maximum number of bytes the pool may grow to. Values less than
+ *   `num_buffers` times the size of the buffer disable growth.
+ * @return ::rocprofiler_status_t
+ * @retval ROCPROFILER_STATUS_SUCCESS if the pool was configured
+ * @retval ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED if invoked after initialization
+ * @retval ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND if the buffer does not exist
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if `num_buffers` is out of range
+ */
+rocprofiler_status_t
+rocprofiler_set_buffer_pool(rocprofiler_buffer_id_t buffer_id,
+                            size_t                  num_buffers,
+                            size_t                  max_bytes) ROCPROFILER_API;
+
+/**
+ * @brief Query the statistics of a buffer, e.g. how long producers were blocked waiting for the
+ *   buffer callback to complete.
+ *
+ * @param [in] buffer_id Identification handle for buffer
+ * @param [out] stats Statistics of the buffer
+ * @return ::rocprofiler_status_t
+ * @retval ROCPROFILER_STATUS_SUCCESS if the statistics were written
+ * @retval ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND if the buffer does not exist
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if `stats` is a null pointer
+ */
+rocprofiler_status_t
+rocprofiler_query_buffer_stats(rocprofiler_buffer_id_t     buffer_id,
+                               rocprofiler_buffer_stats_t* stats) ROCPROFILER_API;
+
+/** @} */
+
+ROCPROFILER_EXTERN_C_FINI
@@ -0,0 +1,123 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <rocprofiler-sdk/defines.h>
+#include <rocprofiler-sdk/fwd.h>
+
+ROCPROFILER_EXTERN_C_INIT
+
+/**
+ * @brief Sampling configuration for the calls to the API operations of a tracing kind.
+ */
+typedef struct rocprofiler_tracing_sampling_config_t
+{
+    uint64_t                              size;      ///< size of this struct
+    rocprofiler_tracing_sampling_policy_t policy;    ///< how the calls are sampled
+    uint64_t                              interval;  ///< N: trace one out of every N calls
+    uint64_t                              count;     ///< K: number of calls (see policy)
+    uint64_t                              period;    ///< time period in nanoseconds
+
+    /// @var interval
+    /// @brief Used by ::ROCPROFILER_TRACING_SAMPLING_EVERY_NTH and
+    /// ::ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH. Must be greater than zero.
+    /// @var count
+    /// @brief For ::ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH, the number of calls traced
+    /// before sampling starts. For ::ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET, the maximum number
+    /// of calls traced within each time period, which must be greater than zero.
+    /// @var period
+    /// @brief Used by ::ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET. Must be greater than zero.
+} rocprofiler_tracing_sampling_config_t;
+
+/**
+ * @brief Sample the calls to the API operations of a callback tracing kind. This function must be
+ *   called after @ref rocprofiler_configure_callback_tracing_service for the same context and kind
+ *   and before the tool finishes initialization.
+ *
+ * When a call is not sampled, no correlation id is created and the callbacks are not invoked for
+ * that context. Every operation keeps its own sampling state, i.e. a policy of one out of every
+ * 100 calls traces the 1st, 101st, 201st, etc. call of `hipMemcpy` independently of the calls to
+ * `hipLaunchKernel`. Only the HIP and HSA API tracing kinds are supported.
+ *
+ * @param [in] context_id Context to configure
+ * @param [in] kind Callback tracing kind
+ * @param [in] operations Array of operations in the kind to sample. If null, every operation in
+ *   the kind is sampled.
+ * @param [in] operations_count Number of operations in the `operations` array
+ * @param [in] config Sampling configuration
+ * @return ::rocprofiler_status_t
+ * @retval ROCPROFILER_STATUS_SUCCESS if the sampling was configured
+ * @retval ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED if invoked after initialization
+ * @retval ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_FOUND if the context does not exist
+ * @retval ROCPROFILER_STATUS_ERROR_CONTEXT_INVALID if the callback tracing service for `kind` has
+ *   not been configured in the context
+ * @retval ROCPROFILER_STATUS_ERROR_KIND_NOT_FOUND if `kind` does not support sampling
+ * @retval ROCPROFILER_STATUS_ERROR_OPERATION_NOT_FOUND if an operation is not valid
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if `config` is null or not valid
+ */
+rocprofiler_status_t
+rocprofiler_configure_callback_tracing_sampling(
+    rocprofiler_context_id_t                     context_id,
+    rocprofiler_callback_tracing_kind_t          kind,
+    const rocprofiler_tracing_operation_t*       operations,
+    size_t                                       operations_count,
+    const rocprofiler_tracing_sampling_config_t* config) ROCPROFILER_API;
+
+/**
+ * @brief Sample the calls to the API operations of a buffer tracing kind. This function must be
+ *   called after @ref rocprofiler_configure_buffer_tracing_service for the same context and kind
+ *   and before the tool finishes initialization.
+ *
+ * When a call is not sampled, no correlation id is created and no record is placed in the buffer
+ * for that context. Each record which is placed in the buffer stores the number of calls it
+ * represents in its `sampling_weight` field, e.g. a record following 99 skipped calls has a weight
+ * of 100, so that the total number of calls and the total time spent in an operation can be
+ * extrapolated from the records. Only the HIP and HSA API tracing kinds are supported.
+ *
+ * @param [in] context_id Context to configure
+ * @param [in] kind Buffer tracing kind
+ * @param [in] operations Array of operations in the kind to sample. If null, every operation in
+ *   the kind is sampled.
+ * @param [in] operations_count Number of operations in the `operations` array
+ * @param [in] config Sampling configuration
+ * @return ::rocprofiler_status_t
+ * @retval ROCPROFILER_STATUS_SUCCESS if the sampling was configured
+ * @retval ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED if invoked after initialization
+ * @retval ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_FOUND if the context does not exist
+ * @retval ROCPROFILER_STATUS_ERROR_CONTEXT_INVALID if the buffer tracing service for `kind` has
+ *   not been configured in the context
+ * @retval ROCPROFILER_STATUS_ERROR_KIND_NOT_FOUND if `kind` does not support sampling
+ * @retval ROCPROFILER_STATUS_ERROR_OPERATION_NOT_FOUND if an operation is not valid
+ * @retval ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT if `config` is null or not valid
+ */
+rocprofiler_status_t
+rocprofiler_configure_buffer_tracing_sampling(
+    rocprofiler_context_id_t                     context_id,
+    rocprofiler_buffer_tracing_kind_t            kind,
+    const rocprofiler_tracing_operation_t*       operations,
+    size_t                                       operations_count,
+    const rocprofiler_tracing_sampling_config_t* config) ROCPROFILER_API;
+
+/** @} */
+
+ROCPROFILER_EXTERN_C_FINI
@@ -330,6 +330,28 @@ typedef enum  // NOLINT(performance-enum-size)
     ROCPROFILER_BUFFER_POLICY_LAST,
 } rocprofiler_buffer_policy_t;
 
+/**
+ * @brief How the records emplaced into a buffer are stored until the buffer is flushed.
+ */
+typedef enum  // NOLINT(performance-enum-size)
+{
+    ROCPROFILER_BUFFER_MODE_SHARED = 0,  ///< All threads write into a single shared buffer
+    ROCPROFILER_BUFFER_MODE_PER_THREAD,  ///< Each thread writes into its own lock-free lane
+    ROCPROFILER_BUFFER_MODE_LAST,
+} rocprofiler_buffer_mode_t;
+
+/**
+ * @brief How the calls to an API operation are sampled when tracing.
+ */
+typedef enum  // NOLINT(performance-enum-size)
+{
+    ROCPROFILER_TRACING_SAMPLING_NONE = 0,          ///< Trace every call
+    ROCPROFILER_TRACING_SAMPLING_EVERY_NTH,         ///< Trace one out of every N calls
+    ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH,  ///< Trace the first K calls, then every Nth
+    ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET,      ///< Trace at most K calls per time period
+    ROCPROFILER_TRACING_SAMPLING_LAST,
+} rocprofiler_tracing_sampling_policy_t;
+
 /**
  * @brief Page migration event.
  */
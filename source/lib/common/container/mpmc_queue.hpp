@@ -0,0 +1,175 @@
+// MIT License
+//
+// Copyright (c) 2022-2025 Advanced Micro Devices, Inc. All Rights Reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+/**
+ * @brief Bounded multi-producer/multi-consumer queue (D. Vyukov). Each cell has a sequence
+ *        number which tells producers and consumers whether the cell is free or holds
+ *        data for their position, so push and pop only take a CAS on the position counters
+ *        and never a lock. The position of an element is unique and elements are popped in
+ *        the order of their positions, which makes the position usable as a sequence number.
+ *
+ * @tparam Tp Element type, must be default constructible and move assignable
+ */
+template <typename Tp>
+class mpmc_queue
+{
+public:
+    using value_type = Tp;
+
+    // capacity is rounded up to a power of two
+    explicit mpmc_queue(size_t _capacity);
+    ~mpmc_queue()                 = default;
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue(mpmc_queue&&)      = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(mpmc_queue&&) = delete;
+
+    // returns false if the queue is full, _v is not moved from in that case
+    bool try_push(Tp&& _v, uint64_t* _position = nullptr);
+    // returns false if the queue is empty
+    bool try_pop(Tp& _v, uint64_t* _position = nullptr);
+
+    size_t capacity() const { return m_mask + 1; }
+    // approximate when there are concurrent pushes/pops
+    size_t size() const;
+    bool   empty() const { return (size() == 0); }
+
+private:
+    struct cell
+    {
+        std::atomic<uint64_t> sequence = {};
+        Tp                    data     = {};
+    };
+
+    static constexpr size_t cache_line_size = 64;
+
+    size_t                        m_mask  = 0;
+    std::unique_ptr<cell[]>       m_cells = {};
+    alignas(cache_line_size) std::atomic<uint64_t> m_push_pos = {0};
+    alignas(cache_line_size) std::atomic<uint64_t> m_pop_pos  = {0};
+};
+
+template <typename Tp>
+mpmc_queue<Tp>::mpmc_queue(size_t _capacity)
+{
+    size_t _n = 2;
+    while(_n < _capacity)
+        _n <<= 1;
+
+    m_mask  = _n - 1;
+    m_cells = std::make_unique<cell[]>(_n);
+    for(size_t i = 0; i < _n; ++i)
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template <typename Tp>
+bool
+mpmc_queue<Tp>::try_push(Tp&& _v, uint64_t* _position)
+{
+    auto  _pos  = m_push_pos.load(std::memory_order_relaxed);
+    cell* _cell = nullptr;
+    while(true)
+    {
+        _cell     = &m_cells[_pos & m_mask];
+        auto _seq = _cell->sequence.load(std::memory_order_acquire);
+        auto _dif = static_cast<int64_t>(_seq) - static_cast<int64_t>(_pos);
+        if(_dif == 0)
+        {
+            if(m_push_pos.compare_exchange_weak(_pos, _pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(_dif < 0)
+        {
+            // the cell still holds the data from one lap ago
+            return false;
+        }
+        else
+        {
+            _pos = m_push_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    _cell->data = std::move(_v);
+    _cell->sequence.store(_pos + 1, std::memory_order_release);
+    if(_position) *_position = _pos;
+    return true;
+}
+
+template <typename Tp>
+bool
+mpmc_queue<Tp>::try_pop(Tp& _v, uint64_t* _position)
+{
+    auto  _pos  = m_pop_pos.load(std::memory_order_relaxed);
+    cell* _cell = nullptr;
+    while(true)
+    {
+        _cell     = &m_cells[_pos & m_mask];
+        auto _seq = _cell->sequence.load(std::memory_order_acquire);
+        auto _dif = static_cast<int64_t>(_seq) - static_cast<int64_t>(_pos + 1);
+        if(_dif == 0)
+        {
+            if(m_pop_pos.compare_exchange_weak(_pos, _pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(_dif < 0)
+        {
+            // the cell has not been written for this position yet
+            return false;
+        }
+        else
+        {
+            _pos = m_pop_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    _v = std::move(_cell->data);
+    _cell->data = Tp{};
+    _cell->sequence.store(_pos + m_mask + 1, std::memory_order_release);
+    if(_position) *_position = _pos;
+    return true;
+}
+
+template <typename Tp>
+size_t
+mpmc_queue<Tp>::size() const
+{
+    auto _pop  = m_pop_pos.load(std::memory_order_acquire);
+    auto _push = m_push_pos.load(std::memory_order_acquire);
+    return (_push > _pop) ? (_push - _pop) : 0;
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <atomic>
 #include <new>
+#include <thread>
 
 namespace rocprofiler::common::container
 {
@@ -61,6 +62,7 @@ record_header_buffer::operator=(record_header_buffer&& _rhs) noexcept
         auto _lk  = rhb_raii_lock{_rhs};
         m_index   = _rhs.m_index.load(std::memory_order_acquire);
         m_buffer  = std::move(_rhs.m_buffer);
+        m_chunks  = std::move(_rhs.m_chunks);
         m_headers = std::move(_rhs.m_headers);
         _rhs.reset();
     }
@@ -74,28 +76,47 @@ record_header_buffer::allocate(size_t num_bytes)
 
     auto _lk = rhb_raii_lock{*this};
     m_buffer.init(num_bytes);
-    rocprofiler_record_header_t record = {};
-    record.hash                        = 0;
-    record.payload                     = nullptr;
-    m_headers.resize(m_buffer.capacity(), record);
     return true;
 }
 
+rocprofiler_record_header_t*
+record_header_buffer::append_header(size_t idx)
+{
+    auto _chunk = idx / header_chunk_size;
+    while(_chunk >= m_chunks.size())
+        m_chunks.emplace_back(std::make_unique<rocprofiler_record_header_t[]>(header_chunk_size));
+
+    auto* _header = &m_chunks.at(_chunk)[idx % header_chunk_size];
+    if(idx >= m_headers.size()) m_headers.resize(idx + 1, nullptr);
+    m_headers.at(idx) = _header;
+    return _header;
+}
+
+void
+record_header_buffer::seal()
+{
+    // sequentially consistent with the request notification in emplace: either the emplace sees
+    // the buffer is sealed or this sees the pending request and waits for it
+    m_sealed.store(true);
+    while(m_requested.load() > 0)
+        std::this_thread::yield();
+}
+
 record_header_buffer::record_ptr_vec_t
 record_header_buffer::get_record_headers(size_t _n)
+{
+    auto _view = get_record_header_view(_n);
+    return record_ptr_vec_t{_view.begin(), _view.end()};
+}
+
+record_header_view
+record_header_buffer::get_record_header_view(size_t _n)
 {
     auto _lk = rhb_raii_lock{*this};
 
-    auto _sz  = m_index.load(std::memory_order_acquire);
-    _n        = std::min(_n, _sz);
-    auto _ret = record_ptr_vec_t{};
-    _ret.reserve(_n);
-    for(size_t i = 0; i < _n; ++i)
-    {
-        if(auto& itr = m_headers.at(i); itr.hash > 0 && itr.payload != nullptr)
-            _ret.emplace_back(&itr);
-    }
-    return _ret;
+    auto _sz = m_index.load(std::memory_order_acquire);
+    _n       = std::min({_n, _sz, m_headers.size()});
+    return record_header_view{m_headers.data(), _n};
 }
 
 size_t
@@ -105,19 +126,15 @@ record_header_buffer::clear()
 
     auto _n = m_index.load(std::memory_order_acquire);
     {
-        auto _sz = m_buffer.capacity();
-        if(!m_buffer.clear(std::nothrow_t{})) return 0;
-        std::for_each(m_headers.begin(), m_headers.end(), [](auto& itr) {
-            rocprofiler_record_header_t record = {};
-            record.hash                        = 0;
-            record.payload                     = nullptr;
-            itr                                = record;
-        });
-        rocprofiler_record_header_t record = {};
-        record.hash                        = 0;
-        record.payload                     = nullptr;
-        m_headers.resize(_sz, record);
+        if(!m_buffer.clear(std::nothrow_t{}))
+        {
+            m_sealed.store(false);
+            return 0;
+        }
+        // the header storage is retained so only the used entries are discarded
+        m_headers.clear();
         m_index.store(0, std::memory_order_release);
+        m_sealed.store(false);
     }
 
     return _n;
@@ -132,7 +149,10 @@ record_header_buffer::reset()
     m_buffer.destroy();
     m_buffer.clear();
     m_headers.clear();
+    m_headers.shrink_to_fit();
+    m_chunks.clear();
     m_index.store(0, std::memory_order_release);
+    m_sealed.store(false);
 
     return _n;
 }
@@ -142,11 +162,10 @@ record_header_buffer::save(std::fstream& _fs)
 {
     auto _lk = rhb_raii_lock{*this};
 
-    auto _idx = m_index.load(std::memory_order_acquire);
-    auto _sz  = m_headers.size();
+    auto _idx = std::min(m_index.load(std::memory_order_acquire), m_headers.size());
     _fs.write(reinterpret_cast<char*>(&_idx), sizeof(_idx));
-    _fs.write(reinterpret_cast<char*>(&_sz), sizeof(_sz));
-    _fs.write(reinterpret_cast<char*>(m_headers.data()), sizeof(rocprofiler_record_header_t) * _sz);
+    for(size_t i = 0; i < _idx; ++i)
+        _fs.write(reinterpret_cast<char*>(m_headers.at(i)), sizeof(rocprofiler_record_header_t));
     m_buffer.save(_fs);
 }
 
@@ -155,19 +174,13 @@ record_header_buffer::load(std::fstream& _fs)
 {
     auto _lk = rhb_raii_lock{*this};
 
-    {
-        auto _idx = size_t{0};
-        _fs.read(reinterpret_cast<char*>(&_idx), sizeof(_idx));
-        m_index.store(_idx, std::memory_order_release);
-    }
+    auto _idx = size_t{0};
+    _fs.read(reinterpret_cast<char*>(&_idx), sizeof(_idx));
 
-    {
-        auto _sz = size_t{0};
-        _fs.read(reinterpret_cast<char*>(&_sz), sizeof(_sz));
-        m_headers.resize(_sz);
-        _fs.read(reinterpret_cast<char*>(m_headers.data()),
-                 sizeof(rocprofiler_record_header_t) * _sz);
-    }
+    m_headers.clear();
+    for(size_t i = 0; i < _idx; ++i)
+        _fs.read(reinterpret_cast<char*>(append_header(i)), sizeof(rocprofiler_record_header_t));
+    m_index.store(_idx, std::memory_order_release);
 
     m_buffer.load(_fs);
 }
@@ -27,7 +27,9 @@
 #include "lib/common/container/ring_buffer.hpp"
 
 #include <atomic>
+#include <cstddef>
 #include <limits>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
@@ -38,14 +40,43 @@ namespace common
 {
 namespace container
 {
+/// @brief non-owning view of the record headers in a record_header_buffer
+struct record_header_view
+{
+    using value_type = rocprofiler_record_header_t*;
+
+    record_header_view() = default;
+    record_header_view(value_type* _data, size_t _size)
+    : m_data{_data}
+    , m_size{_size}
+    {}
+
+    value_type* data() const { return m_data; }
+    size_t      size() const { return m_size; }
+    bool        empty() const { return m_size == 0; }
+    value_type* begin() const { return m_data; }
+    value_type* end() const { return m_data + m_size; }
+    value_type  operator[](size_t _idx) const { return m_data[_idx]; }
+
+private:
+    value_type* m_data = nullptr;
+    size_t      m_size = 0;
+};
+
 /// @brief this struct stores all the record information in an ring_buffer.
 /// It is thread-safe to have multiple threads emplace records into the buffer.
 struct record_header_buffer
 {
     using base_buffer_t    = base::ring_buffer;
-    using record_vec_t     = std::vector<rocprofiler_record_header_t>;
     using record_ptr_vec_t = std::vector<rocprofiler_record_header_t*>;
 
+    /// record headers are stored in fixed-size chunks so that growing the storage never moves
+    /// the headers already handed out
+    static constexpr size_t header_chunk_size = 1024;
+
+    using header_chunk_t     = std::unique_ptr<rocprofiler_record_header_t[]>;
+    using header_chunk_vec_t = std::vector<header_chunk_t>;
+
     record_header_buffer() = default;
     explicit record_header_buffer(size_t nbytes);
     ~record_header_buffer() = default;
@@ -79,6 +110,12 @@ struct record_header_buffer
     /// at the time of invocation.
     record_ptr_vec_t get_record_headers(size_t _n = std::numeric_limits<size_t>::max());
 
+    /// this function will return a view of the pointers to the record headers at the time of
+    /// invocation without copying them. The view is invalidated by clear(), reset(), load() and
+    /// by any emplace after the invocation. The record payloads are only guaranteed to be fully
+    /// written if no emplace is in progress, e.g. after seal()
+    record_header_view get_record_header_view(size_t _n = std::numeric_limits<size_t>::max());
+
     /// record_header_buffer is a multiple writer, single reader data structure so
     /// this function prevents writing via emplace
     void lock();
@@ -96,6 +133,14 @@ struct record_header_buffer
     /// check if writing is available
     bool is_locked() const;
 
+    /// prevent any further emplace until clear() is invoked and wait for any in-progress emplace
+    /// to complete. Used when the buffer is handed off to be flushed while other threads may
+    /// still hold a reference to it
+    void seal();
+
+    /// check if emplacing has been disabled via seal()
+    bool is_sealed() const;
+
     /// restores to original empty state
     size_t clear();
 
@@ -111,6 +156,9 @@ struct record_header_buffer
     /// the number of header entries
     auto size() const;
 
+    /// the number of headers the allocated header storage can hold
+    auto header_capacity() const;
+
     /// the number of bytes in the buffer
     auto capacity() const;
 
@@ -127,6 +175,14 @@ struct record_header_buffer
     auto is_full() const;
 
 private:
+    /// place an object in the buffer with the given (partially-filled) header
+    template <typename Tp>
+    bool emplace_record(rocprofiler_record_header_t, Tp&);
+
+    /// returns storage for the header of the record at the given index and appends it to the
+    /// array of header pointers. Must be invoked while holding the write lock
+    rocprofiler_record_header_t* append_header(size_t idx);
+
     /// this is an explicit write lock that does not guard against deadlocking like lock()
     void write_lock();
 
@@ -136,10 +192,12 @@ private:
 private:
     std::atomic<int64_t> m_requested = {0};
     std::atomic<int64_t> m_locked    = {0};
+    std::atomic<bool>    m_sealed    = {false};
     std::atomic<size_t>  m_index     = {};
     std::shared_mutex    m_shared    = {};
     base_buffer_t        m_buffer    = {};
-    record_vec_t         m_headers   = {};
+    header_chunk_vec_t   m_chunks    = {};  // storage for the headers, sized by record count
+    record_ptr_vec_t     m_headers   = {};  // pointers to the headers of the emplaced records
 };
 
 inline bool
@@ -148,6 +206,12 @@ record_header_buffer::is_locked() const
     return m_locked.load(std::memory_order_acquire) > 0;
 }
 
+inline bool
+record_header_buffer::is_sealed() const
+{
+    return m_sealed.load();
+}
+
 inline void
 record_header_buffer::lock()
 {
@@ -198,10 +262,16 @@ record_header_buffer::size() const
     return m_index.load(std::memory_order_acquire);
 }
 
+inline auto
+record_header_buffer::header_capacity() const
+{
+    return m_chunks.size() * header_chunk_size;
+}
+
 inline auto
 record_header_buffer::capacity() const
 {
-    return std::min<size_t>(m_headers.size(), m_buffer.capacity());
+    return m_buffer.capacity();
 }
 
 inline auto
@@ -219,20 +289,20 @@ record_header_buffer::free() const
 inline auto
 record_header_buffer::is_empty() const
 {
-    return (m_buffer.is_empty() && m_requested.load() == 0) || m_headers.empty();
+    return (m_buffer.is_empty() && m_requested.load() == 0) || !is_allocated();
 }
 
 inline auto
 record_header_buffer::is_full() const
 {
-    return m_buffer.is_full() || size() == m_headers.size();
+    return m_buffer.is_full() || !is_allocated();
 }
 
 template <typename Tp>
 bool
-record_header_buffer::emplace(uint64_t _hash, Tp& _v)
+record_header_buffer::emplace_record(rocprofiler_record_header_t _record, Tp& _v)
 {
-    if(m_headers.empty()) return false;
+    if(!is_allocated()) return false;
 
     constexpr auto request_size = sizeof(Tp);
     constexpr auto align_size   = alignof(Tp);
@@ -240,30 +310,33 @@ record_header_buffer::emplace(uint64_t _hash, Tp& _v)
     // notify there was a request
     m_requested.fetch_add(1);
 
+    // buffer was handed off to be flushed
+    if(m_sealed.load())
+    {
+        m_requested.fetch_sub(1);
+        return false;
+    }
+
     // in theory, we shouldn't need to lock here but the thread sanitizer says there is a race.
-    // the lock will be short-lived so hopefully, it will scale fine
+    // the lock will be short-lived so hopefully, it will scale fine. The header is written while
+    // holding the lock so that the array of headers never has a partially-initialized entry
     write_lock();
     auto* _addr = m_buffer.request(request_size, align_size, false);
+    if(_addr)
+    {
+        auto idx            = m_index.fetch_add(1, std::memory_order_release);
+        _record.payload     = _addr;
+        *append_header(idx) = _record;
+    }
     write_unlock();
 
-    read_lock();
     if(_addr)
     {
-        // if there is space in the buffer, atomically get an index
-        // for where the header record should be placed.
-        // NOTE: m_headers was resized to be large enough to accomodate
-        // sizeof(Tp) == 1 for every entry in buffer
-        auto idx = m_index.fetch_add(1, std::memory_order_release);
-
+        read_lock();
         // placement new
         new(_addr) Tp{_v};
-
-        auto record       = rocprofiler_record_header_t{};
-        record.hash       = _hash;
-        record.payload    = _addr;
-        m_headers.at(idx) = record;
+        read_unlock();
     }
-    read_unlock();
 
     // remove notification of request
     m_requested.fetch_sub(1);
@@ -273,46 +346,21 @@ record_header_buffer::emplace(uint64_t _hash, Tp& _v)
 
 template <typename Tp>
 bool
-record_header_buffer::emplace(uint32_t _category, uint32_t _kind, Tp& _v)
+record_header_buffer::emplace(uint64_t _hash, Tp& _v)
 {
-    if(m_headers.empty()) return false;
-
-    constexpr auto request_size = sizeof(Tp);
-    constexpr auto align_size   = alignof(Tp);
-
-    // notify there was a request
-    m_requested.fetch_add(1);
-
-    // in theory, we shouldn't need to lock here but the thread sanitizer says there is a race.
-    // the lock will be short-lived so hopefully, it will scale fine
-    write_lock();
-    auto* _addr = m_buffer.request(request_size, align_size, false);
-    write_unlock();
-
-    read_lock();
-    if(_addr)
-    {
-        // if there is space in the buffer, atomically get an index
-        // for where the header record should be placed.
-        // NOTE: m_headers was resized to be large enough to accomodate
-        // sizeof(Tp) == 1 for every entry in buffer
-        auto idx = m_index.fetch_add(1, std::memory_order_release);
-
-        // placement new
-        new(_addr) Tp{_v};
-
-        auto record       = rocprofiler_record_header_t{};
-        record.category   = _category;
-        record.kind       = _kind;
-        record.payload    = _addr;
-        m_headers.at(idx) = record;
-    }
-    read_unlock();
-
-    // remove notification of request
-    m_requested.fetch_sub(1);
+    auto record = rocprofiler_record_header_t{};
+    record.hash = _hash;
+    return emplace_record(record, _v);
+}
 
-    return (_addr != nullptr);
+template <typename Tp>
+bool
+record_header_buffer::emplace(uint32_t _category, uint32_t _kind, Tp& _v)
+{
+    auto record     = rocprofiler_record_header_t{};
+    record.category = _category;
+    record.kind     = _kind;
+    return emplace_record(record, _v);
 }
 
 template <typename Tp>
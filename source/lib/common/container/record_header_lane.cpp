@@ -0,0 +1,109 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/container/record_header_lane.hpp"
+#include "lib/common/units.hpp"
+
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <sys/mman.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace rocprofiler::common::container
+{
+record_header_lane::record_header_lane(size_t num_bytes) { allocate(num_bytes); }
+
+record_header_lane::~record_header_lane() { reset(); }
+
+bool
+record_header_lane::allocate(size_t num_bytes)
+{
+    if(m_data) return false;
+
+    // Round up to multiple of page size.
+    auto _page_size = units::get_page_size();
+    auto _size      = align_up(std::max<size_t>(num_bytes, 1), _page_size);
+
+    auto* _ptr = mmap(nullptr, _size, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if(_ptr == MAP_FAILED)
+    {
+        auto _err = errno;
+        throw std::runtime_error(strerror(_err));
+    }
+
+    m_data     = static_cast<std::byte*>(_ptr);
+    m_capacity = _size;
+    m_head.store(0, std::memory_order_release);
+    m_tail.store(0, std::memory_order_release);
+    return true;
+}
+
+uint64_t
+record_header_lane::acquire(record_ptr_vec_t& _headers) const
+{
+    if(!m_data) return m_tail.load(std::memory_order_acquire);
+
+    auto _pos  = m_tail.load(std::memory_order_relaxed);
+    auto _head = m_head.load(std::memory_order_acquire);
+
+    while(_pos < _head)
+    {
+        auto _offset    = static_cast<size_t>(_pos % m_capacity);
+        auto _remaining = m_capacity - _offset;
+        if(_remaining < sizeof(entry))
+        {
+            _pos += _remaining;
+            continue;
+        }
+
+        auto* _entry = reinterpret_cast<entry*>(m_data + _offset);
+        if(_entry->header.payload != nullptr) _headers.emplace_back(&_entry->header);
+        _pos += _entry->size;
+    }
+
+    return _pos;
+}
+
+void
+record_header_lane::release(uint64_t _pos)
+{
+    m_tail.store(_pos, std::memory_order_release);
+}
+
+void
+record_header_lane::reset()
+{
+    if(m_data)
+    {
+        auto ret = munmap(m_data, m_capacity);
+        if(ret != 0) perror("record_header_lane: munmap failed");
+    }
+    m_data     = nullptr;
+    m_capacity = 0;
+    m_head.store(0, std::memory_order_release);
+    m_tail.store(0, std::memory_order_release);
+}
+}  // namespace rocprofiler::common::container
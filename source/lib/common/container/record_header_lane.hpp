@@ -0,0 +1,177 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+/// \struct rocprofiler::common::container::record_header_lane
+/// \brief Single-producer, single-consumer ring of records. Unlike record_header_buffer, there is
+/// no lock and no shared index: the producing thread owns the write position and the consumer
+/// (the thread flushing the buffer) owns the read position. Each record is stored as an entry
+/// with the rocprofiler_record_header_t immediately preceding the payload so the consumer can hand
+/// out pointers to the headers without any additional storage.
+struct record_header_lane
+{
+    using record_ptr_vec_t = std::vector<rocprofiler_record_header_t*>;
+
+    record_header_lane() = default;
+    explicit record_header_lane(size_t nbytes);
+    ~record_header_lane();
+
+    record_header_lane(const record_header_lane&)     = delete;
+    record_header_lane(record_header_lane&&) noexcept = delete;
+
+    record_header_lane& operator=(const record_header_lane&) = delete;
+    record_header_lane& operator=(record_header_lane&&) noexcept = delete;
+
+    // allocate the lane if it is not already allocated. Will return false if lane is already
+    // allocated
+    bool allocate(size_t nbytes);
+
+    // return whether the lane has been allocated
+    bool is_allocated() const { return m_data != nullptr; }
+
+    /// place an object in the lane using the specified numerical identifier. Must only be invoked
+    /// by the thread which owns the lane.
+    template <typename Tp>
+    bool emplace(uint32_t, uint32_t, Tp&);
+
+    /// append the pointers to the headers of every record published at the time of invocation
+    /// and return the position which should be passed to release() once the records have been
+    /// consumed. Must only be invoked by a single consumer at a time.
+    uint64_t acquire(record_ptr_vec_t& _headers) const;
+
+    /// make the space occupied by the records acquired up to the given position available to
+    /// the producer again
+    void release(uint64_t _pos);
+
+    /// full deallocation
+    void reset();
+
+    /// the number of bytes in the lane
+    size_t capacity() const { return m_capacity; }
+
+    /// the number of used bytes in the lane
+    size_t count() const;
+
+    /// true if no bytes are used in the lane
+    bool is_empty() const { return count() == 0; }
+
+private:
+    struct entry
+    {
+        uint64_t                    size   = 0;  // bytes until the next entry
+        rocprofiler_record_header_t header = {};  // payload == nullptr means padding
+    };
+
+    static constexpr size_t align_up(size_t _v, size_t _align)
+    {
+        return ((_v + _align - 1) / _align) * _align;
+    }
+
+    std::byte* m_data     = nullptr;
+    size_t     m_capacity = 0;
+    // written by the producer, read by the consumer
+    alignas(64) std::atomic<uint64_t> m_head = {0};
+    // written by the consumer, read by the producer
+    alignas(64) std::atomic<uint64_t> m_tail = {0};
+};
+
+inline size_t
+record_header_lane::count() const
+{
+    return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire);
+}
+
+template <typename Tp>
+bool
+record_header_lane::emplace(uint32_t _category, uint32_t _kind, Tp& _v)
+{
+    if(!m_data) return false;
+
+    constexpr auto entry_align = alignof(entry);
+
+    // only this thread modifies m_head
+    auto _head   = m_head.load(std::memory_order_relaxed);
+    auto _tail   = m_tail.load(std::memory_order_acquire);
+    auto _offset = static_cast<size_t>(_head % m_capacity);
+
+    auto _get_sizes = [](size_t _off) {
+        auto _payload_off = align_up(_off + sizeof(entry), alignof(Tp)) - _off;
+        return std::make_pair(_payload_off, align_up(_payload_off + sizeof(Tp), entry_align));
+    };
+
+    auto [_payload_off, _total] = _get_sizes(_offset);
+    auto _contiguous            = m_capacity - _offset;
+    auto _padding               = size_t{0};
+
+    // records never straddle the end of the lane: skip the remainder and start at the beginning
+    if(_contiguous < _total)
+    {
+        _padding                       = _contiguous;
+        std::tie(_payload_off, _total) = _get_sizes(0);
+        if(_total > m_capacity) return false;
+    }
+
+    if((_head - _tail) + _padding + _total > m_capacity) return false;
+
+    if(_padding > 0)
+    {
+        // the consumer implicitly skips a remainder too small to hold an entry
+        if(_padding >= sizeof(entry)) new(m_data + _offset) entry{_padding, {}};
+        _head += _padding;
+        _offset = 0;
+    }
+
+    auto* _addr = m_data + _offset + _payload_off;
+
+    // placement new
+    new(_addr) Tp{_v};
+
+    auto* _entry            = new(m_data + _offset) entry{_total, {}};
+    _entry->header.category = _category;
+    _entry->header.kind     = _kind;
+    _entry->header.payload  = _addr;
+
+    // publish the record to the consumer
+    m_head.store(_head + _total, std::memory_order_release);
+
+    return true;
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
@@ -129,6 +129,14 @@ struct ring_buffer
     /// Display info about buffer
     std::string as_string() const;
 
+    /// fields written by save() ahead of the raw buffer contents
+    struct save_header
+    {
+        size_t size        = 0;
+        size_t read_count  = 0;
+        size_t write_count = 0;
+    };
+
     /// save the entire buffer to a filestream
     void save(std::fstream& _fs);
 
@@ -359,6 +367,7 @@ struct ring_buffer : private base::ring_buffer
 
     using base_type::load;
     using base_type::save;
+    using save_header = base_type::save_header;
 
     std::string as_string() const
     {
@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#pragma once
+
+#include "lib/common/container/small_vector.hpp"
+#include "lib/common/defines.hpp"
+
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace container
+{
+/**
+ * @brief Associative container storing key/value pairs contiguously in a small_vector with
+ * linear lookup. For the handful of keys typical of per-call bookkeeping (e.g. one entry per
+ * active context) this beats a hash map and performs no heap allocation until more than N
+ * entries are inserted. Insertion order is preserved. Provides the subset of the
+ * std::unordered_map interface used in the library (find, at, emplace, operator[], erase).
+ */
+template <typename KeyT, typename MappedT, unsigned N>
+class small_flat_map
+{
+public:
+    using key_type        = KeyT;
+    using mapped_type     = MappedT;
+    using value_type      = std::pair<KeyT, MappedT>;
+    using storage_type    = small_vector<value_type, N>;
+    using size_type       = size_t;
+    using iterator        = typename storage_type::iterator;
+    using const_iterator  = typename storage_type::const_iterator;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+    small_flat_map()                          = default;
+    ~small_flat_map()                         = default;
+    small_flat_map(const small_flat_map&)     = default;
+    small_flat_map(small_flat_map&&) noexcept = default;
+    small_flat_map& operator=(const small_flat_map&) = default;
+    small_flat_map& operator=(small_flat_map&&) noexcept = default;
+
+    iterator       begin() { return m_data.begin(); }
+    iterator       end() { return m_data.end(); }
+    const_iterator begin() const { return m_data.begin(); }
+    const_iterator end() const { return m_data.end(); }
+    const_iterator cbegin() const { return m_data.begin(); }
+    const_iterator cend() const { return m_data.end(); }
+
+    size_t size() const { return m_data.size(); }
+    bool   empty() const { return m_data.empty(); }
+    void   clear() { m_data.clear(); }
+    void   reserve(size_t _n) { m_data.reserve(_n); }
+
+    iterator       find(const key_type& _key);
+    const_iterator find(const key_type& _key) const;
+    size_t         count(const key_type& _key) const { return (find(_key) != end()) ? 1 : 0; }
+
+    mapped_type&       at(const key_type& _key);
+    const mapped_type& at(const key_type& _key) const;
+    mapped_type&       operator[](const key_type& _key);
+
+    // does not replace the value if the key already exists (same as std::unordered_map)
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const key_type& _key, Args&&... _args);
+
+    size_t erase(const key_type& _key);
+
+private:
+    storage_type m_data = {};
+};
+
+template <typename KeyT, typename MappedT, unsigned N>
+typename small_flat_map<KeyT, MappedT, N>::iterator
+small_flat_map<KeyT, MappedT, N>::find(const key_type& _key)
+{
+    for(auto itr = m_data.begin(); itr != m_data.end(); ++itr)
+        if(itr->first == _key) return itr;
+    return m_data.end();
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+typename small_flat_map<KeyT, MappedT, N>::const_iterator
+small_flat_map<KeyT, MappedT, N>::find(const key_type& _key) const
+{
+    for(auto itr = m_data.begin(); itr != m_data.end(); ++itr)
+        if(itr->first == _key) return itr;
+    return m_data.end();
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+MappedT&
+small_flat_map<KeyT, MappedT, N>::at(const key_type& _key)
+{
+    auto itr = find(_key);
+    if(ROCPROFILER_UNLIKELY(itr == end())) throw std::out_of_range{"small_flat_map::at"};
+    return itr->second;
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+const MappedT&
+small_flat_map<KeyT, MappedT, N>::at(const key_type& _key) const
+{
+    auto itr = find(_key);
+    if(ROCPROFILER_UNLIKELY(itr == end())) throw std::out_of_range{"small_flat_map::at"};
+    return itr->second;
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+MappedT&
+small_flat_map<KeyT, MappedT, N>::operator[](const key_type& _key)
+{
+    return emplace(_key).first->second;
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+template <typename... Args>
+std::pair<typename small_flat_map<KeyT, MappedT, N>::iterator, bool>
+small_flat_map<KeyT, MappedT, N>::emplace(const key_type& _key, Args&&... _args)
+{
+    auto itr = find(_key);
+    if(itr != end()) return std::make_pair(itr, false);
+
+    m_data.emplace_back(_key, mapped_type{std::forward<Args>(_args)...});
+    return std::make_pair(m_data.end() - 1, true);
+}
+
+template <typename KeyT, typename MappedT, unsigned N>
+size_t
+small_flat_map<KeyT, MappedT, N>::erase(const key_type& _key)
+{
+    auto itr = find(_key);
+    if(itr == end()) return 0;
+
+    m_data.erase(itr);
+    return 1;
+}
+}  // namespace container
+}  // namespace common
+}  // namespace rocprofiler
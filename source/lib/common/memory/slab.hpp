@@ -0,0 +1,204 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#pragma once
+
+#include "lib/common/defines.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace memory
+{
+// thread-safe pool of fixed-size slots. Slots are carved out of blocks holding
+// ObjectsPerBlock slots each and are recycled through a free list so, once the slab has
+// grown to the high-water mark of live objects, allocate/deallocate never touch the
+// system allocator. Blocks are only released when the slab is destroyed.
+class slab
+{
+public:
+    static constexpr size_t alignment = alignof(std::max_align_t);
+
+    explicit slab(size_t object_size, size_t objects_per_block = 64);
+    ~slab()               = default;
+    slab(const slab&)     = delete;
+    slab(slab&&) noexcept = delete;
+    slab& operator=(const slab&) = delete;
+    slab& operator=(slab&&) noexcept = delete;
+
+    void*  allocate();
+    void   deallocate(void* ptr);
+    size_t object_size() const { return m_object_size; }
+    size_t num_blocks() const;
+    size_t num_free() const;
+
+private:
+    void append();
+
+    size_t                                  m_object_size       = 0;
+    size_t                                  m_objects_per_block = 0;
+    mutable std::mutex                      m_mutex             = {};
+    std::vector<void*>                      m_free              = {};
+    std::vector<std::unique_ptr<uint8_t[]>> m_blocks            = {};
+};
+
+// allocator which draws single objects from a shared slab. Suitable for std::allocate_shared:
+// the rebound allocator for the control block uses the slab as long as the slab slot is large
+// enough, otherwise it falls back to the global operator new
+template <typename Tp>
+class slab_allocator
+{
+public:
+    using value_type      = Tp;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+
+    template <typename Up>
+    struct rebind
+    {
+        using other = slab_allocator<Up>;
+    };
+
+    explicit slab_allocator(std::shared_ptr<slab> _slab)
+    : m_slab{std::move(_slab)}
+    {}
+
+    template <typename Up>
+    slab_allocator(const slab_allocator<Up>& rhs)
+    : m_slab{rhs.m_slab}
+    {}
+
+    slab_allocator(const slab_allocator&)     = default;
+    slab_allocator(slab_allocator&&) noexcept = default;
+    slab_allocator& operator=(const slab_allocator&) = default;
+    slab_allocator& operator=(slab_allocator&&) noexcept = default;
+
+    Tp*  allocate(size_t n);
+    void deallocate(Tp* ptr, size_t n);
+
+    template <typename Up>
+    bool operator==(const slab_allocator<Up>& rhs) const
+    {
+        return m_slab == rhs.m_slab;
+    }
+
+    template <typename Up>
+    bool operator!=(const slab_allocator<Up>& rhs) const
+    {
+        return m_slab != rhs.m_slab;
+    }
+
+private:
+    template <typename Up>
+    friend class slab_allocator;
+
+    bool use_slab(size_t n) const
+    {
+        return (n == 1 && sizeof(Tp) <= m_slab->object_size() && alignof(Tp) <= slab::alignment);
+    }
+
+    std::shared_ptr<slab> m_slab = {};
+};
+
+inline slab::slab(size_t object_size, size_t objects_per_block)
+: m_object_size{((object_size + alignment - 1) / alignment) * alignment}
+, m_objects_per_block{(objects_per_block > 0) ? objects_per_block : 1}
+{}
+
+inline void*
+slab::allocate()
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    if(m_free.empty()) append();
+
+    auto* ptr = m_free.back();
+    m_free.pop_back();
+    return ptr;
+}
+
+inline void
+slab::deallocate(void* ptr)
+{
+    if(!ptr) return;
+
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    m_free.emplace_back(ptr);
+}
+
+inline size_t
+slab::num_blocks() const
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    return m_blocks.size();
+}
+
+inline size_t
+slab::num_free() const
+{
+    auto _lk = std::unique_lock<std::mutex>{m_mutex};
+    return m_free.size();
+}
+
+// requires m_mutex to be held
+inline void
+slab::append()
+{
+    // operator new[] guarantees alignment suitable for std::max_align_t
+    auto block = std::make_unique<uint8_t[]>(m_object_size * m_objects_per_block);
+
+    // reserve for every slot ever created so deallocate never reallocates the free list
+    m_free.reserve((m_blocks.size() + 1) * m_objects_per_block);
+    for(size_t i = 0; i < m_objects_per_block; ++i)
+        m_free.emplace_back(block.get() + (i * m_object_size));
+
+    m_blocks.emplace_back(std::move(block));
+}
+
+template <typename Tp>
+Tp*
+slab_allocator<Tp>::allocate(size_t n)
+{
+    if(use_slab(n)) return static_cast<Tp*>(m_slab->allocate());
+
+    return static_cast<Tp*>(::operator new(n * sizeof(Tp)));
+}
+
+template <typename Tp>
+void
+slab_allocator<Tp>::deallocate(Tp* ptr, size_t n)
+{
+    if(use_slab(n))
+        m_slab->deallocate(ptr);
+    else
+        ::operator delete(ptr);
+}
+}  // namespace memory
+}  // namespace common
+}  // namespace rocprofiler
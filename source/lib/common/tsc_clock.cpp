@@ -0,0 +1,240 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "lib/common/tsc_clock.hpp"
+#include "lib/common/environment.hpp"
+#include "lib/common/logging.hpp"
+#include "lib/common/utility.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <thread>
+
+#if defined(__x86_64__)
+#    include <cpuid.h>
+#endif
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace tsc
+{
+namespace
+{
+// duration of the initial calibration and the interval between re-calibrations
+constexpr auto calibration_duration = std::chrono::milliseconds{10};
+constexpr auto resync_interval      = std::chrono::milliseconds{100};
+// rate changes larger than this (e.g. the TSC was halted during a system suspend) only re-anchor
+// the calibration
+constexpr double max_rate_change = 0.01;
+
+struct sample
+{
+    uint64_t ticks = 0;
+    uint64_t ns    = 0;
+};
+
+std::atomic_flag calibration_mutex = ATOMIC_FLAG_INIT;
+
+// the last CLOCK_BOOTTIME sample and the rate measured up to it. The published calibration may
+// be anchored above the clock (see resync) so the rate is measured between the raw samples.
+// Guarded by calibration_mutex.
+sample   last_sample = {};
+uint64_t last_rate   = 0;
+
+// pair a CLOCK_BOOTTIME reading with the TSC: the midpoint of the two TSC reads around the
+// clock_gettime call with the narrowest window out of a few attempts
+sample
+read_sample()
+{
+    auto _sample = sample{};
+    auto _window = std::numeric_limits<uint64_t>::max();
+    for(int i = 0; i < 5; ++i)
+    {
+        const auto _beg = read_ticks();
+        const auto _ns  = get_ticks(CLOCK_BOOTTIME);
+        const auto _end = read_ticks();
+        if(_end >= _beg && (_end - _beg) < _window)
+        {
+            _window = (_end - _beg);
+            _sample = {_beg + (_window / 2), _ns};
+        }
+    }
+    return _sample;
+}
+
+// nanoseconds per tick scaled by 2^conversion_shift
+uint64_t
+compute_mult(const sample& _beg, const sample& _end)
+{
+    if(_end.ticks <= _beg.ticks || _end.ns <= _beg.ns) return 0;
+
+    const auto _ns_per_tick = static_cast<double>(_end.ns - _beg.ns) /
+                              static_cast<double>(_end.ticks - _beg.ticks);
+    return static_cast<uint64_t>(std::llround(std::ldexp(_ns_per_tick, conversion_shift)));
+}
+
+constexpr auto interval_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(resync_interval).count();
+
+uint64_t
+get_resync_ticks(uint64_t _mult)
+{
+    return (static_cast<uint64_t>(interval_ns) << conversion_shift) / _mult;
+}
+
+void
+publish(const sample& _anchor, uint64_t _mult)
+{
+    // only one thread publishes at a time (initial calibration or calibration_mutex holder)
+    auto&      _pub = get_published_calibration();
+    const auto _seq = _pub.sequence.load(std::memory_order_relaxed);
+    _pub.sequence.store(_seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    _pub.tsc_base.store(_anchor.ticks, std::memory_order_relaxed);
+    _pub.ns_base.store(_anchor.ns, std::memory_order_relaxed);
+    _pub.mult.store(_mult, std::memory_order_relaxed);
+    _pub.resync_ticks.store(get_resync_ticks(_mult), std::memory_order_relaxed);
+
+    _pub.sequence.store(_seq + 2, std::memory_order_release);
+}
+
+bool
+calibrate()
+{
+    auto _beg = read_sample();
+    std::this_thread::sleep_for(calibration_duration);
+    auto _end  = read_sample();
+    auto _mult = compute_mult(_beg, _end);
+
+    if(_mult == 0) return false;
+
+    last_sample = _end;
+    last_rate   = _mult;
+    publish(_end, _mult);
+    ROCP_INFO << "TSC calibrated against CLOCK_BOOTTIME: "
+              << std::ldexp(static_cast<double>(_mult), -static_cast<int>(conversion_shift))
+              << " ns/tick";
+    return true;
+}
+}  // namespace
+
+bool
+is_supported()
+{
+#if defined(__x86_64__)
+    unsigned int _eax = 0, _ebx = 0, _ecx = 0, _edx = 0;
+    if(__get_cpuid(0x80000000, &_eax, &_ebx, &_ecx, &_edx) == 0 || _eax < 0x80000007)
+        return false;
+    if(__get_cpuid(0x80000007, &_eax, &_ebx, &_ecx, &_edx) == 0) return false;
+    // CPUID.80000007H:EDX[8] : invariant TSC
+    return ((_edx & (1U << 8)) != 0);
+#else
+    return false;
+#endif
+}
+
+bool
+is_enabled()
+{
+    static const bool _v = []() {
+        auto _source = get_env("ROCPROFILER_TIMESTAMP_SOURCE", std::string{"clock_gettime"});
+        if(_source != "tsc") return false;
+
+        if(!is_supported())
+        {
+            ROCP_WARNING << "ROCPROFILER_TIMESTAMP_SOURCE=tsc requires an invariant TSC. "
+                            "Timestamps will be read via clock_gettime(CLOCK_BOOTTIME)";
+            return false;
+        }
+
+        if(!calibrate())
+        {
+            ROCP_WARNING << "TSC calibration against CLOCK_BOOTTIME failed. Timestamps will be "
+                            "read via clock_gettime(CLOCK_BOOTTIME)";
+            return false;
+        }
+        return true;
+    }();
+    return _v;
+}
+
+uint64_t
+read_clock()
+{
+    return get_ticks(CLOCK_BOOTTIME);
+}
+
+uint64_t
+resync()
+{
+    // another thread is re-calibrating: wait for the new calibration instead of reading the
+    // clock directly, which may be behind the timestamps converted with the old calibration
+    if(calibration_mutex.test_and_set(std::memory_order_acquire))
+    {
+        while(calibration_mutex.test_and_set(std::memory_order_acquire))
+            std::this_thread::yield();
+        calibration_mutex.clear(std::memory_order_release);
+        return timestamp_ns();
+    }
+
+    const auto _prev = get_calibration();
+    const auto _now  = read_sample();
+    auto       _rate = compute_mult(last_sample, _now);
+
+    // the rate of an invariant TSC does not change so a large change means the clocks did not
+    // advance together, e.g. the system was suspended (CLOCK_BOOTTIME includes the suspend)
+    const auto _change = std::abs(static_cast<double>(_rate) - static_cast<double>(last_rate)) /
+                         static_cast<double>(last_rate);
+    if(_rate == 0 || _change > max_rate_change) _rate = last_rate;
+
+    last_sample = _now;
+    last_rate   = _rate;
+
+    // never step backwards: when the previous calibration ran ahead of the clock, the new one
+    // starts where the previous one ends and runs slightly slower so the timestamps converge
+    // with CLOCK_BOOTTIME over the next interval
+    auto _anchor = sample{_now.ticks, std::max(_now.ns, convert(_prev, _now.ticks))};
+    auto _mult   = _rate;
+    if(_anchor.ns > _now.ns)
+    {
+        const auto _slew = std::ldexp(static_cast<double>(_anchor.ns - _now.ns) /
+                                          static_cast<double>(get_resync_ticks(_rate)),
+                                      conversion_shift);
+        const auto _max  = static_cast<double>(_rate) * max_rate_change;
+        _mult -= static_cast<uint64_t>(std::min(_slew, _max));
+    }
+
+    publish(_anchor, _mult);
+    calibration_mutex.clear(std::memory_order_release);
+
+    return _anchor.ns;
+}
+}  // namespace tsc
+}  // namespace common
+}  // namespace rocprofiler
@@ -0,0 +1,160 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#pragma once
+
+#include "lib/common/defines.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#    include <x86intrin.h>
+#endif
+
+namespace rocprofiler
+{
+namespace common
+{
+namespace tsc
+{
+/// \struct calibration
+/// \brief Conversion of the CPU time-stamp counter (TSC) to CLOCK_BOOTTIME nanoseconds:
+///
+///     ns = ns_base + (((tsc - tsc_base) * mult) >> conversion_shift)
+///
+/// After the counter has advanced `resync_ticks` past `tsc_base`, the next timestamp
+/// re-calibrates against CLOCK_BOOTTIME so the drift between the two clocks stays bounded. A new
+/// calibration never starts below the value the previous one reaches at `tsc_base` so the
+/// timestamps are monotonic.
+struct calibration
+{
+    uint64_t tsc_base     = 0;
+    uint64_t ns_base      = 0;
+    uint64_t mult         = 0;
+    uint64_t resync_ticks = 0;
+};
+
+/// \struct published_calibration
+/// \brief The current calibration guarded by a sequence lock: the sequence is odd while the
+/// calibration is being re-written and readers retry when it changed during their read.
+struct published_calibration
+{
+    std::atomic<uint64_t> sequence     = {0};
+    std::atomic<uint64_t> tsc_base     = {0};
+    std::atomic<uint64_t> ns_base      = {0};
+    std::atomic<uint64_t> mult         = {0};
+    std::atomic<uint64_t> resync_ticks = {0};
+};
+
+static constexpr uint32_t conversion_shift = 32;
+
+/// true if the CPU provides an invariant TSC (constant rate in all P-, C-, and T-states)
+bool
+is_supported();
+
+/// true if ROCPROFILER_TIMESTAMP_SOURCE=tsc and the TSC is invariant. The first call calibrates
+/// the TSC against CLOCK_BOOTTIME. When the TSC is not invariant, a warning is emitted and the
+/// timestamps fall back to clock_gettime(CLOCK_BOOTTIME).
+bool
+is_enabled();
+
+/// the published calibration (valid once is_enabled() returns true)
+inline published_calibration&
+get_published_calibration()
+{
+    static auto _v = published_calibration{};
+    return _v;
+}
+
+/// consistent copy of the published calibration
+inline calibration
+get_calibration() noexcept
+{
+    auto& _pub = get_published_calibration();
+    while(true)
+    {
+        const auto _seq = _pub.sequence.load(std::memory_order_acquire);
+        if(ROCPROFILER_UNLIKELY((_seq & 1) != 0)) continue;
+
+        auto _cal = calibration{_pub.tsc_base.load(std::memory_order_relaxed),
+                                _pub.ns_base.load(std::memory_order_relaxed),
+                                _pub.mult.load(std::memory_order_relaxed),
+                                _pub.resync_ticks.load(std::memory_order_relaxed)};
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(ROCPROFILER_LIKELY(_pub.sequence.load(std::memory_order_relaxed) == _seq)) return _cal;
+    }
+}
+
+/// re-calibrates (or waits for the thread re-calibrating) and returns the timestamp converted
+/// with the new calibration, i.e. the slow path of timestamp_ns()
+uint64_t
+resync();
+
+/// CLOCK_BOOTTIME timestamp read via clock_gettime
+uint64_t
+read_clock();
+
+inline uint64_t
+read_ticks() noexcept
+{
+#if defined(__x86_64__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/// converts ticks with the calibration. The counter of the calling thread may lag tsc_base, e.g.
+/// on another socket, in which case the offset is subtracted.
+inline uint64_t
+convert(const calibration& _cal, uint64_t _ticks) noexcept
+{
+    // the full 128-bit product so a large offset cannot overflow
+    using wide_t = unsigned __int128;
+
+    if(_ticks >= _cal.tsc_base)
+        return _cal.ns_base + static_cast<uint64_t>((wide_t{_ticks - _cal.tsc_base} * _cal.mult) >>
+                                                    conversion_shift);
+
+    const auto _offset =
+        static_cast<uint64_t>((wide_t{_cal.tsc_base - _ticks} * _cal.mult) >> conversion_shift);
+    return (_offset < _cal.ns_base) ? (_cal.ns_base - _offset) : 0;
+}
+
+/// CLOCK_BOOTTIME timestamp in nanoseconds derived from the TSC. Requires is_enabled() == true
+inline uint64_t
+timestamp_ns()
+{
+    const auto _cal   = get_calibration();
+    const auto _ticks = read_ticks();
+
+    if(ROCPROFILER_UNLIKELY(_ticks >= _cal.tsc_base &&
+                            _ticks - _cal.tsc_base >= _cal.resync_ticks))
+        return resync();
+
+    return convert(_cal, _ticks);
+}
+}  // namespace tsc
+}  // namespace common
+}  // namespace rocprofiler
@@ -24,6 +24,7 @@
 
 #include "lib/common/defines.hpp"
 #include "lib/common/logging.hpp"
+#include "lib/common/tsc_clock.hpp"
 
 #include <sys/syscall.h>
 #include <sys/utsname.h>
@@ -83,12 +84,20 @@ static constexpr int default_clock_id = CLOCK_BOOTTIME;
 
 // CLOCK_MONOTONIC_RAW equates to HSA-runtime library implementation of os::ReadAccurateClock()
 // CLOCK_BOOTTIME equates to HSA-runtime library implementation of os::ReadSystemClock()
+// CLOCK_BOOTTIME timestamps are derived from the TSC when ROCPROFILER_TIMESTAMP_SOURCE=tsc
 template <int ClockT = default_clock_id>
 inline uint64_t
 timestamp_ns()
 {
-    constexpr auto _clk        = ClockT;
-    static auto    _clk_period = get_clock_period_ns_impl(_clk);
+    constexpr auto _clk = ClockT;
+
+    if constexpr(_clk == CLOCK_BOOTTIME)
+    {
+        static const bool _use_tsc = tsc::is_enabled();
+        if(_use_tsc) return tsc::timestamp_ns();
+    }
+
+    static auto _clk_period = get_clock_period_ns_impl(_clk);
 
     if(ROCPROFILER_LIKELY(_clk_period == 1)) return get_ticks(_clk);
     return get_ticks(_clk) / _clk_period;
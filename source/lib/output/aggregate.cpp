@@ -0,0 +1,354 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "aggregate.hpp"
+#include "reservoir.hpp"
+
+#include "lib/common/logging.hpp"
+#include "lib/common/string_entry.hpp"
+
+#include <rocprofiler-sdk/marker/api_id.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+namespace
+{
+using pc_sample_reservoir_t = bottom_k_sample<rocprofiler_tool_pc_sampling_host_trap_record_t>;
+
+struct thread_aggregates
+{
+    aggregate_map_t           api                 = {};
+    pc_sample_aggregate_map_t pc_samples          = {};
+    pc_sample_reservoir_t     pc_sample_reservoir = {};
+};
+
+struct aggregate_registry
+{
+    std::mutex                                      mutex  = {};
+    std::vector<std::unique_ptr<thread_aggregates>> tables = {};
+};
+
+aggregate_registry&
+get_aggregate_registry()
+{
+    // intentionally leaked so that threads which exit after main can still register
+    static auto* _v = new aggregate_registry{};
+    return *_v;
+}
+
+thread_aggregates&
+get_thread_aggregates()
+{
+    static thread_local thread_aggregates* _v = []() {
+        auto& _registry = get_aggregate_registry();
+        auto  _lk       = std::lock_guard<std::mutex>{_registry.mutex};
+        return _registry.tables.emplace_back(std::make_unique<thread_aggregates>()).get();
+    }();
+    return *_v;
+}
+
+template <typename RecordT>
+void
+aggregate_record(domain_type    domain,
+                 const RecordT& record,
+                 uint64_t       operation,
+                 uint64_t       agent,
+                 uint64_t       name_id = 0,
+                 uint64_t       weight  = 1)
+{
+    auto _key = aggregate_key{domain, static_cast<int32_t>(record.kind), operation, agent, name_id};
+    get_thread_aggregates().api[_key].add(record.end_timestamp - record.start_timestamp, weight);
+}
+}  // namespace
+
+size_t
+aggregate_key_hash::operator()(const aggregate_key& val) const
+{
+    constexpr size_t prime = 0x100000001b3;
+
+    size_t _hash = 0xcbf29ce484222325;
+    for(auto itr : {static_cast<uint64_t>(val.domain),
+                    static_cast<uint64_t>(val.kind),
+                    val.operation,
+                    val.agent,
+                    val.name_id})
+        _hash = (_hash ^ itr) * prime;
+    return _hash;
+}
+
+void
+aggregate_value::add(uint64_t duration, uint64_t weight)
+{
+    stats.add(duration, static_cast<int64_t>(weight));
+}
+
+aggregate_value&
+aggregate_value::operator+=(const aggregate_value& rhs)
+{
+    stats += rhs.stats;
+    return *this;
+}
+
+void
+pc_sample_aggregate_value::add(const rocprofiler_tool_pc_sampling_host_trap_record_t& record)
+{
+    const auto& _sample = record.pc_sample_record;
+
+    if(active_lanes.get_count() == 0)
+    {
+        inst_index      = record.inst_index;
+        first_timestamp = _sample.timestamp;
+        last_timestamp  = _sample.timestamp;
+    }
+    first_timestamp = std::min(first_timestamp, _sample.timestamp);
+    last_timestamp  = std::max(last_timestamp, _sample.timestamp);
+    active_lanes += static_cast<uint64_t>(__builtin_popcountll(_sample.exec_mask));
+}
+
+pc_sample_aggregate_value&
+pc_sample_aggregate_value::operator+=(const pc_sample_aggregate_value& rhs)
+{
+    if(rhs.active_lanes.get_count() == 0) return *this;
+
+    if(active_lanes.get_count() == 0)
+    {
+        *this = rhs;
+        return *this;
+    }
+
+    first_timestamp = std::min(first_timestamp, rhs.first_timestamp);
+    last_timestamp  = std::max(last_timestamp, rhs.last_timestamp);
+    active_lanes += rhs.active_lanes;
+    return *this;
+}
+
+void
+aggregate(const output_config&                                       cfg,
+          const metadata&,
+          const rocprofiler_buffer_tracing_kernel_dispatch_record_t& record)
+{
+    // the external correlation id is only the string entry of the kernel name when renaming
+    aggregate_record(domain_type::KERNEL_DISPATCH,
+                     record,
+                     record.dispatch_info.kernel_id,
+                     record.dispatch_info.agent_id.handle,
+                     (cfg.kernel_rename) ? record.correlation_id.external.value : 0);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_hip_api_record_t& record)
+{
+    aggregate_record(domain_type::HIP, record, record.operation, 0, 0, record.sampling_weight);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_hsa_api_record_t& record)
+{
+    aggregate_record(domain_type::HSA, record, record.operation, 0, 0, record.sampling_weight);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_memory_copy_record_t& record)
+{
+    aggregate_record(
+        domain_type::MEMORY_COPY, record, record.operation, record.dst_agent_id.handle);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_memory_allocation_record_t& record)
+{
+    aggregate_record(
+        domain_type::MEMORY_ALLOCATION, record, record.operation, record.agent_id.handle);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&                                       tool_metadata,
+          const rocprofiler_buffer_tracing_marker_api_record_t& record)
+{
+    auto _name_id = uint64_t{0};
+    if(record.kind == ROCPROFILER_BUFFER_TRACING_MARKER_CORE_API &&
+       (record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxMarkA ||
+        record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangePushA ||
+        record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangeStartA))
+    {
+        _name_id = common::add_string_entry(
+            tool_metadata.get_marker_message(record.correlation_id.internal));
+    }
+
+    aggregate_record(domain_type::MARKER, record, record.operation, 0, _name_id);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_scratch_memory_record_t& record)
+{
+    aggregate_record(domain_type::SCRATCH_MEMORY, record, record.operation, record.agent_id.handle);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_rccl_api_record_t& record)
+{
+    aggregate_record(domain_type::RCCL, record, record.operation, 0);
+}
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_rocdecode_api_record_t& record)
+{
+    aggregate_record(domain_type::ROCDECODE, record, record.operation, 0);
+}
+
+void
+aggregate(const rocprofiler_tool_pc_sampling_host_trap_record_t& record, size_t reservoir_size)
+{
+    auto& _tables = get_thread_aggregates();
+    auto  _key    = inst_t{record.pc_sample_record.pc.code_object_id,
+                        record.pc_sample_record.pc.code_object_offset};
+    _tables.pc_samples[_key].add(record);
+
+    if(reservoir_size > 0)
+    {
+        static thread_local auto _rng = std::mt19937_64{std::random_device{}()};
+        if(_tables.pc_sample_reservoir.capacity() != reservoir_size)
+            _tables.pc_sample_reservoir = pc_sample_reservoir_t{reservoir_size};
+        _tables.pc_sample_reservoir.add(_rng(), record);
+    }
+}
+
+aggregate_map_t
+get_aggregates()
+{
+    auto& _registry = get_aggregate_registry();
+    auto  _lk       = std::lock_guard<std::mutex>{_registry.mutex};
+
+    auto _data = aggregate_map_t{};
+    for(const auto& itr : _registry.tables)
+    {
+        for(const auto& [key, value] : itr->api)
+            _data[key] += value;
+    }
+
+    ROCP_INFO << "rocprofv3 merged " << _data.size() << " aggregate(s) from "
+              << _registry.tables.size() << " thread(s)";
+
+    return _data;
+}
+
+pc_sample_aggregate_map_t
+get_pc_sample_aggregates()
+{
+    auto& _registry = get_aggregate_registry();
+    auto  _lk       = std::lock_guard<std::mutex>{_registry.mutex};
+
+    auto _data = pc_sample_aggregate_map_t{};
+    for(const auto& itr : _registry.tables)
+    {
+        for(const auto& [key, value] : itr->pc_samples)
+            _data[key] += value;
+    }
+
+    ROCP_INFO << "rocprofv3 merged the PC samples of " << _data.size() << " instruction(s) from "
+              << _registry.tables.size() << " thread(s)";
+
+    return _data;
+}
+
+pc_sample_aggregate_vec_t
+sort_pc_sample_aggregates(const pc_sample_aggregate_map_t& data)
+{
+    using entry_t = pc_sample_aggregate_vec_t::value_type;
+
+    auto _entries = pc_sample_aggregate_vec_t{};
+    _entries.reserve(data.size());
+    for(const auto& [key, value] : data)
+        _entries.emplace_back(key, &value);
+    std::sort(_entries.begin(), _entries.end(), [](const entry_t& lhs, const entry_t& rhs) {
+        auto _lhs_count = lhs.second->active_lanes.get_count();
+        auto _rhs_count = rhs.second->active_lanes.get_count();
+        if(_lhs_count != _rhs_count) return (_lhs_count > _rhs_count);
+        return (lhs.first < rhs.first);
+    });
+    return _entries;
+}
+
+pc_sample_record_vec_t
+get_pc_sample_reservoir(size_t reservoir_size)
+{
+    auto& _registry = get_aggregate_registry();
+    auto  _lk       = std::lock_guard<std::mutex>{_registry.mutex};
+
+    auto _reservoir = pc_sample_reservoir_t{reservoir_size};
+    for(const auto& itr : _registry.tables)
+        _reservoir += itr->pc_sample_reservoir;
+
+    auto _data = pc_sample_record_vec_t{};
+    _data.reserve(_reservoir.size());
+    for(const auto& itr : _reservoir.get_entries())
+        _data.emplace_back(itr.second);
+
+    std::sort(_data.begin(), _data.end(), [](const auto& lhs, const auto& rhs) {
+        return (lhs.pc_sample_record.timestamp < rhs.pc_sample_record.timestamp);
+    });
+
+    return _data;
+}
+
+std::string_view
+get_aggregate_name(const metadata& tool_metadata, const aggregate_key& key)
+{
+    const auto _kind = static_cast<rocprofiler_buffer_tracing_kind_t>(key.kind);
+    const auto _op   = static_cast<rocprofiler_tracing_operation_t>(key.operation);
+
+    if(key.domain == domain_type::KERNEL_DISPATCH)
+        return tool_metadata.get_kernel_name(key.operation, key.name_id);
+
+    if(key.domain == domain_type::MARKER && key.name_id > 0)
+    {
+        if(const auto* _name = common::get_string_entry(key.name_id)) return *_name;
+    }
+
+    return tool_metadata.get_operation_name(_kind, _op);
+}
+}  // namespace tool
+}  // namespace rocprofiler
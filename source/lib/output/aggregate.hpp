@@ -0,0 +1,169 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "domain_type.hpp"
+#include "metadata.hpp"
+#include "output_config.hpp"
+#include "pc_sample_transform.hpp"
+#include "statistics.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// identifies the calls which are aggregated together
+struct aggregate_key
+{
+    domain_type domain    = domain_type::LAST;
+    int32_t     kind      = 0;  // buffer tracing kind
+    uint64_t    operation = 0;  // operation id or kernel id
+    uint64_t    agent     = 0;  // agent handle or zero for host APIs
+    uint64_t    name_id   = 0;  // string entry for a renamed kernel or roctx message (if any)
+
+    friend bool operator==(const aggregate_key& lhs, const aggregate_key& rhs)
+    {
+        return (lhs.domain == rhs.domain && lhs.kind == rhs.kind &&
+                lhs.operation == rhs.operation && lhs.agent == rhs.agent &&
+                lhs.name_id == rhs.name_id);
+    }
+};
+
+struct aggregate_key_hash
+{
+    size_t operator()(const aggregate_key& val) const;
+};
+
+struct aggregate_value
+{
+    void add(uint64_t duration, uint64_t weight = 1);
+
+    aggregate_value& operator+=(const aggregate_value&);
+
+    stats_data_t stats = {};
+};
+
+using aggregate_map_t = std::unordered_map<aggregate_key, aggregate_value, aggregate_key_hash>;
+
+/// summary of the host-trap PC samples of an instruction
+struct pc_sample_aggregate_value
+{
+    void add(const rocprofiler_tool_pc_sampling_host_trap_record_t&);
+
+    pc_sample_aggregate_value& operator+=(const pc_sample_aggregate_value&);
+
+    int64_t      inst_index      = -1;
+    uint64_t     first_timestamp = 0;
+    uint64_t     last_timestamp  = 0;
+    stats_data_t active_lanes    = {};  // population count of the exec mask of each sample
+};
+
+using pc_sample_aggregate_map_t = std::unordered_map<inst_t, pc_sample_aggregate_value, inst_hash>;
+using pc_sample_aggregate_vec_t = std::vector<std::pair<inst_t, const pc_sample_aggregate_value*>>;
+using pc_sample_record_vec_t    = std::vector<rocprofiler_tool_pc_sampling_host_trap_record_t>;
+
+/// accumulates the record into the table of the calling thread. The tables are only written by
+/// the thread which owns them so no locks are acquired after the first call on a thread. The
+/// dispatches of a kernel are only aggregated per rename (external correlation id) when kernel
+/// renaming is enabled.
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_kernel_dispatch_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_hip_api_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_hsa_api_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_memory_copy_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_memory_allocation_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_marker_api_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_scratch_memory_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_rccl_api_record_t&);
+
+void
+aggregate(const output_config&,
+          const metadata&,
+          const rocprofiler_buffer_tracing_rocdecode_api_record_t&);
+
+/// accumulates the PC sample into the per-instruction table of the calling thread. When
+/// `reservoir_size` is non-zero, a uniform random sample of (at most) that many raw samples is
+/// also retained.
+void
+aggregate(const rocprofiler_tool_pc_sampling_host_trap_record_t&, size_t reservoir_size);
+
+/// merges the tables of every thread. Must only be called once every thread has stopped
+/// producing records, e.g. after the buffers have been flushed and the context stopped.
+aggregate_map_t
+get_aggregates();
+
+pc_sample_aggregate_map_t
+get_pc_sample_aggregates();
+
+/// entries of the table in output order: most sampled instructions first, ties are ordered by
+/// address for deterministic output
+pc_sample_aggregate_vec_t
+sort_pc_sample_aggregates(const pc_sample_aggregate_map_t&);
+
+/// uniform random sample of the raw PC samples of every thread, ordered by timestamp
+pc_sample_record_vec_t
+get_pc_sample_reservoir(size_t reservoir_size);
+
+/// name of the aggregated calls in the statistics
+std::string_view
+get_aggregate_name(const metadata&, const aggregate_key&);
+}  // namespace tool
+}  // namespace rocprofiler
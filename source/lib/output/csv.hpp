@@ -109,8 +109,11 @@ using marker_csv_encoder                = csv_encoder<7>;
 using list_basic_metrics_csv_encoder    = csv_encoder<5>;
 using list_derived_metrics_csv_encoder  = csv_encoder<5>;
 using scratch_memory_encoder            = csv_encoder<8>;
-using stats_csv_encoder                 = csv_encoder<8>;
+using stats_csv_encoder                 = csv_encoder<12>;
 using pc_sampling_host_trap_csv_encoder = csv_encoder<6>;
+using histogram_csv_encoder             = csv_encoder<6>;
+using pc_sampling_aggregate_csv_encoder = csv_encoder<10>;
+using kernel_counter_csv_encoder        = csv_encoder<6>;
 }  // namespace csv
 }  // namespace tool
 }  // namespace rocprofiler
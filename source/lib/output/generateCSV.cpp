@@ -36,10 +36,15 @@
 #include <rocprofiler-sdk/cxx/utility.hpp>
 
 #include <unistd.h>
+#include <algorithm>
 #include <cstdint>
 #include <iomanip>
+#include <map>
+#include <string>
 #include <string_view>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 namespace rocprofiler
 {
@@ -62,6 +67,10 @@ get_stats_output_file(const output_config& cfg, std::string_view name)
                                      "MinNs",
                                      "MaxNs",
                                      "StdDev",
+                                     "P50Ns",
+                                     "P90Ns",
+                                     "P99Ns",
+                                     "P999Ns",
                                  }};
 }
 
@@ -74,6 +83,8 @@ get_stats_output_file(const output_config& cfg, domain_type domain)
 void
 write_stats(tool::csv_output_file&& ofs, const stats_entry_vec_t& data_v)
 {
+    using csv_encoder_t = rocprofiler::tool::csv::stats_csv_encoder;
+
     auto data      = stats_entry_vec_t{};
     auto _duration = stats_data_t{};
     for(const auto& [id, value] : data_v)
@@ -97,15 +108,19 @@ write_stats(tool::csv_output_file&& ofs, const stats_entry_vec_t& data_v)
         float_type percent_v   = (duration_ns / _total_duration) * one_hundred;
 
         auto _row = std::stringstream{};
-        rocprofiler::tool::csv::stats_csv_encoder::write_row<stats_formatter>(_row,
-                                                                              name,
-                                                                              calls,
-                                                                              duration_ns,
-                                                                              avg_ns,
-                                                                              percentage{percent_v},
-                                                                              value.get_min(),
-                                                                              value.get_max(),
-                                                                              value.get_stddev());
+        csv_encoder_t::write_row<stats_formatter>(_row,
+                                                  name,
+                                                  calls,
+                                                  duration_ns,
+                                                  avg_ns,
+                                                  percentage{percent_v},
+                                                  value.get_min(),
+                                                  value.get_max(),
+                                                  value.get_stddev(),
+                                                  value.get_quantile(0.5),
+                                                  value.get_quantile(0.9),
+                                                  value.get_quantile(0.99),
+                                                  value.get_quantile(0.999));
         ofs << _row.str() << std::flush;
     }
 }
@@ -583,6 +598,18 @@ generate_csv(const output_config&                    cfg,
     for(const auto& itr : tool_metadata.get_counter_info())
         counter_id_to_name.emplace(itr.id, itr.name);
 
+    // Per-kernel totals of the counters. Counter profiles split into passes collect a different
+    // subset of the counters on successive dispatches of a kernel, these are merged per kernel.
+    struct kernel_counter_totals
+    {
+        std::string_view                                              kernel_name = {};
+        std::vector<rocprofiler_counter_id_t>                         counters    = {};
+        std::map<rocprofiler_counter_id_t, std::pair<double, size_t>> values      = {};
+    };
+
+    auto kernel_totals = std::map<std::pair<uint64_t, uint64_t>, kernel_counter_totals>{};
+    auto multipass     = false;
+
     for(auto ditr : data)
     {
         for(auto record : data.get(ditr))
@@ -628,7 +655,61 @@ generate_csv(const output_config&                    cfg,
                     record.dispatch_data.end_timestamp);
             }
             ofs << row_ss.str();
+
+            auto agent_id = tool_metadata.get_node_id(record.dispatch_data.dispatch_info.agent_id);
+
+            auto [titr, inserted] = kernel_totals.try_emplace({agent_id, kernel_id});
+            auto& totals          = titr->second;
+            auto  counters        = std::vector<rocprofiler_counter_id_t>{};
+            for(auto& [counter_id, counter_value] : counter_id_value)
+            {
+                auto& [sum, count] = totals.values[counter_id];
+                sum += counter_value;
+                ++count;
+                counters.emplace_back(counter_id);
+            }
+
+            if(inserted)
+            {
+                totals.kernel_name =
+                    tool_metadata.get_kernel_name(kernel_id, correlation_id.external.value);
+                totals.counters = std::move(counters);
+            }
+            else if(totals.counters != counters)
+            {
+                multipass = true;
+            }
+        }
+    }
+
+    // Only written when the dispatches of a kernel did not all collect the same counters
+    if(!multipass) return;
+
+    auto kernel_ofs = tool::csv_output_file{cfg,
+                                            "counter_collection_kernel_summary",
+                                            tool::csv::kernel_counter_csv_encoder{},
+                                            {"Agent_Id",
+                                             "Kernel_Id",
+                                             "Kernel_Name",
+                                             "Counter_Name",
+                                             "Counter_Value_Mean",
+                                             "Dispatch_Count"}};
+
+    for(const auto& [key, totals] : kernel_totals)
+    {
+        auto row_ss = std::stringstream{};
+        for(const auto& [counter_id, value] : totals.values)
+        {
+            tool::csv::kernel_counter_csv_encoder::write_row(
+                row_ss,
+                key.first,
+                key.second,
+                totals.kernel_name,
+                counter_id_to_name.at(counter_id),
+                value.first / static_cast<double>(value.second),
+                value.second);
         }
+        kernel_ofs << row_ss.str();
     }
 }
 
@@ -823,6 +904,106 @@ generate_csv(const output_config&                                              c
     }
 }
 
+void
+generate_csv(const output_config& cfg, domain_type domain, const stats_entry_t& stats)
+{
+    if(cfg.stats && stats) write_stats(get_stats_output_file(cfg, domain), stats.entries);
+}
+
+void
+generate_csv(const output_config&   cfg,
+             const metadata&        tool_metadata,
+             const aggregate_map_t& data)
+{
+    if(data.empty()) return;
+
+    // sort by domain and name so the output is deterministic
+    using entry_t = std::tuple<domain_type, std::string_view, uint64_t, const aggregate_value*>;
+    auto _entries = std::vector<entry_t>{};
+    _entries.reserve(data.size());
+    for(const auto& [key, value] : data)
+        _entries.emplace_back(
+            key.domain, get_aggregate_name(tool_metadata, key), key.agent, &value);
+    std::sort(_entries.begin(), _entries.end());
+
+    auto ofs = tool::csv_output_file{cfg,
+                                     "aggregate_histograms",
+                                     tool::csv::histogram_csv_encoder{},
+                                     {"Domain",
+                                      "Name",
+                                      "Agent_Id",
+                                      "Bucket_Lower_Bound_Ns",
+                                      "Bucket_Upper_Bound_Ns",
+                                      "Count"}};
+
+    for(const auto& [domain, name, agent, value] : _entries)
+    {
+        auto _agent_id = (agent > 0) ? std::to_string(tool_metadata.get_node_id(
+                                           rocprofiler_agent_id_t{.handle = agent}))
+                                     : std::string{};
+
+        value->stats.get_histogram().for_each_bucket(
+            [&](uint64_t _lower, uint64_t _upper, uint64_t _count) {
+                auto _row = std::stringstream{};
+                tool::csv::histogram_csv_encoder::write_row(_row,
+                                                            get_domain_column_name(domain),
+                                                            name,
+                                                            _agent_id,
+                                                            _lower,
+                                                            _upper,
+                                                            _count);
+                ofs << _row.str();
+            });
+    }
+}
+
+void
+generate_csv(const output_config&             cfg,
+             const metadata&                  tool_metadata,
+             const pc_sample_aggregate_map_t& data)
+{
+    if(data.empty()) return;
+
+    auto ofs = tool::csv_output_file{cfg,
+                                     "pc_sampling_host_trap_aggregate",
+                                     tool::csv::pc_sampling_aggregate_csv_encoder{},
+                                     {"Code_Object_Id",
+                                      "Code_Object_Offset",
+                                      "Instruction",
+                                      "Instruction_Comment",
+                                      "Sample_Count",
+                                      "Active_Lanes_Min",
+                                      "Active_Lanes_Mean",
+                                      "Active_Lanes_Max",
+                                      "First_Sample_Timestamp",
+                                      "Last_Sample_Timestamp"}};
+
+    for(const auto& [inst, value] : sort_pc_sample_aggregates(data))
+    {
+        auto _inst    = std::string_view{};
+        auto _comment = std::string_view{};
+        if(value->inst_index >= 0)
+        {
+            _inst    = tool_metadata.get_instruction(value->inst_index);
+            _comment = tool_metadata.get_comment(value->inst_index);
+        }
+
+        auto _row = std::stringstream{};
+        tool::csv::pc_sampling_aggregate_csv_encoder::write_row(_row,
+                                                                inst.code_object_id,
+                                                                inst.code_object_offset,
+                                                                _inst,
+                                                                _comment,
+                                                                value->active_lanes.get_count(),
+                                                                value->active_lanes.get_min(),
+                                                                value->active_lanes.get_mean(),
+                                                                value->active_lanes.get_max(),
+                                                                value->first_timestamp,
+                                                                value->last_timestamp);
+        ofs << _row.str();
+    }
+}
+
 void
 generate_csv(const output_config& cfg,
              const metadata& /*tool_metadata*/,
@@ -863,7 +1044,11 @@ generate_csv(const output_config& cfg,
                                                   percentage{percent_v},
                                                   value.total.get_min(),
                                                   value.total.get_max(),
-                                                  value.total.get_stddev());
+                                                  value.total.get_stddev(),
+                                                  value.total.get_quantile(0.5),
+                                                  value.total.get_quantile(0.9),
+                                                  value.total.get_quantile(0.99),
+                                                  value.total.get_quantile(0.999));
         ofs << _row.str() << std::flush;
     }
 }
@@ -104,6 +104,22 @@ generate_csv(const output_config&                                              c
              const generator<rocprofiler_tool_pc_sampling_host_trap_record_t>& data,
              const stats_entry_t&                                              stats);
 
+// statistics of a domain without any trace records (aggregation mode)
+void
+generate_csv(const output_config& cfg, domain_type domain, const stats_entry_t& stats);
+
+// latency histograms of every aggregate (aggregation mode)
+void
+generate_csv(const output_config&   cfg,
+             const metadata&        tool_metadata,
+             const aggregate_map_t& data);
+
+// per-instruction summary of the PC samples (aggregation mode)
+void
+generate_csv(const output_config&             cfg,
+             const metadata&                  tool_metadata,
+             const pc_sample_aggregate_map_t& data);
+
 void
 generate_csv(const output_config&      cfg,
              const metadata&           tool_metadata,
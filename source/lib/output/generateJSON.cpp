@@ -241,5 +241,34 @@ write_json(json_output& json_ar,
         json_ar.finishNode();
     }
 }
+
+void
+write_json(json_output& json_ar,
+           const output_config& /*cfg*/,
+           const metadata& /*tool_metadata*/,
+           const pc_sample_aggregate_map_t& data)
+{
+    if(data.empty()) return;
+
+    // the instructions are referenced by their index in strings.pc_sample_instructions
+    json_ar.setNextName("pc_sample_host_trap_aggregate");
+    json_ar.startNode();
+    json_ar.makeArray();
+    for(const auto& [inst, value] : sort_pc_sample_aggregates(data))
+    {
+        json_ar.startNode();
+        json_ar(cereal::make_nvp("code_object_id", inst.code_object_id));
+        json_ar(cereal::make_nvp("code_object_offset", inst.code_object_offset));
+        json_ar(cereal::make_nvp("inst_index", value->inst_index));
+        json_ar(cereal::make_nvp("sample_count", value->active_lanes.get_count()));
+        json_ar(cereal::make_nvp("active_lanes_min", value->active_lanes.get_min()));
+        json_ar(cereal::make_nvp("active_lanes_mean", value->active_lanes.get_mean()));
+        json_ar(cereal::make_nvp("active_lanes_max", value->active_lanes.get_max()));
+        json_ar(cereal::make_nvp("first_sample_timestamp", value->first_timestamp));
+        json_ar(cereal::make_nvp("last_sample_timestamp", value->last_timestamp));
+        json_ar.finishNode();
+    }
+    json_ar.finishNode();
+}
 }  // namespace tool
 }  // namespace rocprofiler
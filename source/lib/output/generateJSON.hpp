@@ -23,6 +23,7 @@
 #pragma once
 
 #include "agent_info.hpp"
+#include "aggregate.hpp"
 #include "buffered_output.hpp"
 #include "metadata.hpp"
 #include "output_config.hpp"
@@ -97,5 +98,12 @@ write_json(json_output&                                                     json
            generator<rocprofiler_tool_pc_sampling_host_trap_record_t>       pc_sampling_gen,
            generator<rocprofiler_buffer_tracing_rocdecode_api_record_t>     rocdecode_api_gen);
 
+// per-instruction summary of the PC samples (aggregation mode)
+void
+write_json(json_output&                     json_ar,
+           const output_config&             cfg,
+           const metadata&                  tool_metadata,
+           const pc_sample_aggregate_map_t& data);
+
 }  // namespace tool
 }  // namespace rocprofiler
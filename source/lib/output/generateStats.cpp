@@ -92,7 +92,8 @@ generate_stats(const output_config& /*cfg*/,
         for(auto record : data.get(ditr))
         {
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
-            hip_stats[api_name] += (record.end_timestamp - record.start_timestamp);
+            hip_stats[api_name].add(record.end_timestamp - record.start_timestamp,
+                                    static_cast<int64_t>(record.sampling_weight));
         }
     }
 
@@ -110,7 +111,8 @@ generate_stats(const output_config& /*cfg*/,
         for(auto record : data.get(ditr))
         {
             auto api_name = tool_metadata.get_operation_name(record.kind, record.operation);
-            hsa_stats[api_name] += (record.end_timestamp - record.start_timestamp);
+            hsa_stats[api_name].add(record.end_timestamp - record.start_timestamp,
+                                    static_cast<int64_t>(record.sampling_weight));
         }
     }
 
@@ -246,6 +248,24 @@ generate_stats(const output_config& /*cfg*/,
     return get_stats(rocdecode_stats);
 }
 
+stats_entry_t
+generate_stats(const output_config& /*cfg*/,
+               const metadata&        tool_metadata,
+               domain_type            domain,
+               const aggregate_map_t& data)
+{
+    auto aggregate_stats = stats_map_t{};
+    for(const auto& [key, value] : data)
+    {
+        if(key.domain != domain) continue;
+
+        // aggregates of the same operation on different agents are combined
+        aggregate_stats[get_aggregate_name(tool_metadata, key)] += value.stats;
+    }
+
+    return get_stats(aggregate_stats);
+}
+
 namespace
 {
 void
@@ -296,7 +316,8 @@ generate_stats(const output_config&      cfg,
 
     {
         auto _header = fmt::format(
-            "| {:^{}} | {:^{}} | {:^15} | {:^15} | {:^15} | {:^13} | {:^15} | {:^15} | {:^15} |",
+            "| {:^{}} | {:^{}} | {:^15} | {:^15} | {:^15} | {:^13} | {:^15} | {:^15} | {:^15} | "
+            "{:^15} | {:^15} | {:^15} | {:^15} |",
             "NAME",
             name_width,
             "DOMAIN",
@@ -307,12 +328,17 @@ generate_stats(const output_config&      cfg,
             "PERCENT (INC)",
             fmt::format("MIN ({})", cfg.stats_summary_unit),
             fmt::format("MAX ({})", cfg.stats_summary_unit),
-            "STDDEV");
+            "STDDEV",
+            fmt::format("P50 ({})", cfg.stats_summary_unit),
+            fmt::format("P90 ({})", cfg.stats_summary_unit),
+            fmt::format("P99 ({})", cfg.stats_summary_unit),
+            fmt::format("P99.9 ({})", cfg.stats_summary_unit));
         (*os.stream) << indent_v << _header << "\n" << std::flush;
 
         auto _div =
             fmt::format("|-{0:-^{1}}-|-{0:-^{2}}-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|-{0:-^13}"
-                        "-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|",
+                        "-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|-{0:-^15}-|"
+                        "-{0:-^15}-|",
                         "",
                         name_width,
                         domain_width);
@@ -334,7 +360,7 @@ generate_stats(const output_config&      cfg,
         {
             auto _unit_div = static_cast<double>(cfg.stats_summary_unit_value);
             _row = fmt::format("{}| {:<{}} | {:<{}} | {:15} | {:15} | {:15.3e} | {:>13} | {:15} | "
-                               "{:15} | {:15.3e} |",
+                               "{:15} | {:15.3e} | {:15} | {:15} | {:15} | {:15} |",
                                indent_v,
                                name,
                                name_width,
@@ -346,12 +372,16 @@ generate_stats(const output_config&      cfg,
                                percent,
                                value.get_min() / _unit_div,
                                value.get_max() / _unit_div,
-                               value.get_stddev() / _unit_div);
+                               value.get_stddev() / _unit_div,
+                               value.get_quantile(0.5) / _unit_div,
+                               value.get_quantile(0.9) / _unit_div,
+                               value.get_quantile(0.99) / _unit_div,
+                               value.get_quantile(0.999) / _unit_div);
         }
         else
         {
             _row = fmt::format("{}| {:<{}} | {:<{}} | {:15} | {:15} | {:15.3e} | {:>13} | {:15} | "
-                               "{:15} | {:15.3e} |",
+                               "{:15} | {:15.3e} | {:15} | {:15} | {:15} | {:15} |",
                                indent_v,
                                name,
                                name_width,
@@ -363,7 +393,11 @@ generate_stats(const output_config&      cfg,
                                percent,
                                value.get_min(),
                                value.get_max(),
-                               value.get_stddev());
+                               value.get_stddev(),
+                               value.get_quantile(0.5),
+                               value.get_quantile(0.9),
+                               value.get_quantile(0.99),
+                               value.get_quantile(0.999));
         }
 
         (*os.stream) << _row << "\n" << std::flush;
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "aggregate.hpp"
 #include "generator.hpp"
 #include "metadata.hpp"
 #include "statistics.hpp"
@@ -84,6 +85,13 @@ stats_entry_t
 generate_stats(const output_config&                                              cfg,
                const metadata&                                                   tool_metadata,
                const generator<rocprofiler_tool_pc_sampling_host_trap_record_t>& data);
+
+stats_entry_t
+generate_stats(const output_config&   cfg,
+               const metadata&        tool_metadata,
+               domain_type            domain,
+               const aggregate_map_t& data);
+
 void
 generate_stats(const output_config&      cfg,
                const metadata&           tool_metadata,
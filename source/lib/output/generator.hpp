@@ -29,9 +29,13 @@
 
 #include <fmt/format.h>
 
+#include <cstdint>
+#include <cstring>
 #include <iosfwd>
+#include <memory>
 #include <mutex>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 namespace rocprofiler
@@ -73,6 +77,47 @@ get_buffer_elements(common::container::ring_buffer<Tp>&& buf)
     return ret;
 }
 
+/// read-only view of the records in one chunk of a tmp file. Records of memory-mapped chunks
+/// are read in-place (and are only valid while the generator exists), otherwise the records
+/// are owned by the span
+template <typename Tp>
+struct record_span
+{
+    using value_type     = Tp;
+    using const_iterator = const Tp*;
+
+    record_span() = default;
+    record_span(const Tp* _data, size_t _size)
+    : m_data{_data}
+    , m_size{_size}
+    {}
+
+    explicit record_span(std::vector<Tp>&& _data)
+    : m_owned{std::move(_data)}
+    , m_data{m_owned.data()}
+    , m_size{m_owned.size()}
+    {}
+
+    ~record_span()                      = default;
+    record_span(const record_span&)     = delete;
+    record_span(record_span&&) noexcept = default;
+    record_span& operator=(const record_span&) = delete;
+    record_span& operator=(record_span&&) noexcept = default;
+
+    const Tp* begin() const { return m_data; }
+    const Tp* end() const { return m_data + m_size; }
+    const Tp* data() const { return m_data; }
+    size_t    size() const { return m_size; }
+    bool      empty() const { return (m_size == 0); }
+
+    const Tp& operator[](size_t idx) const { return m_data[idx]; }
+
+private:
+    std::vector<Tp> m_owned = {};
+    const Tp*       m_data  = nullptr;
+    size_t          m_size  = 0;
+};
+
 template <typename Tp, domain_type DomainT>
 struct buffered_output;
 
@@ -101,37 +146,87 @@ struct generator
     auto size() const { return file_pos.size(); }
     auto empty() const { return file_pos.empty(); }
 
-    std::vector<Tp> get(std::streampos itr) const;
+    record_span<Tp> get(std::streampos itr) const;
 
 private:
     generator(file_buffer<Tp>* fbuf);
 
-    file_buffer<Tp>*            filebuf = nullptr;
-    std::lock_guard<std::mutex> lk_guard;
-    std::set<std::streampos>    file_pos = {};
+    record_span<Tp> get_mapped(std::streampos itr) const;
+
+    file_buffer<Tp>*               filebuf  = nullptr;
+    std::set<std::streampos>       file_pos = {};
+    std::unique_ptr<tmp_file_view> view     = {};
 };
 
+/// the file mutex is only held while the generator is constructed and while a chunk is reloaded
+/// from the file stream so that several generators of the same tmp file can be used concurrently
 template <typename Tp>
 generator<Tp>::generator(file_buffer<Tp>* fbuf)
 : filebuf{fbuf}
-, lk_guard{filebuf->file.file_mutex}
-, file_pos{filebuf->file.file_pos}
-{}
+{
+    auto _lk = std::lock_guard<std::mutex>{filebuf->file.file_mutex};
+    file_pos = filebuf->file.file_pos;
+
+    // records can only be read in-place if their bytes are valid outside of the process that
+    // wrote them
+    if constexpr(std::is_trivially_copyable<Tp>::value)
+    {
+        if(!file_pos.empty())
+        {
+            filebuf->file.flush();
+            view = std::make_unique<tmp_file_view>(filebuf->file.filename);
+        }
+    }
+}
 
 template <typename Tp>
-std::vector<Tp>
+record_span<Tp>
 generator<Tp>::get(std::streampos itr) const
 {
-    auto  _data = std::vector<Tp>{};
-    auto& _fs   = filebuf->file.stream;
+    if(view && *view)
+    {
+        auto _data = get_mapped(itr);
+        if(_data.data() != nullptr) return _data;
+    }
+
+    // fall back to reloading the ring buffer from the file stream
+    auto  _lk = std::lock_guard<std::mutex>{filebuf->file.file_mutex};
+    auto& _fs = filebuf->file.stream;
     _fs.seekg(itr);  // set to the absolute position
     if(!_fs.eof())
     {
         auto _buffer = ring_buffer_t<Tp>{};
         _buffer.load(_fs);
-        _data = get_buffer_elements(std::move(_buffer));
+        return record_span<Tp>{get_buffer_elements(std::move(_buffer))};
     }
-    return _data;
+    return record_span<Tp>{};
+}
+
+/// the chunk at @p itr is the header + raw contents written by ring_buffer::save. Records are
+/// requested without wrapping so they are contiguous starting from the read count. Returns an
+/// empty span with a null data pointer if the chunk cannot be read in-place.
+template <typename Tp>
+record_span<Tp>
+generator<Tp>::get_mapped(std::streampos itr) const
+{
+    using header_t = typename ring_buffer_t<Tp>::save_header;
+
+    auto _offset = static_cast<size_t>(static_cast<std::streamoff>(itr));
+    if(_offset + sizeof(header_t) > view->size()) return record_span<Tp>{};
+
+    auto _header = header_t{};
+    std::memcpy(&_header, view->data() + _offset, sizeof(header_t));
+
+    const auto* _contents = view->data() + _offset + sizeof(header_t);
+    const auto* _records  = _contents + _header.read_count;
+    auto        _nbytes   = _header.write_count - _header.read_count;
+
+    if(_header.write_count < _header.read_count || _header.write_count > _header.size ||
+       _offset + sizeof(header_t) + _header.size > view->size() || _nbytes % sizeof(Tp) != 0 ||
+       reinterpret_cast<uintptr_t>(_records) % alignof(Tp) != 0)
+        return record_span<Tp>{};
+
+    return record_span<Tp>{reinterpret_cast<const Tp*>(_records), _nbytes / sizeof(Tp)};
 }
 }  // namespace tool
 }  // namespace rocprofiler
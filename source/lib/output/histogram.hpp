@@ -0,0 +1,163 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// \struct log_linear_histogram
+/// \brief A mergeable quantile sketch with a bounded relative error. Values are binned by their
+/// power of two and each power of two is split into `sub_bucket_count` linear sub-buckets (values
+/// less than `sub_bucket_count` are binned exactly), i.e. the width of a bucket is at most 1/32 of
+/// its lower bound. Only the buckets between the smallest and largest value added are allocated
+/// so the memory usage is bounded by the dynamic range of the values, not the number of values.
+///
+struct log_linear_histogram
+{
+    static constexpr uint64_t sub_bucket_bits  = 5;
+    static constexpr uint64_t sub_bucket_count = (uint64_t{1} << sub_bucket_bits);
+
+    // bucket containing the value
+    static size_t get_index(uint64_t val)
+    {
+        if(val < sub_bucket_count) return val;
+
+        const auto _exp  = static_cast<uint64_t>(63 - __builtin_clzll(val));
+        const auto _mant = (val >> (_exp - sub_bucket_bits)) - sub_bucket_count;
+        return ((_exp - sub_bucket_bits + 1) * sub_bucket_count) + _mant;
+    }
+
+    // smallest value in the bucket
+    static uint64_t get_lower_bound(size_t idx)
+    {
+        if(idx < sub_bucket_count) return idx;
+
+        const auto _group = (idx / sub_bucket_count);
+        const auto _mant  = (idx % sub_bucket_count);
+        return (sub_bucket_count + _mant) << (_group - 1);
+    }
+
+    // largest value in the bucket
+    static uint64_t get_upper_bound(size_t idx)
+    {
+        if(idx < sub_bucket_count) return idx;
+
+        const auto _group = (idx / sub_bucket_count);
+        return get_lower_bound(idx) + ((uint64_t{1} << (_group - 1)) - 1);
+    }
+
+    void add(uint64_t val, uint64_t weight = 1)
+    {
+        const auto _idx = get_index(val);
+        reserve(_idx, _idx + 1);
+        m_buckets[_idx - m_offset] += weight;
+        m_count += weight;
+    }
+
+    log_linear_histogram& operator+=(const log_linear_histogram& rhs)
+    {
+        if(rhs.m_buckets.empty()) return *this;
+
+        reserve(rhs.m_offset, rhs.m_offset + rhs.m_buckets.size());
+        for(size_t i = 0; i < rhs.m_buckets.size(); ++i)
+            m_buckets[rhs.m_offset + i - m_offset] += rhs.m_buckets[i];
+        m_count += rhs.m_count;
+        return *this;
+    }
+
+    void reset()
+    {
+        m_count  = 0;
+        m_offset = 0;
+        m_buckets.clear();
+    }
+
+    uint64_t get_count() const { return m_count; }
+
+    // invokes `func(lower_bound, upper_bound, count)` for each non-empty bucket in ascending order
+    template <typename FuncT>
+    void for_each_bucket(FuncT&& func) const
+    {
+        for(size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            if(m_buckets[i] == 0) continue;
+            func(get_lower_bound(m_offset + i), get_upper_bound(m_offset + i), m_buckets[i]);
+        }
+    }
+
+    // approximate value at the given quantile (0.0 - 1.0): the midpoint of the bucket containing
+    // the value of that rank
+    uint64_t get_quantile(double quantile) const
+    {
+        if(m_count == 0) return 0;
+
+        const auto _quantile = std::clamp(quantile, 0.0, 1.0);
+        const auto _rank     = std::max<uint64_t>(
+            static_cast<uint64_t>(std::ceil(_quantile * static_cast<double>(m_count))), 1);
+
+        uint64_t _sum = 0;
+        for(size_t i = 0; i < m_buckets.size(); ++i)
+        {
+            _sum += m_buckets[i];
+            if(_sum >= _rank)
+            {
+                const auto _lower = get_lower_bound(m_offset + i);
+                return _lower + ((get_upper_bound(m_offset + i) - _lower) / 2);
+            }
+        }
+        return get_upper_bound(m_offset + m_buckets.size() - 1);
+    }
+
+private:
+    // grows the allocated buckets to include the bucket indexes [beg, end)
+    void reserve(size_t beg, size_t end)
+    {
+        if(m_buckets.empty())
+        {
+            m_offset = beg;
+            m_buckets.resize(end - beg, 0);
+            return;
+        }
+
+        if(beg < m_offset)
+        {
+            m_buckets.insert(m_buckets.begin(), m_offset - beg, 0);
+            m_offset = beg;
+        }
+
+        if(end > m_offset + m_buckets.size()) m_buckets.resize(end - m_offset, 0);
+    }
+
+    uint64_t              m_count   = 0;
+    size_t                m_offset  = 0;
+    std::vector<uint64_t> m_buckets = {};
+};
+}  // namespace tool
+}  // namespace rocprofiler
@@ -32,7 +32,11 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/cxx/details/tokenize.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 namespace rocprofiler
@@ -546,17 +550,94 @@ metadata::get_string_entry(size_t key) const
 int64_t
 metadata::get_instruction_index(rocprofiler_pc_t record)
 {
-    inst_t ins;
-    ins.code_object_id     = record.code_object_id;
-    ins.code_object_offset = record.code_object_offset;
-    auto itr               = indexes.find(ins);
-    if(itr != indexes.end()) return itr->second;
-    auto idx            = instruction_decoder.size();
-    auto pc_instruction = decode_instruction(record);
-    instruction_decoder.emplace_back(pc_instruction->inst);
-    instruction_comment.emplace_back(pc_instruction->comment);
-    indexes.emplace(ins, idx);
-    return idx;
+    auto ins = inst_t{record.code_object_id, record.code_object_offset};
+
+    // the PCs of a kernel are sampled repeatedly so nearly every call is a hit
+    auto idx = instruction_indexes.rlock(
+        [](const auto& _data, const inst_t& _ins) -> int64_t {
+            auto itr = _data.indexes.find(_ins);
+            return (itr != _data.indexes.end()) ? static_cast<int64_t>(itr->second) : -1;
+        },
+        ins);
+    if(idx >= 0) return idx;
+
+    // the instruction is decoded by decode_instructions() during finalization
+    return instruction_indexes.wlock(
+        [](auto& _data, const inst_t& _ins) {
+            auto itr = _data.indexes.emplace(_ins, _data.pcs.size());
+            if(itr.second) _data.pcs.emplace_back(_ins);
+            return static_cast<int64_t>(itr.first->second);
+        },
+        ins);
+}
+
+void
+metadata::decode_instructions()
+{
+    auto pcs = instruction_indexes.rlock([](const auto& _data) { return _data.pcs; });
+    if(pcs.size() == instruction_decoder.size()) return;
+
+    instruction_decoder.resize(pcs.size());
+    instruction_comment.resize(pcs.size());
+
+    auto groups = std::unordered_map<uint64_t, std::vector<size_t>>{};
+
+    decoder.wlock([&](auto& _decoder) {
+        // the disassembler of a code object is not thread-safe so the PCs are grouped by code
+        // object and the groups are decoded in parallel. PCs without a code object id (virtual
+        // addresses) are grouped with the code object loaded at their address since they are
+        // decoded by its disassembler
+        for(size_t i = 0; i < pcs.size(); ++i)
+        {
+            const auto& _pc = pcs.at(i);
+            auto        _id = _pc.code_object_id;
+            if(_id == 0) _id = _decoder.find_codeobj_id(_pc.code_object_offset);
+            groups[_id].emplace_back(i);
+        }
+
+        auto group_vec = std::vector<const std::vector<size_t>*>{};
+        group_vec.reserve(groups.size());
+        for(const auto& itr : groups)
+            group_vec.emplace_back(&itr.second);
+
+        auto _next   = std::atomic<size_t>{0};
+        auto _decode = [&]() {
+            for(auto g = _next++; g < group_vec.size(); g = _next++)
+            {
+                for(auto idx : *group_vec.at(g))
+                {
+                    const auto& _pc  = pcs.at(idx);
+                    auto        _ins = std::unique_ptr<instruction_t>{};
+                    try
+                    {
+                        _ins = _decoder.get(_pc.code_object_id, _pc.code_object_offset);
+                    } catch(std::exception& e)
+                    {
+                        ROCP_WARNING << "failed to decode the instruction at offset "
+                                     << _pc.code_object_offset << " of code object "
+                                     << _pc.code_object_id << ": " << e.what();
+                    }
+                    if(!_ins) continue;
+                    instruction_decoder.at(idx) = std::move(_ins->inst);
+                    instruction_comment.at(idx) = std::move(_ins->comment);
+                }
+            }
+        };
+
+        auto _nthreads = std::min<size_t>(
+            group_vec.size(), std::max<size_t>(std::thread::hardware_concurrency(), 1));
+        auto _threads = std::vector<std::thread>{};
+        for(size_t i = 1; i < _nthreads; ++i)
+            _threads.emplace_back(_decode);
+        _decode();
+        for(auto& itr : _threads)
+            itr.join();
+
+        _decoder.flush_cache();
+    });
+
+    ROCP_INFO << "decoded " << pcs.size() << " unique PC sample instructions from "
+              << groups.size() << " code objects";
 }
 
 void
@@ -590,14 +671,5 @@ metadata::add_decoder(rocprofiler_code_object_info_t* obj_data)
     }
 }
 
-std::unique_ptr<instruction_t>
-metadata::decode_instruction(rocprofiler_pc_t pc)
-{
-    return decoder.wlock(
-        [](auto& _decoder, uint64_t id, uint64_t addr) { return _decoder.get(id, addr); },
-        pc.code_object_id,
-        pc.code_object_offset);
-}
-
 }  // namespace tool
 }  // namespace rocprofiler
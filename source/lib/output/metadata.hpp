@@ -141,6 +141,7 @@ struct metadata
     std::string_view get_instruction(int64_t index) const { return instruction_decoder.at(index); }
     std::string_view get_comment(int64_t index) const { return instruction_comment.at(index); }
     int64_t          get_instruction_index(rocprofiler_pc_t record);
+    void             decode_instructions();
     void             add_decoder(rocprofiler_code_object_info_t* obj_data_v);
     code_object_load_info_vec_t get_code_object_load_info() const;
 
@@ -166,13 +167,19 @@ struct metadata
     const std::string* get_string_entry(size_t key) const;
 
 private:
-    bool                           inprocess_init = false;
-    std::unique_ptr<instruction_t> decode_instruction(rocprofiler_pc_t pc);
-    synced_map<code_obj_decoder_t> decoder = {};
-    // TODO: We may have to reserve the vector size based on map size
-    std::vector<std::string> instruction_decoder = {};
-    std::vector<std::string> instruction_comment = {};
-    std::map<inst_t, size_t> indexes             = {};
+    // unique sampled PCs in the order of their first sample, the index of a PC in `pcs` is the
+    // inst_index of its samples and of its entry in instruction_decoder/instruction_comment
+    struct instruction_index
+    {
+        std::unordered_map<inst_t, size_t, inst_hash> indexes = {};
+        std::vector<inst_t>                            pcs     = {};
+    };
+
+    bool                           inprocess_init      = false;
+    synced_map<code_obj_decoder_t> decoder             = {};
+    synced_map<instruction_index>  instruction_indexes = {};
+    std::vector<std::string>       instruction_decoder = {};
+    std::vector<std::string>       instruction_comment = {};
 };
 
 template <typename Tp>
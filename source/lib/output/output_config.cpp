@@ -51,6 +51,10 @@ output_config::parse_env()
     stats_summary_unit = common::get_env("ROCPROF_STATS_SUMMARY_UNITS", stats_summary_unit);
     stats_summary_file = common::get_env("ROCPROF_STATS_SUMMARY_OUTPUT", stats_summary_file);
 
+    // aggregation produces the statistics without any trace records
+    aggregate = common::get_env("ROCPROF_AGGREGATE", aggregate);
+    if(aggregate) stats = true;
+
     perfetto_backend = common::get_env("ROCPROF_PERFETTO_BACKEND", perfetto_backend);
     perfetto_buffer_fill_policy =
         common::get_env("ROCPROF_PERFETTO_BUFFER_FILL_POLICY", perfetto_buffer_fill_policy);
@@ -68,6 +68,7 @@ struct output_config
     bool                     otf2_output                 = false;
     bool                     summary_output              = false;
     bool                     kernel_rename               = false;
+    bool                     aggregate                   = false;
     uint64_t                 stats_summary_unit_value    = 1;
     size_t                   perfetto_shmem_size_hint    = defaults::perfetto_shmem_size_hint_kb;
     size_t                   perfetto_buffer_size        = defaults::perfetto_buffer_size_kb;
@@ -29,6 +29,9 @@
 #include "lib/common/static_object.hpp"
 #include "lib/common/synchronized.hpp"
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <unordered_map>
 
 using pc_sample_config_vec_t = std::vector<rocprofiler_pc_sampling_configuration_t>;
@@ -58,6 +61,16 @@ struct inst_t
     };
 };
 
+struct inst_hash
+{
+    size_t operator()(const inst_t& inst) const
+    {
+        // code object offsets of sampled PCs are dense so mix the id into the high bits
+        return std::hash<uint64_t>{}(inst.code_object_offset ^ (inst.code_object_id << 40) ^
+                                     (inst.code_object_id >> 24));
+    }
+};
+
 // TODO:: Check if we can template this structure
 struct rocprofiler_tool_pc_sampling_host_trap_record_t
 {
@@ -0,0 +1,93 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace tool
+{
+/// \struct bottom_k_sample
+/// \brief A uniform random sample of at most `capacity` values: each value is added with a
+/// uniform random priority and the values with the `capacity` smallest priorities are kept
+/// (bottom-k sampling). Since the priorities are independent of the order of the values, merging
+/// the samples of several threads keeps the `capacity` smallest priorities of all of them, which
+/// is a uniform random sample of the union.
+///
+template <typename Tp>
+struct bottom_k_sample
+{
+    using value_type = Tp;
+    using entry_type = std::pair<uint64_t, value_type>;  // priority and value
+
+    bottom_k_sample() = default;
+    explicit bottom_k_sample(size_t _capacity)
+    : m_capacity{_capacity}
+    {}
+
+    void add(uint64_t priority, value_type val)
+    {
+        if(m_entries.size() < m_capacity)
+        {
+            m_entries.emplace_back(priority, std::move(val));
+            std::push_heap(m_entries.begin(), m_entries.end(), compare);
+        }
+        else if(!m_entries.empty() && priority < m_entries.front().first)
+        {
+            std::pop_heap(m_entries.begin(), m_entries.end(), compare);
+            m_entries.back() = entry_type{priority, std::move(val)};
+            std::push_heap(m_entries.begin(), m_entries.end(), compare);
+        }
+    }
+
+    bottom_k_sample& operator+=(const bottom_k_sample& rhs)
+    {
+        for(const auto& itr : rhs.m_entries)
+            add(itr.first, itr.second);
+        return *this;
+    }
+
+    size_t size() const { return m_entries.size(); }
+    size_t capacity() const { return m_capacity; }
+    bool   empty() const { return m_entries.empty(); }
+
+    // the retained entries in no particular order
+    const std::vector<entry_type>& get_entries() const { return m_entries; }
+
+private:
+    // max-heap on the priority so the entry to replace is at the front
+    static bool compare(const entry_type& lhs, const entry_type& rhs)
+    {
+        return (lhs.first < rhs.first);
+    }
+
+    size_t                  m_capacity = 0;
+    std::vector<entry_type> m_entries  = {};
+};
+}  // namespace tool
+}  // namespace rocprofiler
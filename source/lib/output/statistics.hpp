@@ -23,12 +23,14 @@
 #pragma once
 
 #include "domain_type.hpp"
+#include "histogram.hpp"
 
 #include "lib/common/logging.hpp"
 #include "lib/common/mpl.hpp"
 
 #include <rocprofiler-sdk/cxx/serialization.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <fstream>
@@ -47,7 +49,9 @@ namespace tool
 /// \struct statistics
 /// \tparam Tp data type for statistical accumulation
 /// \tparam Fp floating point data type to use for division
-/// \brief A generic class for statistical accumulation.
+/// \brief A generic class for statistical accumulation. In addition to the moments, the values
+/// are accumulated into a mergeable quantile sketch so that percentiles can be reported without
+/// storing the individual values.
 ///
 template <typename Tp, typename Fp = double>
 struct statistics
@@ -72,7 +76,9 @@ public:
     , m_sqr(val * val)
     , m_min(val)
     , m_max(val)
-    {}
+    {
+        m_sketch.add(to_sketch_value(val));
+    }
 
     statistics& operator=(value_type val)
     {
@@ -81,6 +87,8 @@ public:
         m_min = val;
         m_max = val;
         m_sqr = (val * val);
+        m_sketch.reset();
+        m_sketch.add(to_sketch_value(val));
         return *this;
     }
 
@@ -105,6 +113,17 @@ public:
     float_type get_percent(float_type _total) const;
     float_type get_percent(const this_type&) const;
 
+    // approximate value at the quantile (0.0 - 1.0), e.g. 0.99 for the 99th percentile
+    value_type get_quantile(double _quantile) const
+    {
+        if(m_cnt == 0) return value_type{};
+
+        auto _val = static_cast<value_type>(m_sketch.get_quantile(_quantile));
+        return ::std::clamp(_val, m_min, m_max);
+    }
+
+    const log_linear_histogram& get_histogram() const { return m_sketch; }
+
     // Modifications
     void reset()
     {
@@ -113,6 +132,7 @@ public:
         m_sqr = value_type{};
         m_min = value_type{};
         m_max = value_type{};
+        m_sketch.reset();
     }
 
 public:
@@ -134,17 +154,34 @@ public:
             m_max = ::std::max(m_max, val);
         }
         ++m_cnt;
+        m_sketch.add(to_sketch_value(val));
 
         return *this;
     }
 
-    statistics& operator-=(value_type val)
+    // accumulate a value which represents `weight` samples, e.g. a record of a sampled API call
+    statistics& add(value_type val, int64_t weight)
     {
-        if(m_cnt > 1) --m_cnt;
-        m_sum -= val;
-        m_sqr -= (val * val);
-        m_min -= val;
-        m_max -= val;
+        if(weight <= 1) return (*this += val);
+
+        const auto _weight = static_cast<value_type>(weight);
+        if(m_cnt == 0)
+        {
+            m_sum = val * _weight;
+            m_sqr = (val * val) * _weight;
+            m_min = val;
+            m_max = val;
+        }
+        else
+        {
+            m_sum += val * _weight;
+            m_sqr += (val * val) * _weight;
+            m_min = ::std::min(m_min, val);
+            m_max = ::std::max(m_max, val);
+        }
+        m_cnt += weight;
+        m_sketch.add(to_sketch_value(val), static_cast<uint64_t>(weight));
+
         return *this;
     }
 
@@ -185,29 +222,31 @@ public:
             m_max = ::std::max(m_max, rhs.m_max);
         }
         m_cnt += rhs.m_cnt;
+        m_sketch += rhs.m_sketch;
         return *this;
     }
 
-    // Operators (this_type)
-    statistics& operator-=(const statistics& rhs)
+private:
+    // negative values are recorded in the lowest bucket of the sketch
+    static uint64_t to_sketch_value(value_type val)
     {
-        if(m_cnt > 0)
-        {
-            m_sum -= rhs.m_sum;
-            m_sqr -= rhs.m_sqr;
-            m_min = ::std::min(m_min, rhs.m_min);
-            m_max = ::std::max(m_max, rhs.m_max);
-        }
-        return *this;
+        if constexpr(std::is_floating_point<value_type>::value)
+            return (val > 0) ? static_cast<uint64_t>(::std::llround(val)) : 0;
+        else if constexpr(std::is_signed<value_type>::value)
+            return (val > 0) ? static_cast<uint64_t>(val) : 0;
+        else
+            return static_cast<uint64_t>(val);
     }
 
-private:
     // summation of each history^1
     int64_t    m_cnt = 0;
     value_type m_sum = value_type{};
     value_type m_sqr = value_type{};
     value_type m_min = value_type{};
     value_type m_max = value_type{};
+    // distribution of the values added, the arithmetic operators which scale the moments do not
+    // modify it. There is no subtraction since values cannot be removed from the sketch.
+    log_linear_histogram m_sketch = {};
 
 public:
     // friend operator for addition
@@ -216,11 +255,6 @@ public:
         return statistics(lhs) += rhs;
     }
 
-    friend statistics operator-(const statistics& lhs, const statistics& rhs)
-    {
-        return statistics(lhs) -= rhs;
-    }
-
     template <typename ArchiveT>
     void serialize(ArchiveT& ar, const unsigned int) const
     {
@@ -232,6 +266,10 @@ public:
         ar(cereal::make_nvp("mean", get_mean()));
         ar(cereal::make_nvp("stddev", get_stddev()));
         ar(cereal::make_nvp("variance", get_variance()));
+        ar(cereal::make_nvp("p50", get_quantile(0.5)));
+        ar(cereal::make_nvp("p90", get_quantile(0.9)));
+        ar(cereal::make_nvp("p99", get_quantile(0.99)));
+        ar(cereal::make_nvp("p999", get_quantile(0.999)));
     }
 };
 
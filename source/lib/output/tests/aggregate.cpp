@@ -0,0 +1,260 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/aggregate.hpp"
+#include "lib/output/metadata.hpp"
+#include "lib/output/output_config.hpp"
+
+#include <rocprofiler-sdk/buffer_tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+#include <rocprofiler-sdk/pc_sampling.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace tool = ::rocprofiler::tool;
+
+// the per-thread tables are global and never reset so each test aggregates distinct operations
+namespace
+{
+constexpr uint64_t agent_handle = 7;
+
+auto
+make_dispatch_record(uint64_t kernel_id, uint64_t rename_id, uint64_t duration)
+{
+    auto _record                          = rocprofiler_buffer_tracing_kernel_dispatch_record_t{};
+    _record.size                          = sizeof(_record);
+    _record.kind                          = ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH;
+    _record.operation                     = ROCPROFILER_KERNEL_DISPATCH_COMPLETE;
+    _record.correlation_id.external.value = rename_id;
+    _record.start_timestamp               = 1000;
+    _record.end_timestamp                 = 1000 + duration;
+    _record.dispatch_info.agent_id.handle = agent_handle;
+    _record.dispatch_info.kernel_id       = kernel_id;
+    return _record;
+}
+
+auto
+make_hip_record(uint64_t operation, uint64_t duration, uint64_t weight)
+{
+    auto _record            = rocprofiler_buffer_tracing_hip_api_record_t{};
+    _record.size            = sizeof(_record);
+    _record.kind            = ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API;
+    _record.operation       = static_cast<rocprofiler_tracing_operation_t>(operation);
+    _record.start_timestamp = 1000;
+    _record.end_timestamp   = 1000 + duration;
+    _record.sampling_weight = weight;
+    return _record;
+}
+
+auto
+make_pc_sample_record(uint64_t code_object_offset, uint64_t active_lanes, uint64_t timestamp)
+{
+    auto _sample                  = rocprofiler_pc_sampling_record_host_trap_v0_t{};
+    _sample.size                  = sizeof(_sample);
+    _sample.pc.code_object_id     = 3001;
+    _sample.pc.code_object_offset = code_object_offset;
+    _sample.exec_mask             = (uint64_t{1} << active_lanes) - 1;
+    _sample.timestamp             = timestamp;
+    return tool::rocprofiler_tool_pc_sampling_host_trap_record_t{
+        _sample, static_cast<int64_t>(code_object_offset / 4)};
+}
+
+tool::aggregate_key
+make_dispatch_key(uint64_t kernel_id, uint64_t name_id)
+{
+    return tool::aggregate_key{tool::domain_type::KERNEL_DISPATCH,
+                               ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH,
+                               kernel_id,
+                               agent_handle,
+                               name_id};
+}
+
+tool::aggregate_key
+make_hip_key(uint64_t operation)
+{
+    return tool::aggregate_key{
+        tool::domain_type::HIP, ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API, operation, 0, 0};
+}
+}  // namespace
+
+TEST(aggregate, kernel_rename_key)
+{
+    auto _metadata = tool::metadata{};
+    auto _cfg      = tool::output_config{};
+
+    // without kernel renaming, the external correlation id does not split the dispatches
+    _cfg.kernel_rename = false;
+    tool::aggregate(_cfg, _metadata, make_dispatch_record(1001, 5, 100));
+    tool::aggregate(_cfg, _metadata, make_dispatch_record(1001, 6, 300));
+
+    // with kernel renaming, the dispatches are aggregated per name
+    _cfg.kernel_rename = true;
+    tool::aggregate(_cfg, _metadata, make_dispatch_record(1002, 5, 100));
+    tool::aggregate(_cfg, _metadata, make_dispatch_record(1002, 6, 300));
+    tool::aggregate(_cfg, _metadata, make_dispatch_record(1002, 6, 500));
+
+    auto _data = tool::get_aggregates();
+
+    ASSERT_EQ(_data.count(make_dispatch_key(1001, 0)), 1);
+    EXPECT_EQ(_data.count(make_dispatch_key(1001, 5)), 0);
+    EXPECT_EQ(_data.count(make_dispatch_key(1001, 6)), 0);
+    EXPECT_EQ(_data.at(make_dispatch_key(1001, 0)).stats.get_count(), 2);
+    EXPECT_EQ(_data.at(make_dispatch_key(1001, 0)).stats.get_sum(), 400);
+
+    EXPECT_EQ(_data.count(make_dispatch_key(1002, 0)), 0);
+    ASSERT_EQ(_data.count(make_dispatch_key(1002, 5)), 1);
+    ASSERT_EQ(_data.count(make_dispatch_key(1002, 6)), 1);
+    EXPECT_EQ(_data.at(make_dispatch_key(1002, 5)).stats.get_count(), 1);
+    EXPECT_EQ(_data.at(make_dispatch_key(1002, 6)).stats.get_count(), 2);
+    EXPECT_EQ(_data.at(make_dispatch_key(1002, 6)).stats.get_sum(), 800);
+}
+
+TEST(aggregate, merge_threads)
+{
+    constexpr uint64_t num_threads = 8;
+    constexpr uint64_t num_records = 1000;
+    constexpr uint64_t num_total   = num_threads * num_records;
+    constexpr uint64_t weight      = 3;
+
+    // the durations of all threads are 1 ... (num_threads * num_records)
+    auto _threads = std::vector<std::thread>{};
+    for(uint64_t i = 0; i < num_threads; ++i)
+    {
+        _threads.emplace_back([i]() {
+            auto _metadata = tool::metadata{};
+            auto _cfg      = tool::output_config{};
+            for(uint64_t j = 0; j < num_records; ++j)
+            {
+                const auto _duration = (j * num_threads) + i + 1;
+                tool::aggregate(_cfg, _metadata, make_hip_record(2001, _duration, 1));
+                tool::aggregate(_cfg, _metadata, make_hip_record(2002, 10 + i, weight));
+            }
+        });
+    }
+    for(auto& itr : _threads)
+        itr.join();
+
+    auto _data = tool::get_aggregates();
+    ASSERT_EQ(_data.count(make_hip_key(2001)), 1);
+    ASSERT_EQ(_data.count(make_hip_key(2002)), 1);
+
+    const auto& _stats = _data.at(make_hip_key(2001)).stats;
+    EXPECT_EQ(_stats.get_count(), static_cast<int64_t>(num_total));
+    EXPECT_EQ(_stats.get_sum(), (num_total * (num_total + 1)) / 2);
+    EXPECT_EQ(_stats.get_min(), 1);
+    EXPECT_EQ(_stats.get_max(), num_total);
+    EXPECT_EQ(_stats.get_histogram().get_count(), num_total);
+    for(auto _quantile : {0.5, 0.9, 0.99})
+    {
+        const auto _expected = _quantile * num_total;
+        EXPECT_NEAR(static_cast<double>(_stats.get_quantile(_quantile)), _expected, _expected / 64)
+            << "quantile " << _quantile;
+    }
+
+    // each sampled record represents `weight` calls
+    const auto& _sampled = _data.at(make_hip_key(2002)).stats;
+    EXPECT_EQ(_sampled.get_count(), static_cast<int64_t>(num_total * weight));
+    EXPECT_EQ(_sampled.get_min(), 10);
+    EXPECT_EQ(_sampled.get_max(), 10 + num_threads - 1);
+    EXPECT_EQ(_sampled.get_histogram().get_count(), num_total * weight);
+
+    // merging again yields the same tables
+    auto _again = tool::get_aggregates();
+    EXPECT_EQ(_again.at(make_hip_key(2001)).stats.get_count(), _stats.get_count());
+    EXPECT_EQ(_again.at(make_hip_key(2002)).stats.get_count(), _sampled.get_count());
+}
+
+TEST(aggregate, pc_sample_merge_threads)
+{
+    constexpr uint64_t num_threads      = 4;
+    constexpr uint64_t num_samples      = 500;
+    constexpr uint64_t num_instructions = 10;
+    constexpr size_t   reservoir_size   = 50;
+
+    // thread i samples every instruction with i + 1 active lanes
+    auto _threads = std::vector<std::thread>{};
+    for(uint64_t i = 0; i < num_threads; ++i)
+    {
+        _threads.emplace_back([i]() {
+            for(uint64_t j = 0; j < num_samples; ++j)
+            {
+                const auto _offset = (j % num_instructions) * 4;
+                tool::aggregate(make_pc_sample_record(_offset, i + 1, (i * num_samples) + j + 1),
+                                reservoir_size);
+            }
+        });
+    }
+    for(auto& itr : _threads)
+        itr.join();
+
+    auto _data = tool::get_pc_sample_aggregates();
+    ASSERT_EQ(_data.size(), num_instructions);
+    for(uint64_t i = 0; i < num_instructions; ++i)
+    {
+        const auto  _inst  = tool::inst_t{3001, i * 4};
+        const auto& _value = _data.at(_inst);
+
+        EXPECT_EQ(_value.inst_index, static_cast<int64_t>(i));
+        EXPECT_EQ(_value.active_lanes.get_count(),
+                  static_cast<int64_t>(num_threads * num_samples / num_instructions));
+        EXPECT_EQ(_value.active_lanes.get_min(), 1);
+        EXPECT_EQ(_value.active_lanes.get_max(), num_threads);
+        EXPECT_EQ(_value.first_timestamp, i + 1);
+        EXPECT_EQ(_value.last_timestamp,
+                  ((num_threads - 1) * num_samples) + (num_samples - num_instructions) + i + 1);
+    }
+
+    // ties in the sample count are ordered by address
+    auto _sorted = tool::sort_pc_sample_aggregates(_data);
+    ASSERT_EQ(_sorted.size(), num_instructions);
+    for(uint64_t i = 0; i < num_instructions; ++i)
+        EXPECT_EQ(_sorted.at(i).first.code_object_offset, i * 4);
+
+    // the merged reservoir is a subset of the samples ordered by timestamp
+    auto _reservoir = tool::get_pc_sample_reservoir(reservoir_size);
+    ASSERT_EQ(_reservoir.size(), reservoir_size);
+    auto _timestamp_cmp = [](const auto& lhs, const auto& rhs) {
+        return (lhs.pc_sample_record.timestamp < rhs.pc_sample_record.timestamp);
+    };
+    EXPECT_TRUE(std::is_sorted(_reservoir.begin(), _reservoir.end(), _timestamp_cmp));
+    for(const auto& itr : _reservoir)
+    {
+        EXPECT_EQ(itr.pc_sample_record.pc.code_object_id, 3001);
+        EXPECT_GE(itr.pc_sample_record.timestamp, 1);
+        EXPECT_LE(itr.pc_sample_record.timestamp, num_threads * num_samples);
+    }
+
+    // a smaller reservoir keeps a subset of the larger one
+    auto _smaller = tool::get_pc_sample_reservoir(reservoir_size / 5);
+    ASSERT_EQ(_smaller.size(), reservoir_size / 5);
+    for(const auto& itr : _smaller)
+    {
+        EXPECT_TRUE(std::any_of(_reservoir.begin(), _reservoir.end(), [&itr](const auto& val) {
+            return (val.pc_sample_record.timestamp == itr.pc_sample_record.timestamp);
+        }));
+    }
+}
@@ -0,0 +1,175 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/histogram.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+using histogram_t = ::rocprofiler::tool::log_linear_histogram;
+
+using bucket_vec_t = std::vector<std::tuple<uint64_t, uint64_t, uint64_t>>;
+
+bucket_vec_t
+get_buckets(const histogram_t& hist)
+{
+    auto _data = bucket_vec_t{};
+    hist.for_each_bucket([&_data](uint64_t _lower, uint64_t _upper, uint64_t _count) {
+        _data.emplace_back(_lower, _upper, _count);
+    });
+    return _data;
+}
+}  // namespace
+
+TEST(histogram, bucket_index)
+{
+    // values below the sub-bucket count are binned exactly
+    for(uint64_t i = 0; i < histogram_t::sub_bucket_count; ++i)
+    {
+        EXPECT_EQ(histogram_t::get_index(i), i);
+        EXPECT_EQ(histogram_t::get_lower_bound(i), i);
+        EXPECT_EQ(histogram_t::get_upper_bound(i), i);
+    }
+
+    // the first power of two above the exact range still has a width of one, the next one has a
+    // width of two
+    EXPECT_EQ(histogram_t::get_index(32), 32);
+    EXPECT_EQ(histogram_t::get_index(63), 63);
+    EXPECT_EQ(histogram_t::get_index(64), 64);
+    EXPECT_EQ(histogram_t::get_index(65), 64);
+    EXPECT_EQ(histogram_t::get_index(66), 65);
+    EXPECT_EQ(histogram_t::get_lower_bound(64), 64);
+    EXPECT_EQ(histogram_t::get_upper_bound(64), 65);
+
+    EXPECT_EQ(histogram_t::get_lower_bound(histogram_t::get_index(UINT64_MAX)),
+              uint64_t{63} << 58);
+    EXPECT_EQ(histogram_t::get_upper_bound(histogram_t::get_index(UINT64_MAX)), UINT64_MAX);
+}
+
+TEST(histogram, bucket_bounds)
+{
+    // the buckets are contiguous and each one is at most 1/32 of its lower bound wide
+    for(size_t i = 0; i < histogram_t::get_index(uint64_t{1} << 40); ++i)
+    {
+        const auto _lower = histogram_t::get_lower_bound(i);
+        const auto _upper = histogram_t::get_upper_bound(i);
+
+        ASSERT_LE(_lower, _upper) << "bucket " << i;
+        ASSERT_EQ(_upper + 1, histogram_t::get_lower_bound(i + 1)) << "bucket " << i;
+        ASSERT_LE(_upper - _lower, std::max<uint64_t>(_lower / histogram_t::sub_bucket_count, 1))
+            << "bucket " << i;
+    }
+
+    auto _rng  = std::mt19937_64{42};
+    auto _dist = std::uniform_int_distribution<uint64_t>{};
+    for(size_t i = 0; i < 100000; ++i)
+    {
+        const auto _val = _dist(_rng) >> (i % 64);
+        const auto _idx = histogram_t::get_index(_val);
+        ASSERT_LE(histogram_t::get_lower_bound(_idx), _val) << "value " << _val;
+        ASSERT_GE(histogram_t::get_upper_bound(_idx), _val) << "value " << _val;
+    }
+}
+
+TEST(histogram, quantile)
+{
+    auto _hist = histogram_t{};
+    EXPECT_EQ(_hist.get_quantile(0.5), 0);
+
+    for(uint64_t i = 1; i <= 10000; ++i)
+        _hist.add(i);
+
+    EXPECT_EQ(_hist.get_count(), 10000);
+
+    // the estimate is the midpoint of the bucket so the relative error is at most 1/64
+    for(auto _quantile : {0.5, 0.9, 0.99, 0.999})
+    {
+        const auto _expected = _quantile * 10000;
+        const auto _value    = static_cast<double>(_hist.get_quantile(_quantile));
+        EXPECT_NEAR(_value, _expected, _expected / 64) << "quantile " << _quantile;
+    }
+
+    EXPECT_EQ(_hist.get_quantile(0.0), 1);
+    EXPECT_EQ(_hist.get_quantile(-1.0), 1);
+    EXPECT_EQ(_hist.get_quantile(2.0), _hist.get_quantile(1.0));
+    EXPECT_NEAR(static_cast<double>(_hist.get_quantile(1.0)), 10000, 10000 / 64);
+}
+
+TEST(histogram, weighted_add)
+{
+    auto _weighted = histogram_t{};
+    auto _repeated = histogram_t{};
+
+    for(uint64_t i = 1; i <= 1000; ++i)
+    {
+        _weighted.add(i * 7, i % 5);
+        for(uint64_t j = 0; j < i % 5; ++j)
+            _repeated.add(i * 7);
+    }
+
+    EXPECT_EQ(_weighted.get_count(), _repeated.get_count());
+    EXPECT_EQ(get_buckets(_weighted), get_buckets(_repeated));
+    for(auto _quantile : {0.5, 0.9, 0.99, 0.999})
+        EXPECT_EQ(_weighted.get_quantile(_quantile), _repeated.get_quantile(_quantile));
+}
+
+TEST(histogram, merge)
+{
+    auto _rng  = std::mt19937_64{1234};
+    auto _dist = std::lognormal_distribution<double>{10.0, 2.0};
+
+    // the ranges of the parts are disjoint and overlapping so merging grows the buckets in both
+    // directions
+    auto _parts = std::vector<histogram_t>(4);
+    auto _total = histogram_t{};
+    for(size_t i = 0; i < 40000; ++i)
+    {
+        auto       _val  = static_cast<uint64_t>(_dist(_rng));
+        const auto _part = (i % _parts.size());
+        if(_part == 0) _val /= 1000;
+        if(_part == 1) _val *= 1000;
+        _parts.at(_part).add(_val);
+        _total.add(_val);
+    }
+
+    auto _merged = histogram_t{};
+    _merged += histogram_t{};
+    for(const auto& itr : _parts)
+        _merged += itr;
+    _merged += histogram_t{};
+
+    EXPECT_EQ(_merged.get_count(), _total.get_count());
+    EXPECT_EQ(get_buckets(_merged), get_buckets(_total));
+    for(auto _quantile : {0.5, 0.9, 0.99, 0.999})
+        EXPECT_EQ(_merged.get_quantile(_quantile), _total.get_quantile(_quantile));
+
+    _merged.reset();
+    EXPECT_EQ(_merged.get_count(), 0);
+    EXPECT_TRUE(get_buckets(_merged).empty());
+}
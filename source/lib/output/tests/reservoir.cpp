@@ -0,0 +1,137 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/reservoir.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+using reservoir_t = ::rocprofiler::tool::bottom_k_sample<uint64_t>;
+
+// the sorted priorities of the retained entries. The value of each entry is its priority + 1 so
+// the values are checked to follow their priority
+std::vector<uint64_t>
+get_priorities(const reservoir_t& reservoir)
+{
+    auto _data = std::vector<uint64_t>{};
+    for(const auto& itr : reservoir.get_entries())
+    {
+        EXPECT_EQ(itr.second, itr.first + 1);
+        _data.emplace_back(itr.first);
+    }
+    std::sort(_data.begin(), _data.end());
+    return _data;
+}
+
+std::vector<uint64_t>
+get_smallest(std::vector<uint64_t> priorities, size_t k)
+{
+    std::sort(priorities.begin(), priorities.end());
+    priorities.resize(std::min(k, priorities.size()));
+    return priorities;
+}
+}  // namespace
+
+TEST(reservoir, bottom_k)
+{
+    constexpr size_t capacity = 100;
+
+    auto _rng        = std::mt19937_64{42};
+    auto _reservoir  = reservoir_t{capacity};
+    auto _priorities = std::vector<uint64_t>{};
+
+    EXPECT_TRUE(_reservoir.empty());
+    EXPECT_EQ(_reservoir.capacity(), capacity);
+
+    // fewer values than the capacity are all retained
+    for(size_t i = 0; i < capacity / 2; ++i)
+    {
+        _priorities.emplace_back(_rng());
+        _reservoir.add(_priorities.back(), _priorities.back() + 1);
+    }
+    EXPECT_EQ(_reservoir.size(), capacity / 2);
+    EXPECT_EQ(get_priorities(_reservoir), get_smallest(_priorities, capacity));
+
+    for(size_t i = 0; i < 100000; ++i)
+    {
+        _priorities.emplace_back(_rng());
+        _reservoir.add(_priorities.back(), _priorities.back() + 1);
+    }
+    EXPECT_EQ(_reservoir.size(), capacity);
+    EXPECT_EQ(get_priorities(_reservoir), get_smallest(_priorities, capacity));
+}
+
+TEST(reservoir, zero_capacity)
+{
+    auto _reservoir = reservoir_t{};
+    for(uint64_t i = 0; i < 10; ++i)
+        _reservoir.add(i, i + 1);
+    EXPECT_TRUE(_reservoir.empty());
+}
+
+TEST(reservoir, merge)
+{
+    constexpr size_t capacity    = 64;
+    constexpr size_t num_threads = 8;
+
+    auto _rng        = std::mt19937_64{1234};
+    auto _priorities = std::vector<uint64_t>{};
+    auto _threads    = std::vector<reservoir_t>(num_threads, reservoir_t{capacity});
+
+    // the threads receive different numbers of values, some fewer than the capacity
+    for(size_t i = 0; i < num_threads; ++i)
+    {
+        for(size_t j = 0; j < (i * i * 20); ++j)
+        {
+            _priorities.emplace_back(_rng());
+            _threads.at(i).add(_priorities.back(), _priorities.back() + 1);
+        }
+    }
+
+    // the merged reservoir holds the k smallest priorities of all the threads
+    auto _merged = reservoir_t{capacity};
+    for(const auto& itr : _threads)
+        _merged += itr;
+
+    EXPECT_EQ(_merged.size(), capacity);
+    EXPECT_EQ(get_priorities(_merged), get_smallest(_priorities, capacity));
+
+    // merging is independent of the order of the threads
+    auto _reversed = reservoir_t{capacity};
+    for(auto itr = _threads.rbegin(); itr != _threads.rend(); ++itr)
+        _reversed += *itr;
+
+    EXPECT_EQ(get_priorities(_reversed), get_priorities(_merged));
+
+    // a smaller merged reservoir holds the smallest priorities of the larger one
+    auto _smaller = reservoir_t{capacity / 4};
+    for(const auto& itr : _threads)
+        _smaller += itr;
+
+    EXPECT_EQ(get_priorities(_smaller), get_smallest(_priorities, capacity / 4));
+}
@@ -0,0 +1,189 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/output/statistics.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using stats_t = ::rocprofiler::tool::stats_data_t;
+
+// the sketch reports the midpoint of the bucket which contains the value of that rank and a
+// bucket is at most 1/32 of its lower bound wide
+void
+expect_quantile_near(const stats_t& stats, double quantile, uint64_t expected)
+{
+    auto _value     = stats.get_quantile(quantile);
+    auto _tolerance = std::max<uint64_t>(expected / 32, 1);
+    EXPECT_GE(_value + _tolerance, expected) << "quantile: " << quantile;
+    EXPECT_LE(_value, expected + _tolerance) << "quantile: " << quantile;
+}
+
+// exact value of the given rank of the sorted values, using the same rank as the sketch
+uint64_t
+get_exact_quantile(std::vector<uint64_t> values, double quantile)
+{
+    std::sort(values.begin(), values.end());
+    auto _rank = static_cast<size_t>(std::ceil(quantile * static_cast<double>(values.size())));
+    return values.at(std::max<size_t>(_rank, 1) - 1);
+}
+}  // namespace
+
+TEST(statistics, empty)
+{
+    auto _stats = stats_t{};
+    EXPECT_EQ(_stats.get_count(), 0);
+    EXPECT_EQ(_stats.get_quantile(0.5), 0);
+    EXPECT_EQ(_stats.get_quantile(0.999), 0);
+}
+
+TEST(statistics, quantiles_uniform)
+{
+    constexpr uint64_t num_values = 100000;
+
+    auto _stats = stats_t{};
+    for(uint64_t i = 1; i <= num_values; ++i)
+        _stats += i;
+
+    EXPECT_EQ(_stats.get_count(), num_values);
+    EXPECT_EQ(_stats.get_min(), 1);
+    EXPECT_EQ(_stats.get_max(), num_values);
+
+    expect_quantile_near(_stats, 0.5, 50000);
+    expect_quantile_near(_stats, 0.9, 90000);
+    expect_quantile_near(_stats, 0.99, 99000);
+    expect_quantile_near(_stats, 0.999, 99900);
+}
+
+TEST(statistics, quantiles_long_tail)
+{
+    // log-normal durations, e.g. API calls with a few slow outliers
+    auto _engine = std::mt19937_64{12345};
+    auto _dist   = std::lognormal_distribution<double>{8.0, 1.5};
+    auto _values = std::vector<uint64_t>{};
+    auto _stats  = stats_t{};
+
+    for(size_t i = 0; i < 200000; ++i)
+    {
+        auto _val = static_cast<uint64_t>(_dist(_engine)) + 1;
+        _values.emplace_back(_val);
+        _stats += _val;
+    }
+
+    for(auto _quantile : {0.5, 0.9, 0.99, 0.999})
+        expect_quantile_near(_stats, _quantile, get_exact_quantile(_values, _quantile));
+
+    // the percentiles are ordered and bounded by the extrema
+    EXPECT_LE(_stats.get_min(), _stats.get_quantile(0.5));
+    EXPECT_LE(_stats.get_quantile(0.5), _stats.get_quantile(0.9));
+    EXPECT_LE(_stats.get_quantile(0.9), _stats.get_quantile(0.99));
+    EXPECT_LE(_stats.get_quantile(0.99), _stats.get_quantile(0.999));
+    EXPECT_LE(_stats.get_quantile(0.999), _stats.get_max());
+}
+
+TEST(statistics, quantiles_outliers)
+{
+    // 0.5% of the values are outliers: only P99.9 sees them
+    auto _stats = stats_t{};
+    for(size_t i = 0; i < 995; ++i)
+        _stats += 100;
+    for(size_t i = 0; i < 5; ++i)
+        _stats += 100000;
+
+    EXPECT_EQ(_stats.get_quantile(0.5), 100);
+    EXPECT_EQ(_stats.get_quantile(0.9), 100);
+    EXPECT_EQ(_stats.get_quantile(0.99), 100);
+    expect_quantile_near(_stats, 0.999, 100000);
+    EXPECT_EQ(_stats.get_max(), 100000);
+}
+
+TEST(statistics, weighted_add)
+{
+    auto _weighted = stats_t{};
+    auto _repeated = stats_t{};
+
+    const auto _samples = std::vector<std::pair<uint64_t, int64_t>>{
+        {250, 4}, {1000, 1}, {40, 10}, {70000, 2}, {3, 0}, {1000, 3}};
+
+    for(const auto& [_val, _weight] : _samples)
+    {
+        _weighted.add(_val, _weight);
+        // a weight of zero or one is a single sample
+        for(int64_t i = 0; i < std::max<int64_t>(_weight, 1); ++i)
+            _repeated += _val;
+    }
+
+    EXPECT_EQ(_weighted.get_count(), 21);
+    EXPECT_EQ(_weighted.get_count(), _repeated.get_count());
+    EXPECT_EQ(_weighted.get_sum(), _repeated.get_sum());
+    EXPECT_EQ(_weighted.get_sqr(), _repeated.get_sqr());
+    EXPECT_EQ(_weighted.get_min(), 3);
+    EXPECT_EQ(_weighted.get_max(), 70000);
+    EXPECT_DOUBLE_EQ(_weighted.get_mean(), _repeated.get_mean());
+    EXPECT_DOUBLE_EQ(_weighted.get_variance(), _repeated.get_variance());
+    EXPECT_EQ(_weighted.get_histogram().get_count(), 21);
+
+    for(auto _quantile : {0.0, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0})
+    {
+        EXPECT_EQ(_weighted.get_quantile(_quantile), _repeated.get_quantile(_quantile))
+            << "quantile: " << _quantile;
+    }
+
+    // sorted samples: 3 x1, 40 x10, 250 x4, 1000 x4, 70000 x2
+    EXPECT_EQ(_weighted.get_quantile(0.25), 40);
+    EXPECT_EQ(_weighted.get_quantile(0.5), 40);
+    expect_quantile_near(_weighted, 0.75, 1000);
+    expect_quantile_near(_weighted, 0.999, 70000);
+}
+
+TEST(statistics, merge)
+{
+    auto _lhs   = stats_t{};
+    auto _rhs   = stats_t{};
+    auto _total = stats_t{};
+
+    for(uint64_t i = 1; i <= 1000; ++i)
+    {
+        ((i % 3 == 0) ? _lhs : _rhs) += (i * 37);
+        _total += (i * 37);
+    }
+
+    auto _merged = _lhs + _rhs;
+    EXPECT_EQ(_merged.get_count(), _total.get_count());
+    EXPECT_EQ(_merged.get_sum(), _total.get_sum());
+    EXPECT_EQ(_merged.get_min(), _total.get_min());
+    EXPECT_EQ(_merged.get_max(), _total.get_max());
+
+    for(auto _quantile : {0.5, 0.9, 0.99, 0.999})
+    {
+        EXPECT_EQ(_merged.get_quantile(_quantile), _total.get_quantile(_quantile))
+            << "quantile: " << _quantile;
+    }
+}
@@ -25,6 +25,11 @@
 #include "lib/common/filesystem.hpp"
 #include "lib/common/logging.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace fs = ::rocprofiler::common::filesystem;
 
 bool
@@ -143,3 +148,38 @@ tmp_file::operator bool() const
 {
     return (stream.is_open() && stream.good()) || (file != nullptr && fd > 0);
 }
+
+tmp_file_view::tmp_file_view(const std::string& _filename)
+{
+    auto _fd = ::open(_filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if(_fd < 0)
+    {
+        ROCP_INFO << "unable to open temporary file '" << _filename << "' for mapping";
+        return;
+    }
+
+    struct stat _stat = {};
+    if(::fstat(_fd, &_stat) == 0 && _stat.st_size > 0)
+    {
+        auto  _size = static_cast<size_t>(_stat.st_size);
+        void* _addr = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+        if(_addr != MAP_FAILED)
+        {
+            // records are consumed front to back: favor read-ahead and early page reclamation
+            ::madvise(_addr, _size, MADV_SEQUENTIAL);
+            m_data = static_cast<const char*>(_addr);
+            m_size = _size;
+        }
+        else
+        {
+            ROCP_INFO << "unable to map temporary file '" << _filename << "'";
+        }
+    }
+
+    ::close(_fd);
+}
+
+tmp_file_view::~tmp_file_view()
+{
+    if(m_data) ::munmap(const_cast<char*>(m_data), m_size);
+}
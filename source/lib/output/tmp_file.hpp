@@ -65,6 +65,29 @@ struct tmp_file
     std::mutex               file_mutex   = {};
 };
 
+/// read-only memory mapping of a temporary file. The mapping is private to this instance and is
+/// released on destruction so readers can stream multi-GB files without copying them into memory
+struct tmp_file_view
+{
+    tmp_file_view() = default;
+    explicit tmp_file_view(const std::string& _filename);
+    ~tmp_file_view();
+
+    tmp_file_view(const tmp_file_view&) = delete;
+    tmp_file_view(tmp_file_view&&)      = delete;
+    tmp_file_view& operator=(const tmp_file_view&) = delete;
+    tmp_file_view& operator=(tmp_file_view&&) = delete;
+
+    const char* data() const { return m_data; }
+    size_t      size() const { return m_size; }
+
+    explicit operator bool() const { return (m_data != nullptr); }
+
+private:
+    const char* m_data = nullptr;
+    size_t      m_size = 0;
+};
+
 template <typename Tp>
 std::streampos
 tmp_file::write(const Tp* data, size_t num_records)
@@ -28,14 +28,22 @@
 #include "wave.hpp"
 #include "wstates.hpp"
 
+#include "lib/common/environment.hpp"
 #include "lib/rocprofiler-sdk/registration.hpp"
 
 #include <dlfcn.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <algorithm>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include <thread>
 #include <vector>
 
 namespace rocprofiler
@@ -72,14 +80,214 @@ void
 ATTFileMgr::parseShader(int se_id, const std::vector<char>& data)
 {
     WaveConfig config(se_id, filenames, codefile, wstates);
-    ToolData   tooldata(data, config, dl);
+    ToolData   tooldata(data.data(), data.size(), config, dl);
 
-    if(config.occupancy.size()) occupancy.emplace(se_id, std::move(config.occupancy));
+    commitShader(config, tooldata);
+}
+
+void
+ATTFileMgr::commitShader(WaveConfig& config, ToolData& tooldata)
+{
+    tooldata.commit();
+
+    if(config.occupancy.size())
+        occupancy.emplace(config.shader_engine, std::move(config.occupancy));
 
     for(auto& [pc, kernel] : config.kernel_names)
         codefile->kernel_names.emplace(pc, std::move(kernel));
 }
 
+namespace
+{
+/**
+ * Read-only view of an ATT file. The pages are mapped copy-on-write since the decoder
+ * receives a non-const buffer.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const Fspath& path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0) return;
+
+        struct stat st = {};
+        if(::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* ptr = ::mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if(ptr != MAP_FAILED)
+            {
+                m_data = static_cast<char*>(ptr);
+                m_size = st.st_size;
+                ::madvise(ptr, m_size, MADV_SEQUENTIAL);
+            }
+        }
+        m_valid = m_data != nullptr || st.st_size == 0;
+        ::close(fd);
+    }
+
+    ~MappedFile()
+    {
+        if(m_data) ::munmap(m_data, m_size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool        valid() const { return m_valid; }
+    const char* data() const { return m_data; }
+    size_t      size() const { return m_size; }
+
+private:
+    char*  m_data{nullptr};
+    size_t m_size{0};
+    bool   m_valid{false};
+};
+
+size_t
+get_decode_threads()
+{
+    auto _ncpu = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    return rocprofiler::common::get_env("ROCPROF_ATT_DECODE_THREADS", _ncpu);
+}
+
+size_t
+get_decode_memory_limit()
+{
+    constexpr size_t default_limit = 1024UL * 1024UL * 1024UL;
+    return rocprofiler::common::get_env("ROCPROF_ATT_DECODE_MEMORY_LIMIT", default_limit);
+}
+}  // namespace
+
+void
+ATTFileMgr::parseShaders(const std::vector<std::pair<int, Fspath>>& shaders)
+{
+    struct shader_slot_t
+    {
+        std::unique_ptr<WaveConfig> config{nullptr};
+        std::unique_ptr<ToolData>   tooldata{nullptr};
+        bool                        done{false};
+    };
+
+    auto slots = std::vector<shader_slot_t>(shaders.size());
+
+    auto decode = [&](size_t idx) {
+        auto& [se_id, path] = shaders.at(idx);
+        auto& slot          = slots.at(idx);
+        try
+        {
+            auto file = MappedFile{path};
+            if(!file.valid())
+            {
+                ROCP_WARNING << "could not open " << path.string();
+                return;
+            }
+
+            slot.config   = std::make_unique<WaveConfig>(se_id, filenames, codefile, wstates);
+            slot.tooldata = std::make_unique<ToolData>(file.data(), file.size(), *slot.config, dl);
+        } catch(std::exception& e)
+        {
+            ROCP_ERROR << "Failed to decode " << path.string() << ": " << e.what();
+            slot.tooldata.reset();
+        }
+    };
+
+    auto commit = [&](size_t idx) {
+        auto& slot = slots.at(idx);
+        if(slot.tooldata)
+        {
+            try
+            {
+                commitShader(*slot.config, *slot.tooldata);
+            } catch(std::exception& e)
+            {
+                ROCP_ERROR << "Failed to merge shader engine " << shaders.at(idx).first << ": "
+                           << e.what();
+            }
+        }
+        slot.tooldata.reset();
+        slot.config.reset();
+    };
+
+    size_t nthreads = std::min(get_decode_threads(), shaders.size());
+    if(nthreads <= 1)
+    {
+        for(size_t i = 0; i < shaders.size(); i++)
+        {
+            decode(i);
+            commit(i);
+        }
+        return;
+    }
+
+    // Decoded shader engines are held in memory until they are merged in order, so workers
+    // may not run further ahead of the merge than this window. The window is also bounded by
+    // the bytes of the decoded events which are waiting to be merged: no decode is started past
+    // the limit, so at most one decode per thread completes over it. The shader engine which is
+    // next in order is always decoded so the merge can make progress.
+    const size_t window       = 2 * nthreads;
+    const size_t memory_limit = get_decode_memory_limit();
+    size_t       next         = 0;
+    size_t       committed    = 0;
+    size_t       held_bytes   = 0;
+
+    std::mutex              mutex{};
+    std::condition_variable cv{};
+
+    auto worker = [&]() {
+        while(true)
+        {
+            size_t idx = 0;
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                cv.wait(lk, [&] {
+                    return next >= slots.size() || next == committed ||
+                           (next < committed + window && held_bytes < memory_limit);
+                });
+                if(next >= slots.size()) return;
+                idx = next++;
+            }
+
+            decode(idx);
+
+            {
+                std::unique_lock<std::mutex> lk(mutex);
+                auto&                        slot = slots.at(idx);
+                if(slot.tooldata) held_bytes += slot.tooldata->event_bytes;
+                slot.done = true;
+            }
+            cv.notify_all();
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    threads.reserve(nthreads);
+    for(size_t i = 0; i < nthreads; i++)
+        threads.emplace_back(worker);
+
+    for(size_t i = 0; i < slots.size(); i++)
+    {
+        size_t bytes = 0;
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            cv.wait(lk, [&] { return slots.at(i).done; });
+            if(slots.at(i).tooldata) bytes = slots.at(i).tooldata->event_bytes;
+        }
+
+        commit(i);
+
+        {
+            std::unique_lock<std::mutex> lk(mutex);
+            committed = i + 1;
+            held_bytes -= bytes;
+        }
+        cv.notify_all();
+    }
+
+    for(auto& thread : threads)
+        thread.join();
+}
+
 int
 get_shader_id(const std::string& name)
 {
@@ -151,36 +359,22 @@ ATTDecoder::parse(const Fspath&                       input_dir,
         }
     }
 
+    auto shaders = std::vector<std::pair<int, Fspath>>{};
+    shaders.reserve(att_files.size());
+
     for(auto& shader : att_files)
     {
-        int shader_id = 0;
         try
         {
-            shader_id = get_shader_id(shader);
+            shaders.emplace_back(get_shader_id(shader), input_dir / shader);
         } catch(std::exception& e)
         {
             ROCP_WARNING << "Could not retrieve shader_id: " << e.what();
-            continue;
         }
-
-        std::vector<char> shader_data;
-
-        {
-            std::ifstream file(input_dir / shader, std::ios::binary);
-            if(!file.is_open())
-            {
-                ROCP_WARNING << "could not open " << shader;
-                continue;
-            }
-
-            file.seekg(0, std::ios::end);
-            shader_data.resize(file.tellg());
-            file.seekg(0);
-            file.read(shader_data.data(), shader_data.size());
-        }
-
-        mgr.parseShader(shader_id, shader_data);
     }
+
+    mgr.parseShaders(shaders);
+    mgr.table->flush_cache();
 }
 
 bool
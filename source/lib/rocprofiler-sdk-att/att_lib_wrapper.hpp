@@ -29,6 +29,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <utility>
 #include <vector>
 
 namespace rocprofiler
@@ -95,6 +96,12 @@ public:
 
     void parseShader(int se_id, const std::vector<char>& data);
 
+    /**
+     * Decodes the shader engine files concurrently. Results are merged in the order of the list,
+     * so the output is identical to calling parseShader() on each file in sequence.
+     */
+    void parseShaders(const std::vector<std::pair<int, Fspath>>& shaders);
+
     Fspath dir{};
 
     std::shared_ptr<class DL>          dl{nullptr};
@@ -104,6 +111,9 @@ public:
 
     std::map<size_t, std::vector<att_occupancy_info_v2_t>>              occupancy;
     std::array<std::shared_ptr<class WstatesFile>, ATT_WAVE_STATE_LAST> wstates;
+
+private:
+    void commitShader(class WaveConfig& config, struct ToolData& tooldata);
 };
 
 }  // namespace att_wrapper
@@ -26,6 +26,7 @@
 
 #include <atomic>
 #include <map>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include "att_decoder.h"
@@ -62,6 +63,7 @@ public:
     std::map<pcinfo_t, KernelName>                kernel_names{};
 
     std::shared_ptr<AddressTable> table;
+    std::mutex                    mutex{};  // guards the maps and table across decode threads
 };
 
 }  // namespace att_wrapper
@@ -70,7 +70,9 @@ get_trace_data(rocprofiler_att_decoder_record_type_t trace_id,
 
     if(trace_id == ROCPROFILER_ATT_DECODER_TYPE_GFXIP)
     {
-        tool.config.filemgr->gfxip = reinterpret_cast<size_t>(trace_events);
+        auto& event = tool.events.emplace_back();
+        event.kind  = ToolData::trace_event_t::GFXIP;
+        event.gfxip = reinterpret_cast<size_t>(trace_events);
     }
     else if(trace_id == ROCPROFILER_ATT_DECODER_TYPE_OCCUPANCY)
     {
@@ -78,36 +80,27 @@ get_trace_data(rocprofiler_att_decoder_record_type_t trace_id,
             tool.config.occupancy.push_back(
                 reinterpret_cast<const att_occupancy_info_v2_t*>(trace_events)[i]);
     }
-
-    if(trace_id != ROCPROFILER_ATT_DECODER_TYPE_WAVE) return ROCPROFILER_ATT_DECODER_STATUS_SUCCESS;
-
-    bool bInvalid = false;
-    for(size_t wave_n = 0; wave_n < trace_size; wave_n++)
+    else if(trace_id == ROCPROFILER_ATT_DECODER_TYPE_WAVE)
     {
-        auto& wave = reinterpret_cast<att_wave_data_t*>(trace_events)[wave_n];
-
-        WaveFile(tool.config, wave);
-
-        for(size_t j = 0; j < wave.instructions_size; j++)
+        // The wave arrays are only valid for the duration of the callback
+        auto& event = tool.events.emplace_back();
+        event.kind  = ToolData::trace_event_t::WAVES;
+        event.waves.reserve(trace_size);
+        for(size_t wave_n = 0; wave_n < trace_size; wave_n++)
         {
-            auto& inst = wave.instructions_array[j];
-            if(inst.pc.marker_id == 0 && inst.pc.addr == 0)
-                continue;
-            else if(inst.category >= att_wave_inst_category_t::ATT_INST_LAST)
-                continue;
+            const auto& wave = reinterpret_cast<const att_wave_data_t*>(trace_events)[wave_n];
+            auto&       copy = event.waves.emplace_back();
 
-            try
-            {
-                auto& line = tool.get(inst.pc);
-                line.hitcount.fetch_add(1, std::memory_order_relaxed);
-                line.latency.fetch_add(inst.duration, std::memory_order_relaxed);
-            } catch(...)
-            {
-                bInvalid = true;
-            }
+            copy.wave = wave;
+            copy.instructions.assign(wave.instructions_array,
+                                     wave.instructions_array + wave.instructions_size);
+            copy.timeline.assign(wave.timeline_array, wave.timeline_array + wave.timeline_size);
+
+            tool.event_bytes += sizeof(ToolData::wave_copy_t) +
+                                copy.instructions.size() * sizeof(att_wave_instruction_t) +
+                                copy.timeline.size() * sizeof(att_wave_state_t);
         }
     }
-    if(bInvalid) ROCP_WARNING << "Could not fetch some instructions!";
 
     return ROCPROFILER_ATT_DECODER_STATUS_SUCCESS;
 
@@ -144,8 +137,7 @@ isa_callback(char*     isa_instruction,
 
     try
     {
-        CodeLine& line = tool.get(pc);
-        instruction    = line.code_line;
+        instruction = tool.get_instruction(pc);
     } catch(std::exception& e)
     {
         ROCP_WARNING << pc.marker_id << ":" << pc.addr << ' ' << e.what();
@@ -168,14 +160,17 @@ isa_callback(char*     isa_instruction,
     return ROCPROFILER_ATT_DECODER_STATUS_SUCCESS;
 }
 
-ToolData::ToolData(const std::vector<char>& _data, WaveConfig& _config, std::shared_ptr<DL> _dl)
+ToolData::ToolData(const char*         _data,
+                   size_t              _size,
+                   WaveConfig&         _config,
+                   std::shared_ptr<DL> _dl)
 : cfile(_config.code)
 , config(_config)
 , dl(std::move(_dl))
 {
     trace_data_t data{.id   = config.shader_engine,
-                      .data = (uint8_t*) _data.data(),
-                      .size = _data.size(),
+                      .data = (uint8_t*) _data,
+                      .size = _size,
                       .tool = this};
 
     auto status = dl->att_parse_data_fn(copy_trace_data, get_trace_data, isa_callback, &data);
@@ -198,6 +193,102 @@ demangle(std::string_view line)
     return str;
 }
 
+void
+ToolData::commit()
+{
+    for(auto& event : events)
+    {
+        if(event.kind == trace_event_t::GFXIP)
+        {
+            config.filemgr->gfxip = event.gfxip;
+        }
+        else if(event.kind == trace_event_t::ISA_LOOKUP)
+        {
+            try
+            {
+                std::unique_lock<std::mutex> lk(cfile->mutex);
+                get(event.pc);
+            } catch(...)
+            {}
+        }
+        else
+        {
+            std::vector<att_wave_data_t> waves{};
+            waves.reserve(event.waves.size());
+            for(auto& copy : event.waves)
+            {
+                auto& wave              = waves.emplace_back(copy.wave);
+                wave.instructions_array = copy.instructions.data();
+                wave.timeline_array     = copy.timeline.data();
+            }
+            add_waves(waves.data(), waves.size());
+        }
+    }
+
+    events.clear();
+    instructions.clear();
+    event_bytes = 0;
+}
+
+void
+ToolData::add_waves(const att_wave_data_t* waves, size_t _num_waves)
+{
+    bool bInvalid = false;
+    for(size_t wave_n = 0; wave_n < _num_waves; wave_n++)
+    {
+        auto& wave = waves[wave_n];
+
+        WaveFile(config, wave);
+
+        for(size_t j = 0; j < wave.instructions_size; j++)
+        {
+            auto& inst = wave.instructions_array[j];
+            if(inst.pc.marker_id == 0 && inst.pc.addr == 0)
+                continue;
+            else if(inst.category >= att_wave_inst_category_t::ATT_INST_LAST)
+                continue;
+
+            try
+            {
+                std::unique_lock<std::mutex> lk(cfile->mutex);
+
+                auto& line = get(inst.pc);
+                line.hitcount.fetch_add(1, std::memory_order_relaxed);
+                line.latency.fetch_add(inst.duration, std::memory_order_relaxed);
+            } catch(...)
+            {
+                bInvalid = true;
+            }
+        }
+    }
+    if(bInvalid) ROCP_WARNING << "Could not fetch some instructions!";
+}
+
+std::shared_ptr<Instruction>
+ToolData::get_instruction(pcinfo_t _pc)
+{
+    if(auto it = instructions.find(_pc); it != instructions.end()) return it->second;
+
+    auto& event = events.emplace_back();
+    event.kind  = trace_event_t::ISA_LOOKUP;
+    event.pc    = _pc;
+
+    // Line numbers are assigned by commit(), this only needs the instruction itself
+    std::shared_ptr<Instruction> instruction{nullptr};
+    {
+        std::unique_lock<std::mutex> lk(cfile->mutex);
+
+        auto& isa_map = cfile->isa_map;
+        if(auto it = isa_map.find(_pc); it != isa_map.end())
+            instruction = it->second->code_line;
+        else
+            instruction = cfile->table->get(_pc.marker_id, _pc.addr);
+    }
+
+    instructions.emplace(_pc, instruction);
+    return instruction;
+}
+
 CodeLine&
 ToolData::get(pcinfo_t _pc)
 {
@@ -207,14 +298,16 @@ ToolData::get(pcinfo_t _pc)
     // Attempt to disassemble full kernel
     if(_pc.marker_id) try
         {
+            auto symbol_map = cfile->table->getSymbolMap(_pc.marker_id);
+
             rocprofiler::sdk::codeobj::segment::CodeobjTableTranslator symbol_table;
-            for(auto& [vaddr, symbol] : cfile->table->getSymbolMap(_pc.marker_id))
+            for(auto& [vaddr, symbol] : symbol_map)
                 symbol_table.insert({symbol.vaddr, symbol.mem_size, _pc.marker_id});
 
             auto addr_range = symbol_table.find_codeobj_in_range(_pc.addr);
             try
             {
-                auto symbol = cfile->table->getSymbolMap(_pc.marker_id).at(addr_range.addr);
+                auto symbol = symbol_map.at(addr_range.addr);
                 auto pair   = KernelName{symbol.name, demangle(symbol.name)};
                 cfile->kernel_names.emplace(pcinfo_t{addr_range.addr, _pc.marker_id}, pair);
             } catch(...)
@@ -58,19 +58,55 @@ namespace att_wrapper
 using Instruction = rocprofiler::sdk::codeobj::disassembly::Instruction;
 using SymbolInfo  = rocprofiler::sdk::codeobj::disassembly::SymbolInfo;
 
+/**
+ * Decodes the trace of one shader engine. The decoder callbacks only record the instruction
+ * lookups and the waves of the trace so that shader engines can be decoded concurrently. commit()
+ * replays the recorded events into the shared code, wave state and filename outputs. Shader
+ * engines must be committed in file order for the output to match a sequential decode.
+ */
 struct ToolData
 {
-    ToolData(const std::vector<char>& data, WaveConfig& config, std::shared_ptr<class DL> _dl);
+    struct wave_copy_t
+    {
+        att_wave_data_t                     wave{};
+        std::vector<att_wave_instruction_t> instructions{};
+        std::vector<att_wave_state_t>       timeline{};
+    };
+
+    struct trace_event_t
+    {
+        enum kind_t
+        {
+            ISA_LOOKUP = 0,
+            GFXIP,
+            WAVES,
+        };
+
+        kind_t                   kind{ISA_LOOKUP};
+        pcinfo_t                 pc{};
+        size_t                   gfxip{0};
+        std::vector<wave_copy_t> waves{};
+    };
+
+    ToolData(const char* data, size_t size, WaveConfig& config, std::shared_ptr<class DL> _dl);
     ~ToolData();
 
-    CodeLine& get(pcinfo_t pc);
+    void commit();
+
+    CodeLine&                    get(pcinfo_t pc);
+    std::shared_ptr<Instruction> get_instruction(pcinfo_t pc);
 
     std::shared_ptr<CodeFile> cfile{};
     WaveConfig&               config;
     std::shared_ptr<DL>       dl{};
 
-    std::vector<char> shader_data{};
-    size_t            num_waves = 0;
+    std::vector<trace_event_t>                                 events{};
+    std::unordered_map<pcinfo_t, std::shared_ptr<Instruction>> instructions{};
+    size_t                                                     num_waves   = 0;
+    size_t                                                     event_bytes = 0;
+
+private:
+    void add_waves(const att_wave_data_t* waves, size_t num_waves);
 };
 
 }  // namespace att_wrapper
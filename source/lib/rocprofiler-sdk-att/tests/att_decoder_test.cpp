@@ -26,8 +26,15 @@
 #include "lib/rocprofiler-sdk-att/outputfile.hpp"
 #include "lib/rocprofiler-sdk/registration.hpp"
 
+#include "lib/common/environment.hpp"
+#include "lib/common/filesystem.hpp"
+
 #include <gtest/gtest.h>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <map>
+#include <string>
 
 namespace rocprofiler
 {
@@ -110,6 +117,73 @@ TEST(att_decoder_test, warn_failures)
     decoder.parse(".", ".", att_files, codeobjs, "csv,json");
 }
 
+namespace
+{
+namespace fs = ::rocprofiler::common::filesystem;
+
+std::map<std::string, std::string>
+read_directory(const Fspath& dir)
+{
+    auto ret = std::map<std::string, std::string>{};
+    for(const auto& entry : fs::directory_iterator{dir})
+    {
+        auto ifs = std::ifstream{entry.path(), std::ios::binary};
+        ret.emplace(entry.path().filename().string(),
+                    std::string{std::istreambuf_iterator<char>{ifs}, {}});
+    }
+    return ret;
+}
+}  // namespace
+
+TEST(att_decoder_test, parallel_decode_determinism)
+{
+    ATTDecoderTest decoder;
+    ROCP_FATAL_IF(!decoder.valid()) << "Failed to initialize decoder library!";
+
+    const auto input_dir = Fspath{"determinism/input"};
+    fs::remove_all("determinism");
+    fs::create_directories(input_dir);
+
+    // the first byte of each file selects the waves generated by dummy_decoder.cpp
+    auto att_files = std::vector<std::string>{};
+    for(int se = 0; se < 16; se++)
+    {
+        auto name = "trace_" + std::to_string(se) + "_0.att";
+        auto data = std::string(64, '\0');
+        data.at(0) = static_cast<char>(7 * se + 1);
+
+        std::ofstream{input_dir / name, std::ios::binary} << data;
+        att_files.emplace_back(name);
+    }
+
+    auto decode = [&](uint64_t threads, uint64_t memory_limit, const char* output) {
+        common::set_env("ROCPROF_ATT_DECODE_THREADS", threads, 1);
+        common::set_env("ROCPROF_ATT_DECODE_MEMORY_LIMIT", memory_limit, 1);
+
+        OutputFile::Enabled() = true;
+        decoder.parse(input_dir, Fspath{"determinism"} / output, att_files, {}, "json,csv");
+        OutputFile::Enabled() = false;
+
+        return read_directory(Fspath{"determinism"} / output);
+    };
+
+    // a limit of one byte stops the workers running ahead once a decoded shader engine is waiting
+    auto sequential = decode(1, 1UL << 30, "sequential");
+    auto parallel   = decode(4, 1UL << 30, "parallel");
+    auto bounded    = decode(4, 1, "bounded");
+
+    ASSERT_FALSE(sequential.empty());
+    EXPECT_EQ(sequential.size(), parallel.size());
+    EXPECT_EQ(sequential.size(), bounded.size());
+    for(const auto& [name, contents] : sequential)
+    {
+        EXPECT_EQ(parallel.count(name), 1) << name;
+        EXPECT_EQ(bounded.count(name), 1) << name;
+        if(parallel.count(name)) EXPECT_EQ(contents, parallel.at(name)) << name;
+        if(bounded.count(name)) EXPECT_EQ(contents, bounded.at(name)) << name;
+    }
+}
+
 TEST(att_decoder_test, code_write)
 {
     registration::init_logging();
@@ -47,13 +47,17 @@ rocprofiler_att_decoder_parse_data(rocprofiler_att_decoder_se_data_callback_t se
 
         isa_callback(inst.data(), &memory_size, &size, pcinfo_t{0, 0}, userdata);
     }
+    // The first byte of the trace varies the waves so different inputs give different outputs
+    int seed = 0;
     {
         int      se_id       = 0;
         uint8_t* buffer      = nullptr;
         size_t   buffer_size = 0;
 
         while(se_data_callback(&se_id, &buffer, &buffer_size, userdata))
-        {};
+        {
+            if(buffer && buffer_size) seed = buffer[0];
+        };
     }
 
     {
@@ -84,8 +88,8 @@ rocprofiler_att_decoder_parse_data(rocprofiler_att_decoder_se_data_callback_t se
         att_wave_data_t wave{};
         wave.cu = wave.simd = wave.wave_id = wave.traceID = 1;
 
-        wave.begin_time = 0;
-        wave.end_time   = 1024;
+        wave.begin_time = seed;
+        wave.end_time   = 1024 + seed;
 
         std::vector<att_wave_state_t> states;
         for(int j = 0; j < 2; j++)
@@ -97,7 +101,7 @@ rocprofiler_att_decoder_parse_data(rocprofiler_att_decoder_se_data_callback_t se
         {
             att_wave_instruction_t inst{};
             inst.category     = i;
-            inst.duration     = 48;
+            inst.duration     = 48 + seed;
             inst.time         = i * 64 - 32;
             inst.pc.marker_id = 1;
             inst.pc.addr      = 8 * i;
@@ -109,9 +113,11 @@ rocprofiler_att_decoder_parse_data(rocprofiler_att_decoder_se_data_callback_t se
         wave.timeline_array     = states.data();
         wave.timeline_size      = states.size();
 
-        waves.push_back(wave);
-        wave.simd = 2;
-        waves.push_back(wave);
+        for(int i = 0; i < 2 + seed % 3; i++)
+        {
+            wave.simd = 1 + i;
+            waves.push_back(wave);
+        }
 
         trace_callback(ROCPROFILER_ATT_DECODER_TYPE_WAVE, 0, waves.data(), waves.size(), userdata);
     }
@@ -22,6 +22,9 @@
 
 #include <glog/logging.h>
 #include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
 #include <rocprofiler-sdk/cxx/codeobj/code_printing.hpp>
 #include <string_view>
@@ -175,6 +178,138 @@ TEST(codeobj_library, decoder_component)
     }
 }
 
+TEST(codeobj_library, codeobj_view)
+{
+    const std::vector<char>& objdata = codeobjhelper::GetCodeobjContents();
+    constexpr size_t         offset  = 0x10;
+    constexpr size_t         size    = 0x100;
+
+    auto file_view = disassembly::CodeobjView::map_file(CODEOBJ_BINARY_DIR "smallkernel.bin");
+    ASSERT_EQ(file_view->size(), objdata.size());
+    EXPECT_EQ(std::memcmp(file_view->data(), objdata.data(), objdata.size()), 0);
+
+    auto file_uri = std::string{"file://" CODEOBJ_BINARY_DIR "smallkernel.bin"} +
+                    "#offset=" + std::to_string(offset) + "&size=" + std::to_string(size);
+    auto file_binary = disassembly::CodeObjectBinary{file_uri};
+    ASSERT_EQ(file_binary.view->size(), size);
+    EXPECT_EQ(std::memcmp(file_binary.view->data(), objdata.data() + offset, size), 0);
+
+    auto memory_uri = "memory://" + std::to_string(getpid()) +
+                      "#offset=" + std::to_string(reinterpret_cast<uintptr_t>(objdata.data())) +
+                      "&size=" + std::to_string(objdata.size());
+    auto memory_binary = disassembly::CodeObjectBinary{memory_uri};
+    ASSERT_EQ(memory_binary.view->size(), objdata.size());
+    EXPECT_EQ(std::memcmp(memory_binary.view->data(), objdata.data(), objdata.size()), 0);
+
+    // line numbers are only read from the DWARF info when an instruction is disassembled
+    CodeobjDecoderComponent component(file_view);
+    EXPECT_TRUE(component.m_line_number_map.empty());
+}
+
+TEST(codeobj_library, codeobj_cache)
+{
+    const std::vector<char>& objdata = codeobjhelper::GetCodeobjContents();
+
+    char tmp_dir[] = "/tmp/rocprofiler-codeobj-cache-XXXXXX";
+    ASSERT_NE(::mkdtemp(tmp_dir), nullptr);
+    // the missing parent directories of the cache directory are created when it is written
+    auto cache_dir = std::string{tmp_dir} + "/nested/cache";
+    ::setenv("ROCPROFILER_CODEOBJ_CACHE_DIR", cache_dir.c_str(), 1);
+
+    auto get_cache = [&cache_dir, &objdata]() {
+        return disassembly::CodeobjCache{
+            cache_dir, *disassembly::CodeobjView::copy(objdata.data(), objdata.size())};
+    };
+
+    auto disassemble = [&objdata](CodeobjDecoderComponent& component) {
+        auto instructions = std::vector<std::unique_ptr<disassembly::Instruction>>{};
+        for(auto& [kaddr, symbol] : component.m_symbol_map)
+        {
+            for(size_t vaddr = kaddr; vaddr < kaddr + symbol.mem_size;)
+            {
+                auto faddr = component.va2fo(vaddr);
+                if(!faddr) break;
+                instructions.emplace_back(component.disassemble_instruction(*faddr, vaddr));
+                if(instructions.back()->size == 0) break;
+                vaddr += instructions.back()->size;
+            }
+        }
+        return instructions;
+    };
+
+    auto symbols  = std::map<uint64_t, disassembly::SymbolInfo>{};
+    auto expected = std::vector<std::unique_ptr<disassembly::Instruction>>{};
+    {
+        // nothing is written when no instruction was disassembled
+        CodeobjDecoderComponent component(objdata.data(), objdata.size());
+        component.flush_cache();
+        EXPECT_FALSE(get_cache().is_loaded());
+    }
+    {
+        CodeobjDecoderComponent component(objdata.data(), objdata.size());
+        symbols  = component.m_symbol_map;
+        expected = disassemble(component);
+        component.flush_cache();
+    }
+
+    // the second decoder of the same code object reads the symbols and instructions from the
+    // cache written by the flush of the first decoder
+    auto cache = get_cache();
+    ASSERT_TRUE(cache.is_loaded());
+    ASSERT_EQ(cache.get_symbols().size(), symbols.size());
+
+    CodeobjDecoderComponent component(objdata.data(), objdata.size());
+    ASSERT_EQ(component.m_symbol_map.size(), symbols.size());
+    for(auto& [vaddr, symbol] : symbols)
+    {
+        EXPECT_EQ(component.m_symbol_map.at(vaddr).name, symbol.name);
+        EXPECT_EQ(component.m_symbol_map.at(vaddr).mem_size, symbol.mem_size);
+    }
+
+    auto cached = disassemble(component);
+    ASSERT_EQ(cached.size(), expected.size());
+    for(size_t i = 0; i < cached.size(); ++i)
+    {
+        EXPECT_TRUE(cache.find_instruction(cached.at(i)->faddr));
+        EXPECT_EQ(cached.at(i)->inst, expected.at(i)->inst);
+        EXPECT_EQ(cached.at(i)->size, expected.at(i)->size);
+        EXPECT_EQ(cached.at(i)->comment, expected.at(i)->comment);
+    }
+
+    // mapped code objects are keyed by the file identity instead of the contents
+    auto file_view = disassembly::CodeobjView::map_file(CODEOBJ_BINARY_DIR "smallkernel.bin");
+    EXPECT_EQ(disassembly::CodeobjCache::key(*file_view),
+              disassembly::CodeobjCache::key(
+                  *disassembly::CodeobjView::map_file(CODEOBJ_BINARY_DIR "smallkernel.bin")));
+    EXPECT_NE(disassembly::CodeobjCache::key(*file_view),
+              disassembly::CodeobjCache::key(
+                  *disassembly::CodeobjView::copy(objdata.data(), objdata.size())));
+
+    // a cache written by another version of comgr or rocprofiler-sdk is ignored
+    {
+        char name[64] = {};
+        std::snprintf(name,
+                      sizeof(name),
+                      "%016llx-%llx.rpcodeobj",
+                      static_cast<unsigned long long>(disassembly::CodeobjCache::key(
+                          *disassembly::CodeobjView::copy(objdata.data(), objdata.size()))),
+                      static_cast<unsigned long long>(objdata.size()));
+
+        using header_t     = disassembly::CodeobjCache::header_t;
+        auto other_version = disassembly::CodeobjCache::get_toolchain_version() + 1;
+        auto cache_file    = std::fstream{cache_dir + "/" + name,
+                                       std::ios::binary | std::ios::in | std::ios::out};
+        ASSERT_TRUE(cache_file.is_open());
+        cache_file.seekp(offsetof(header_t, toolchain_version));
+        cache_file.write(reinterpret_cast<const char*>(&other_version), sizeof(other_version));
+        cache_file.close();
+
+        EXPECT_FALSE(get_cache().is_loaded());
+    }
+
+    ::unsetenv("ROCPROFILER_CODEOBJ_CACHE_DIR");
+}
+
 TEST(codeobj_library, loaded_codeobj_component)
 {
     const std::vector<char>& objdata = rocprofiler::testing::codeobjhelper::GetCodeobjContents();
@@ -0,0 +1,234 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <gtest/gtest.h>
+#include <rocprofiler-sdk/cxx/codeobj/segment.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+namespace segment = rocprofiler::sdk::codeobj::segment;
+
+using address_range_t = segment::address_range_t;
+
+// the std::set layout which the flat table replaced, used as the benchmark baseline
+class set_table_t : public std::set<address_range_t>
+{
+public:
+    address_range_t find_codeobj_in_range(uint64_t addr)
+    {
+        if(!cached_segment.inrange(addr))
+        {
+            auto it = this->find(address_range_t{addr, 0, 0});
+            if(it == this->end()) throw std::exception();
+            cached_segment = *it;
+        }
+        return cached_segment;
+    }
+
+private:
+    address_range_t cached_segment{};
+};
+
+// synthetic layout of loaded code objects: sizes between 4 KB and 1 MB with page aligned gaps
+std::vector<address_range_t>
+generate_layout(size_t num_codeobjs, uint64_t seed)
+{
+    auto _rng  = std::mt19937_64{seed};
+    auto _size = std::uniform_int_distribution<uint64_t>{1, 256};
+    auto _gap  = std::uniform_int_distribution<uint64_t>{0, 16};
+
+    auto _ranges = std::vector<address_range_t>{};
+    auto _addr   = uint64_t{0x7f0000000000};
+    for(size_t i = 0; i < num_codeobjs; ++i)
+    {
+        auto _range = address_range_t{_addr, _size(_rng) * 4096, i + 1};
+        _ranges.emplace_back(_range);
+        _addr += _range.size + _gap(_rng) * 4096;
+    }
+
+    // code objects are not loaded in address order
+    std::shuffle(_ranges.begin(), _ranges.end(), _rng);
+    return _ranges;
+}
+
+// PCs of instructions from a few kernels at a time, similar to PC samples and ATT records
+std::vector<uint64_t>
+generate_queries(const std::vector<address_range_t>& ranges,
+                 size_t                              num_queries,
+                 size_t                              num_active,
+                 uint64_t                            seed)
+{
+    auto _rng    = std::mt19937_64{seed};
+    auto _active = std::vector<address_range_t>{};
+    for(size_t i = 0; i < num_active; ++i)
+        _active.emplace_back(ranges.at(_rng() % ranges.size()));
+
+    auto _queries = std::vector<uint64_t>{};
+    _queries.reserve(num_queries);
+    for(size_t i = 0; i < num_queries; ++i)
+    {
+        const auto& _range = _active.at(_rng() % _active.size());
+        _queries.emplace_back(_range.addr + (_rng() % _range.size));
+    }
+    return _queries;
+}
+
+template <typename TableT>
+double
+benchmark(TableT& table, const std::vector<uint64_t>& queries)
+{
+    // accumulate the ids so the lookups cannot be optimized away
+    auto _sum = uint64_t{0};
+    auto _beg = std::chrono::steady_clock::now();
+    for(auto itr : queries)
+        _sum += table.find_codeobj_in_range(itr).id;
+    auto _end = std::chrono::steady_clock::now();
+
+    EXPECT_GT(_sum, 0);
+    return std::chrono::duration<double, std::nano>(_end - _beg).count() /
+           static_cast<double>(queries.size());
+}
+}  // namespace
+
+TEST(codeobj_library, find_last_less_equal)
+{
+    auto _data = std::vector<uint64_t>{10, 20, 30, 40, 50};
+    auto _size = _data.size();
+
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), 0, 10), 0);
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), _size, 9), _size);
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), _size, 10), 0);
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), _size, 29), 1);
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), _size, 30), 2);
+    EXPECT_EQ(segment::find_last_less_equal(_data.data(), _size, 1000), 4);
+}
+
+TEST(codeobj_library, segment_lookup)
+{
+    auto _ranges = generate_layout(2000, 42);
+    auto _table  = segment::CodeobjTableTranslator{};
+
+    for(const auto& itr : _ranges)
+        ASSERT_TRUE(_table.insert(itr).second);
+    ASSERT_EQ(_table.size(), _ranges.size());
+
+    // overlapping ranges are rejected
+    for(const auto& itr : _ranges)
+    {
+        EXPECT_FALSE(_table.insert({itr.addr + itr.size - 1, 4096, 0}).second);
+        EXPECT_FALSE(_table.insert({itr.addr - 1, 2, 0}).second);
+    }
+    ASSERT_EQ(_table.size(), _ranges.size());
+
+    for(const auto& itr : _ranges)
+    {
+        EXPECT_EQ(_table.find_codeobj_in_range(itr.addr).id, itr.id);
+        EXPECT_EQ(_table.find_codeobj_in_range(itr.addr + itr.size - 1).id, itr.id);
+        EXPECT_EQ(_table.lookup(itr.addr + itr.size / 2)->id, itr.id);
+        EXPECT_NE(_table.lookup(itr.addr + itr.size).value_or(address_range_t{}).id, itr.id);
+    }
+    EXPECT_FALSE(_table.lookup(0));
+    EXPECT_THROW(_table.find_codeobj_in_range(0), std::exception);
+
+    // removed ranges are no longer returned from the per-thread cache
+    auto _copy = _table;
+    for(size_t i = 0; i < _ranges.size(); i += 2)
+    {
+        const auto& itr = _ranges.at(i);
+        ASSERT_TRUE(_table.lookup(itr.addr));
+        ASSERT_TRUE(_table.remove(itr.addr));
+        EXPECT_FALSE(_table.lookup(itr.addr));
+        EXPECT_FALSE(_table.remove(itr.addr));
+    }
+
+    for(size_t i = 0; i < _ranges.size(); ++i)
+    {
+        const auto& itr = _ranges.at(i);
+        EXPECT_EQ(_table.lookup(itr.addr).has_value(), i % 2 == 1);
+        EXPECT_EQ(_copy.lookup(itr.addr)->id, itr.id);
+    }
+}
+
+TEST(codeobj_library, flat_range_map)
+{
+    auto _map = segment::flat_range_map<std::string>{};
+
+    _map.emplace({0x200, 0x100, 0}, "b");
+    _map.emplace({0x100, 0x80, 0}, "a");
+    _map.emplace({0x300, 0x10, 0}, "c");
+
+    EXPECT_EQ(_map.find(0xff), nullptr);
+    EXPECT_EQ(*_map.find(0x100), "a");
+    EXPECT_EQ(*_map.find(0x17f), "a");
+    EXPECT_EQ(_map.find(0x180), nullptr);
+    EXPECT_EQ(*_map.find(0x2ff), "b");
+    EXPECT_EQ(*_map.find(0x30f), "c");
+    EXPECT_EQ(_map.find(0x310), nullptr);
+
+    // duplicate and overlapping ranges are dropped and the first value is kept
+    EXPECT_FALSE(_map.emplace({0x200, 0x100, 0}, "dup"));
+    EXPECT_FALSE(_map.emplace({0x180, 0x100, 0}, "overlaps b"));
+    EXPECT_FALSE(_map.emplace({0x2f0, 0x80, 0}, "overlaps b and c"));
+    EXPECT_TRUE(_map.emplace({0x180, 0x80, 0}, "d"));
+    EXPECT_EQ(_map.size(), 4);
+    EXPECT_EQ(*_map.find(0x200), "b");
+    EXPECT_EQ(*_map.find(0x2ff), "b");
+    EXPECT_EQ(*_map.find(0x1ff), "d");
+}
+
+TEST(codeobj_library, segment_lookup_benchmark)
+{
+    constexpr size_t num_queries = 1000000;
+
+    for(size_t num_codeobjs : {16, 1024, 16384})
+    {
+        auto _ranges = generate_layout(num_codeobjs, num_codeobjs);
+        auto _flat   = segment::CodeobjTableTranslator{};
+        auto _set    = set_table_t{};
+        for(const auto& itr : _ranges)
+        {
+            _flat.insert(itr);
+            _set.insert(itr);
+        }
+
+        // interleaved PCs from a couple of kernels defeat the single entry cache of std::set
+        // version but fit in the per-thread cache. Uniformly random PCs measure the search.
+        for(size_t num_active : {size_t{1}, size_t{3}, num_codeobjs})
+        {
+            auto _queries = generate_queries(_ranges, num_queries, num_active, num_active);
+            auto _set_ns  = benchmark(_set, _queries);
+            auto _flat_ns = benchmark(_flat, _queries);
+
+            std::cout << "[segment_lookup_benchmark] code objects: " << num_codeobjs
+                      << ", active code objects: " << num_active << ", std::set: " << _set_ns
+                      << " ns/lookup, flat: " << _flat_ns << " ns/lookup\n";
+        }
+    }
+}
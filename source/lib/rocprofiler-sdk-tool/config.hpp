@@ -110,6 +110,8 @@ struct config : output_config
     bool   pc_sampling_host_trap       = false;
     bool   advanced_thread_trace       = get_env("ROCPROF_ADVANCED_THREAD_TRACE", false);
     size_t pc_sampling_interval        = get_env("ROCPROF_PC_SAMPLING_INTERVAL", 1);
+    bool   pc_sampling_aggregate       = get_env("ROCPROF_PC_SAMPLING_AGGREGATE", false);
+    size_t pc_sampling_reservoir_size  = get_env("ROCPROF_PC_SAMPLING_RESERVOIR_SIZE", 0);
     bool   att_serialize_all           = get_env("ROCPROF_ATT_PARAM_SERIALIZE_ALL", false);
     rocprofiler_pc_sampling_method_t pc_sampling_method_value = ROCPROFILER_PC_SAMPLING_METHOD_NONE;
     rocprofiler_pc_sampling_unit_t   pc_sampling_unit_value   = ROCPROFILER_PC_SAMPLING_UNIT_NONE;
@@ -122,6 +124,9 @@ struct config : output_config
     uint64_t att_param_buffer_size = get_env<uint64_t>("ROCPROF_ATT_PARAM_BUFFER_SIZE", 0x6000000);
     uint64_t att_param_simd_select = get_env<uint64_t>("ROCPROF_ATT_PARAM_SIMD_SELECT", 0xF);
     uint64_t att_param_target_cu   = get_env<uint64_t>("ROCPROF_ATT_PARAM_TARGET_CU", 1);
+    uint64_t api_sampling_interval = get_env<uint64_t>("ROCPROF_API_SAMPLING_INTERVAL", 0);
+    uint64_t api_sampling_first    = get_env<uint64_t>("ROCPROF_API_SAMPLING_FIRST", 0);
+    uint64_t api_sampling_rate     = get_env<uint64_t>("ROCPROF_API_SAMPLING_RATE_LIMIT", 0);
 
     std::string kernel_filter_include   = get_env("ROCPROF_KERNEL_FILTER_INCLUDE_REGEX", ".*");
     std::string kernel_filter_exclude   = get_env("ROCPROF_KERNEL_FILTER_EXCLUDE_REGEX", "");
@@ -163,6 +168,11 @@ config::save(ArchiveT& ar) const
     CFG_SERIALIZE_MEMBER(counter_collection);
     CFG_SERIALIZE_MEMBER(hip_runtime_api_trace);
     CFG_SERIALIZE_MEMBER(hip_compiler_api_trace);
+    CFG_SERIALIZE_MEMBER(api_sampling_interval);
+    CFG_SERIALIZE_MEMBER(api_sampling_first);
+    CFG_SERIALIZE_MEMBER(api_sampling_rate);
+    CFG_SERIALIZE_MEMBER(pc_sampling_aggregate);
+    CFG_SERIALIZE_MEMBER(pc_sampling_reservoir_size);
     CFG_SERIALIZE_MEMBER(kernel_rename);
     CFG_SERIALIZE_MEMBER(counters);
     CFG_SERIALIZE_MEMBER(kernel_filter_include);
@@ -31,6 +31,7 @@
 #include "lib/common/synchronized.hpp"
 #include "lib/common/units.hpp"
 #include "lib/common/utility.hpp"
+#include "lib/output/aggregate.hpp"
 #include "lib/output/buffered_output.hpp"
 #include "lib/output/counter_info.hpp"
 #include "lib/output/csv.hpp"
@@ -53,6 +54,7 @@
 #include <rocprofiler-sdk/buffer_tracing.h>
 #include <rocprofiler-sdk/callback_tracing.h>
 #include <rocprofiler-sdk/experimental/counters.h>
+#include <rocprofiler-sdk/experimental/tracing.h>
 #include <rocprofiler-sdk/external_correlation.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/internal_threading.h>
@@ -61,6 +63,8 @@
 #include <rocprofiler-sdk/cxx/hash.hpp>
 #include <rocprofiler-sdk/cxx/operators.hpp>
 
+#include <PTL/TaskGroup.hh>
+#include <PTL/ThreadPool.hh>
 #include <fmt/core.h>
 
 #include <sys/mman.h>
@@ -71,12 +75,14 @@
 #include <csignal>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <future>
 #include <iomanip>
 #include <limits>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <string_view>
 #include <thread>
 #include <type_traits>
 #include <unordered_map>
@@ -207,6 +213,32 @@ thread_local auto thread_dispatch_rename_dtor = common::scope_destructor{[]() {
     thread_dispatch_rename = nullptr;
 }};
 
+// the durations of these domains are aggregated in-process when --aggregate is enabled
+constexpr bool
+is_aggregated_domain(domain_type type)
+{
+    return (type != domain_type::COUNTER_COLLECTION && type != domain_type::COUNTER_VALUES &&
+            type != domain_type::PC_SAMPLING_HOST_TRAP);
+}
+
+bool
+is_aggregated(domain_type type)
+{
+    return (tool::get_config().aggregate && is_aggregated_domain(type));
+}
+
+// in aggregation mode, the record is accumulated into the per-thread histograms of the calling
+// thread instead of being written to the tmp file of the domain
+template <typename Tp>
+void
+write_record(const Tp& record, domain_type type)
+{
+    if(is_aggregated(type))
+        tool::aggregate(tool::get_config(), *tool_metadata, record);
+    else
+        tool::write_ring_buffer(record, type);
+}
+
 bool
 add_kernel_target(uint64_t _kern_id, const std::unordered_set<uint32_t>& range)
 {
@@ -415,7 +447,7 @@ cntrl_tracing_callback(rocprofiler_callback_tracing_record_t record,
             marker_record.correlation_id  = record.correlation_id;
             marker_record.start_timestamp = user_data->value;
             marker_record.end_timestamp   = ts;
-            tool::write_ring_buffer(marker_record, domain_type::MARKER);
+            write_record(marker_record, domain_type::MARKER);
         }
     }
 }
@@ -493,7 +525,7 @@ callback_tracing_callback(rocprofiler_callback_tracing_record_t record,
                 marker_record.correlation_id  = record.correlation_id;
                 marker_record.start_timestamp = ts;
                 marker_record.end_timestamp   = ts;
-                tool::write_ring_buffer(marker_record, domain_type::MARKER);
+                write_record(marker_record, domain_type::MARKER);
             }
         }
         else if(record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangePushA)
@@ -532,7 +564,7 @@ callback_tracing_callback(rocprofiler_callback_tracing_record_t record,
                 stacked_range.pop_back();
 
                 val.end_timestamp = ts;
-                tool::write_ring_buffer(val, domain_type::MARKER);
+                write_record(val, domain_type::MARKER);
             }
         }
         else if(record.operation == ROCPROFILER_MARKER_CORE_API_ID_roctxRangeStartA)
@@ -571,7 +603,7 @@ callback_tracing_callback(rocprofiler_callback_tracing_record_t record,
                     [](const auto& map, auto _key) { return map.at(_key); }, _id);
 
                 _entry.end_timestamp = ts;
-                tool::write_ring_buffer(_entry, domain_type::MARKER);
+                write_record(_entry, domain_type::MARKER);
                 global_range.wlock([](auto& map, auto _key) { return map.erase(_key); }, _id);
             }
         }
@@ -591,7 +623,7 @@ callback_tracing_callback(rocprofiler_callback_tracing_record_t record,
                 marker_record.correlation_id  = record.correlation_id;
                 marker_record.start_timestamp = user_data->value;
                 marker_record.end_timestamp   = ts;
-                tool::write_ring_buffer(marker_record, domain_type::MARKER);
+                write_record(marker_record, domain_type::MARKER);
             }
         }
     }
@@ -775,7 +807,7 @@ buffered_tracing_callback(rocprofiler_context_id_t /*context*/,
                 auto* record = static_cast<rocprofiler_buffer_tracing_kernel_dispatch_record_t*>(
                     header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::KERNEL_DISPATCH);
+                write_record(*record, domain_type::KERNEL_DISPATCH);
             }
 
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_HSA_CORE_API ||
@@ -786,28 +818,28 @@ buffered_tracing_callback(rocprofiler_context_id_t /*context*/,
                 auto* record =
                     static_cast<rocprofiler_buffer_tracing_hsa_api_record_t*>(header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::HSA);
+                write_record(*record, domain_type::HSA);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_MEMORY_COPY)
             {
                 auto* record =
                     static_cast<rocprofiler_buffer_tracing_memory_copy_record_t*>(header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::MEMORY_COPY);
+                write_record(*record, domain_type::MEMORY_COPY);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_MEMORY_ALLOCATION)
             {
                 auto* record = static_cast<rocprofiler_buffer_tracing_memory_allocation_record_t*>(
                     header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::MEMORY_ALLOCATION);
+                write_record(*record, domain_type::MEMORY_ALLOCATION);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_SCRATCH_MEMORY)
             {
                 auto* record = static_cast<rocprofiler_buffer_tracing_scratch_memory_record_t*>(
                     header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::SCRATCH_MEMORY);
+                write_record(*record, domain_type::SCRATCH_MEMORY);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API ||
                     header->kind == ROCPROFILER_BUFFER_TRACING_HIP_COMPILER_API)
@@ -815,21 +847,21 @@ buffered_tracing_callback(rocprofiler_context_id_t /*context*/,
                 auto* record =
                     static_cast<rocprofiler_buffer_tracing_hip_api_record_t*>(header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::HIP);
+                write_record(*record, domain_type::HIP);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_RCCL_API)
             {
                 auto* record =
                     static_cast<rocprofiler_buffer_tracing_rccl_api_record_t*>(header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::RCCL);
+                write_record(*record, domain_type::RCCL);
             }
             else if(header->kind == ROCPROFILER_BUFFER_TRACING_ROCDECODE_API)
             {
                 auto* record = static_cast<rocprofiler_buffer_tracing_rocdecode_api_record_t*>(
                     header->payload);
 
-                tool::write_ring_buffer(*record, domain_type::ROCDECODE);
+                write_record(*record, domain_type::ROCDECODE);
             }
             else
             {
@@ -957,6 +989,48 @@ get_instruction_index(rocprofiler_pc_t pc)
         return CHECK_NOTNULL(tool_metadata)->get_instruction_index(pc);
 }
 
+// HIP/HSA API sampling requested via --api-sampling-* options (if any)
+std::optional<rocprofiler_tracing_sampling_config_t>
+get_api_sampling_config()
+{
+    constexpr auto one_second = std::chrono::nanoseconds{std::chrono::seconds{1}}.count();
+
+    auto _cfg     = common::init_public_api_struct(rocprofiler_tracing_sampling_config_t{});
+    _cfg.interval = std::max<uint64_t>(tool::get_config().api_sampling_interval, 1);
+    _cfg.count    = tool::get_config().api_sampling_first;
+
+    if(tool::get_config().api_sampling_rate > 0)
+    {
+        _cfg.policy = ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET;
+        _cfg.count  = tool::get_config().api_sampling_rate;
+        _cfg.period = one_second;
+    }
+    else if(tool::get_config().api_sampling_first > 0 && _cfg.interval > 1)
+        _cfg.policy = ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH;
+    else if(_cfg.interval > 1)
+        _cfg.policy = ROCPROFILER_TRACING_SAMPLING_EVERY_NTH;
+    else
+    {
+        ROCP_WARNING_IF(tool::get_config().api_sampling_first > 0)
+            << "ROCPROF_API_SAMPLING_FIRST has no effect without ROCPROF_API_SAMPLING_INTERVAL "
+               "greater than 1, every API call is traced";
+        return std::nullopt;
+    }
+
+    return _cfg;
+}
+
+void
+configure_api_sampling(rocprofiler_buffer_tracing_kind_t kind)
+{
+    static const auto sampling_cfg = get_api_sampling_config();
+
+    if(!sampling_cfg) return;
+
+    ROCPROFILER_CALL(rocprofiler_configure_buffer_tracing_sampling(
+                         get_client_ctx(), kind, nullptr, 0, &sampling_cfg.value()),
+                     "buffer tracing sampling configure");
+}
 }  // namespace
 
 std::vector<rocprofiler_att_parameter_t>
@@ -1021,8 +1095,12 @@ rocprofiler_pc_sampling_callback(rocprofiler_context_id_t /* context_id*/,
                     rocprofiler::tool::rocprofiler_tool_pc_sampling_host_trap_record_t(
                         *pc_sample, get_instruction_index(pc_sample->pc));
 
-                rocprofiler::tool::write_ring_buffer(pc_sample_tool_record,
-                                                     domain_type::PC_SAMPLING_HOST_TRAP);
+                if(tool::get_config().pc_sampling_aggregate)
+                    tool::aggregate(pc_sample_tool_record,
+                                    tool::get_config().pc_sampling_reservoir_size);
+                else
+                    tool::write_ring_buffer(pc_sample_tool_record,
+                                            domain_type::PC_SAMPLING_HOST_TRAP);
             }
         }
         else
@@ -1371,6 +1449,7 @@ tool_init(rocprofiler_client_finalize_t fini_func, void* tool_data)
                     rocprofiler_configure_buffer_tracing_service(
                         get_client_ctx(), itr.second, nullptr, 0, get_buffers().hsa_api_trace),
                     "buffer tracing service for hsa api configure");
+                configure_api_sampling(itr.second);
             }
         }
     }
@@ -1426,6 +1505,7 @@ tool_init(rocprofiler_client_finalize_t fini_func, void* tool_data)
                                  0,
                                  get_buffers().hip_api_trace),
                              "buffer tracing service for hip api configure");
+            configure_api_sampling(ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API);
         }
 
         if(tool::get_config().hip_compiler_api_trace)
@@ -1437,6 +1517,7 @@ tool_init(rocprofiler_client_finalize_t fini_func, void* tool_data)
                                  0,
                                  get_buffers().hip_api_trace),
                              "buffer tracing service for hip compiler api configure");
+            configure_api_sampling(ROCPROFILER_BUFFER_TRACING_HIP_COMPILER_API);
         }
     }
 
@@ -1605,28 +1686,145 @@ using domain_stats_vec_t = tool::domain_stats_vec_t;
 
 template <typename Tp, domain_type DomainT>
 void
-generate_output(tool::buffered_output<Tp, DomainT>& output_v, domain_stats_vec_t& contributions_v)
+generate_stats_output(tool::buffered_output<Tp, DomainT>& output_v,
+                      const tool::aggregate_map_t&         aggregates)
 {
     if(!output_v) return;
 
     output_v.read();
 
-    if(tool::get_config().stats || tool::get_config().summary_output)
+    if(is_aggregated(DomainT))
+    {
+        output_v.stats =
+            tool::generate_stats(tool::get_config(), *tool_metadata, DomainT, aggregates);
+    }
+    else if(tool::get_config().stats || tool::get_config().summary_output)
     {
         output_v.stats =
             tool::generate_stats(tool::get_config(), *tool_metadata, output_v.get_generator());
     }
+}
+
+template <typename Tp, domain_type DomainT>
+void
+generate_csv_output(tool::buffered_output<Tp, DomainT>& output_v)
+{
+    if(!output_v) return;
 
-    if(output_v.stats)
+    if(is_aggregated(DomainT))
     {
-        contributions_v.emplace_back(output_v.buffer_type_v, output_v.stats);
+        tool::generate_csv(tool::get_config(), DomainT, output_v.stats);
+        return;
     }
 
-    if(tool::get_config().csv_output)
+    tool::generate_csv(
+        tool::get_config(), *tool_metadata, output_v.get_generator(), output_v.stats);
+}
+
+struct finalize_task
+{
+    std::string_view      name = {};  // output sink the task belongs to
+    std::function<void()> func = {};
+};
+
+using finalize_task_vec_t = std::vector<finalize_task>;
+
+// the statistics, the output sinks, and the per-domain tasks of a sink are executed on a single
+// thread pool bounded by the hardware concurrency. Each sink reads the tmp files through its own
+// generators and each domain is written to separate files so the tasks are independent.
+PTL::ThreadPool::Config
+get_finalize_pool_config(size_t max_tasks)
+{
+    auto _ncpu           = std::max(std::thread::hardware_concurrency(), 1U);
+    auto _config         = PTL::ThreadPool::Config{};
+    _config.init         = true;
+    _config.use_tbb      = false;
+    _config.use_affinity = false;
+    _config.pool_size    = std::max<size_t>(std::min<size_t>(max_tasks, _ncpu), 1);
+    _config.initializer  = []() {};
+    _config.finalizer    = []() {};
+    return _config;
+}
+
+// executes the tasks and reports the time spent in each output sink. The tasks are not
+// interrupted when one of them fails: every failure is reported once all the tasks have
+// completed and the first one is rethrown.
+void
+execute_finalize_tasks(PTL::ThreadPool& pool, finalize_task_vec_t&& tasks)
+{
+    using clock_type    = std::chrono::steady_clock;
+    using duration_type = std::chrono::duration<double>;
+
+    if(tasks.empty()) return;
+
+    auto _elapsed    = std::vector<double>(tasks.size(), 0.0);
+    auto _exceptions = std::vector<std::exception_ptr>(tasks.size(), nullptr);
+    auto _execute    = [&tasks, &_elapsed, &_exceptions](size_t idx) {
+        auto _beg = clock_type::now();
+        try
+        {
+            tasks.at(idx).func();
+        } catch(...)
+        {
+            _exceptions.at(idx) = std::current_exception();
+        }
+        _elapsed.at(idx) = duration_type{clock_type::now() - _beg}.count();
+    };
+
+    auto _beg = clock_type::now();
+    if(tasks.size() == 1)
+    {
+        _execute(0);
+    }
+    else
     {
-        tool::generate_csv(
-            tool::get_config(), *tool_metadata, output_v.get_generator(), output_v.stats);
+        auto _task_group = PTL::TaskGroup<void>{&pool};
+        for(size_t i = 0; i < tasks.size(); ++i)
+            _task_group.exec([&_execute, i]() { _execute(i); });
+        _task_group.join();
     }
+    auto _total = duration_type{clock_type::now() - _beg}.count();
+
+    // the time of a sink is the sum of the time of its tasks
+    auto _names = std::vector<std::string_view>{};
+    for(const auto& itr : tasks)
+    {
+        if(std::find(_names.begin(), _names.end(), itr.name) == _names.end())
+            _names.emplace_back(itr.name);
+    }
+
+    for(const auto& nitr : _names)
+    {
+        auto _sink_elapsed = 0.0;
+        for(size_t i = 0; i < tasks.size(); ++i)
+            if(tasks.at(i).name == nitr) _sink_elapsed += _elapsed.at(i);
+
+        ROCP_INFO << fmt::format(
+            "rocprofv3 finalize: {:<8} output generated in {:.3f} sec", nitr, _sink_elapsed);
+    }
+    ROCP_INFO << fmt::format(
+        "rocprofv3 finalize: {} output sink(s) completed in {:.3f} sec", _names.size(), _total);
+
+    auto _first = std::exception_ptr{};
+    for(size_t i = 0; i < tasks.size(); ++i)
+    {
+        if(!_exceptions.at(i)) continue;
+        if(!_first) _first = _exceptions.at(i);
+
+        try
+        {
+            std::rethrow_exception(_exceptions.at(i));
+        } catch(std::exception& _e)
+        {
+            ROCP_ERROR << "rocprofv3 failed to generate " << tasks.at(i).name
+                       << " output: " << _e.what();
+        } catch(...)
+        {
+            ROCP_ERROR << "rocprofv3 failed to generate " << tasks.at(i).name << " output";
+        }
+    }
+
+    if(_first) std::rethrow_exception(_first);
 }
 
 void
@@ -1672,30 +1870,49 @@ tool_fini(void* /*tool_data*/)
     auto _agents = CHECK_NOTNULL(tool_metadata)->agents;
     std::sort(_agents.begin(), _agents.end(), node_id_sort);
 
-    if(tool::get_config().csv_output)
-    {
-        tool::generate_csv(tool::get_config(), *tool_metadata, _agents);
-    }
+    auto for_each_output = [&](auto&& _func) {
+        _func(kernel_dispatch_output);
+        _func(hsa_output);
+        _func(hip_output);
+        _func(memory_copy_output);
+        _func(memory_allocation_output);
+        _func(marker_output);
+        _func(rccl_output);
+        _func(counters_output);
+        _func(scratch_memory_output);
+        _func(rocdecode_output);
+        _func(pc_sampling_host_trap_output);
+    };
 
-    auto contributions = domain_stats_vec_t{};
+    // the PC samples only store the index of their instruction, the unique instructions are
+    // disassembled once all samples have been collected
+    if(tool::get_config().pc_sampling_host_trap) tool_metadata->decode_instructions();
 
-    generate_output(kernel_dispatch_output, contributions);
-    generate_output(hsa_output, contributions);
-    generate_output(hip_output, contributions);
-    generate_output(memory_copy_output, contributions);
-    generate_output(memory_allocation_output, contributions);
-    generate_output(marker_output, contributions);
-    generate_output(rccl_output, contributions);
-    generate_output(counters_output, contributions);
-    generate_output(scratch_memory_output, contributions);
-    generate_output(rocdecode_output, contributions);
-    generate_output(pc_sampling_host_trap_output, contributions);
-
-    if(tool::get_config().stats && tool::get_config().csv_output)
+    // in PC sampling aggregation mode, the reservoir samples are the only raw samples written
+    auto pc_sample_aggregates = tool::pc_sample_aggregate_map_t{};
+    if(tool::get_config().pc_sampling_host_trap && tool::get_config().pc_sampling_aggregate)
     {
-        tool::generate_csv(tool::get_config(), *tool_metadata, contributions);
+        pc_sample_aggregates = tool::get_pc_sample_aggregates();
+        for(const auto& itr :
+            tool::get_pc_sample_reservoir(tool::get_config().pc_sampling_reservoir_size))
+            tool::write_ring_buffer(itr, domain_type::PC_SAMPLING_HOST_TRAP);
     }
 
+    auto contributions = domain_stats_vec_t{};
+    auto aggregates    = (tool::get_config().aggregate) ? tool::get_aggregates()
+                                                        : tool::aggregate_map_t{};
+
+    // the statistics are included in the CSV, JSON, and summary outputs so they must be complete
+    // before any of the output sinks are started
+    auto stats_tasks = finalize_task_vec_t{};
+    for_each_output([&stats_tasks, &aggregates](auto& _output_v) {
+        if(_output_v)
+            stats_tasks.emplace_back(finalize_task{
+                "stats", [&_output_v, &aggregates]() {
+                    generate_stats_output(_output_v, aggregates);
+                }});
+    });
+
     if(tool::get_config().advanced_thread_trace)
     {
         std::unordered_map<std::string_view, rocprofiler::att_wrapper::tool_att_capability_t>
@@ -1730,80 +1947,150 @@ tool_fini(void* /*tool_data*/)
         }
     }
 
-    if(tool::get_config().json_output)
+    // the CSV output of each domain is a separate task so the CSV sink is not executed as a
+    // single task: the domains are spread over the pool with the other sinks
+    auto sinks = finalize_task_vec_t{};
+
+    if(tool::get_config().csv_output)
     {
-        auto json_ar = tool::open_json(tool::get_config());
-
-        json_ar.start_process();
-        tool::write_json(json_ar, tool::get_config(), *tool_metadata, getpid());
-        tool::write_json(json_ar,
-                         tool::get_config(),
-                         *tool_metadata,
-                         contributions,
-                         hip_output.get_generator(),
-                         hsa_output.get_generator(),
-                         kernel_dispatch_output.get_generator(),
-                         memory_copy_output.get_generator(),
-                         counters_output.get_generator(),
-                         marker_output.get_generator(),
-                         scratch_memory_output.get_generator(),
-                         rccl_output.get_generator(),
-                         memory_allocation_output.get_generator(),
-                         pc_sampling_host_trap_output.get_generator(),
-                         rocdecode_output.get_generator());
-        json_ar.finish_process();
-
-        tool::close_json(json_ar);
-    }
-
-    if(tool::get_config().pftrace_output)
+        auto _csv_sink = [&]() {
+            tool::generate_csv(tool::get_config(), *tool_metadata, _agents);
+            if(tool::get_config().stats)
+            {
+                tool::generate_csv(tool::get_config(), *tool_metadata, contributions);
+            }
+            if(tool::get_config().aggregate)
+            {
+                tool::generate_csv(tool::get_config(), *tool_metadata, aggregates);
+            }
+            if(!pc_sample_aggregates.empty())
+            {
+                tool::generate_csv(tool::get_config(), *tool_metadata, pc_sample_aggregates);
+            }
+        };
+        sinks.emplace_back(finalize_task{"csv", std::move(_csv_sink)});
+        for_each_output([&sinks](auto& _output_v) {
+            if(_output_v)
+                sinks.emplace_back(
+                    finalize_task{"csv", [&_output_v]() { generate_csv_output(_output_v); }});
+        });
+    }
+
+    if(tool::get_config().json_output)
     {
-        tool::write_perfetto(tool::get_config(),
+        auto _json_sink = [&]() {
+            auto json_ar = tool::open_json(tool::get_config());
+
+            json_ar.start_process();
+            tool::write_json(json_ar, tool::get_config(), *tool_metadata, getpid());
+            tool::write_json(json_ar,
+                             tool::get_config(),
                              *tool_metadata,
-                             _agents,
+                             contributions,
                              hip_output.get_generator(),
                              hsa_output.get_generator(),
                              kernel_dispatch_output.get_generator(),
                              memory_copy_output.get_generator(),
+                             counters_output.get_generator(),
                              marker_output.get_generator(),
                              scratch_memory_output.get_generator(),
                              rccl_output.get_generator(),
                              memory_allocation_output.get_generator(),
+                             pc_sampling_host_trap_output.get_generator(),
                              rocdecode_output.get_generator());
+            tool::write_json(json_ar, tool::get_config(), *tool_metadata, pc_sample_aggregates);
+            json_ar.finish_process();
+
+            tool::close_json(json_ar);
+        };
+        sinks.emplace_back(finalize_task{"json", std::move(_json_sink)});
+    }
+
+    if(!pc_sample_aggregates.empty() && !tool::get_config().csv_output &&
+       !tool::get_config().json_output)
+    {
+        ROCP_WARNING << "the per-instruction PC sample table is only written by the CSV and JSON "
+                        "output formats, it is discarded";
+    }
+
+    if(tool::get_config().aggregate &&
+       (tool::get_config().pftrace_output || tool::get_config().otf2_output))
+    {
+        ROCP_WARNING << "rocprofv3 does not write perfetto or OTF2 traces when records are "
+                        "aggregated in-process";
     }
 
-    if(tool::get_config().otf2_output)
+    if(tool::get_config().pftrace_output && !tool::get_config().aggregate)
     {
-        auto hip_elem_data               = hip_output.load_all();
-        auto hsa_elem_data               = hsa_output.load_all();
-        auto kernel_dispatch_elem_data   = kernel_dispatch_output.load_all();
-        auto memory_copy_elem_data       = memory_copy_output.load_all();
-        auto marker_elem_data            = marker_output.load_all();
-        auto scratch_memory_elem_data    = scratch_memory_output.load_all();
-        auto rccl_elem_data              = rccl_output.load_all();
-        auto memory_allocation_elem_data = memory_allocation_output.load_all();
-        auto rocdecode_elem_data         = rocdecode_output.load_all();
-
-        tool::write_otf2(tool::get_config(),
-                         *tool_metadata,
-                         getpid(),
-                         _agents,
-                         &hip_elem_data,
-                         &hsa_elem_data,
-                         &kernel_dispatch_elem_data,
-                         &memory_copy_elem_data,
-                         &marker_elem_data,
-                         &scratch_memory_elem_data,
-                         &rccl_elem_data,
-                         &memory_allocation_elem_data,
-                         &rocdecode_elem_data);
+        auto _pftrace_sink = [&]() {
+            tool::write_perfetto(tool::get_config(),
+                                 *tool_metadata,
+                                 _agents,
+                                 hip_output.get_generator(),
+                                 hsa_output.get_generator(),
+                                 kernel_dispatch_output.get_generator(),
+                                 memory_copy_output.get_generator(),
+                                 marker_output.get_generator(),
+                                 scratch_memory_output.get_generator(),
+                                 rccl_output.get_generator(),
+                                 memory_allocation_output.get_generator(),
+                                 rocdecode_output.get_generator());
+        };
+        sinks.emplace_back(finalize_task{"pftrace", std::move(_pftrace_sink)});
+    }
+
+    if(tool::get_config().otf2_output && !tool::get_config().aggregate)
+    {
+        auto _otf2_sink = [&]() {
+            auto hip_elem_data               = hip_output.load_all();
+            auto hsa_elem_data               = hsa_output.load_all();
+            auto kernel_dispatch_elem_data   = kernel_dispatch_output.load_all();
+            auto memory_copy_elem_data       = memory_copy_output.load_all();
+            auto marker_elem_data            = marker_output.load_all();
+            auto scratch_memory_elem_data    = scratch_memory_output.load_all();
+            auto rccl_elem_data              = rccl_output.load_all();
+            auto memory_allocation_elem_data = memory_allocation_output.load_all();
+            auto rocdecode_elem_data         = rocdecode_output.load_all();
+
+            tool::write_otf2(tool::get_config(),
+                             *tool_metadata,
+                             getpid(),
+                             _agents,
+                             &hip_elem_data,
+                             &hsa_elem_data,
+                             &kernel_dispatch_elem_data,
+                             &memory_copy_elem_data,
+                             &marker_elem_data,
+                             &scratch_memory_elem_data,
+                             &rccl_elem_data,
+                             &memory_allocation_elem_data,
+                             &rocdecode_elem_data);
+        };
+        sinks.emplace_back(finalize_task{"otf2", std::move(_otf2_sink)});
     }
 
     if(tool::get_config().summary_output)
     {
-        tool::generate_stats(tool::get_config(), *tool_metadata, contributions);
+        auto _summary_sink = [&]() {
+            tool::generate_stats(tool::get_config(), *tool_metadata, contributions);
+        };
+        sinks.emplace_back(finalize_task{"summary", std::move(_summary_sink)});
     }
 
+    auto _pool =
+        PTL::ThreadPool{get_finalize_pool_config(std::max(stats_tasks.size(), sinks.size()))};
+    auto _pool_dtor = common::scope_destructor{[&_pool]() { _pool.destroy_threadpool(); }};
+
+    execute_finalize_tasks(_pool, std::move(stats_tasks));
+
+    // contributions are appended in a fixed domain order to keep the outputs deterministic
+    for_each_output([&contributions](auto& _output_v) {
+        if(_output_v && _output_v.stats)
+            contributions.emplace_back(_output_v.buffer_type_v, _output_v.stats);
+    });
+
+    execute_finalize_tasks(_pool, std::move(sinks));
+
     auto destroy_output = [](auto& _buffered_output_v) { _buffered_output_v.destroy(); };
 
     destroy_output(kernel_dispatch_output);
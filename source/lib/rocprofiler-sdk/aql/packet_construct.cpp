@@ -260,5 +260,14 @@ CounterPacketConstruct::can_collect()
     }
     return ROCPROFILER_STATUS_SUCCESS;
 }
+
+int64_t
+CounterPacketConstruct::block_limit(const counters::Metric& metric) const
+{
+    // Every instance of a block has the same limit
+    const auto& events = get_counter_events(metric);
+    if(events.empty()) return 0;
+    return get_block_counters(_agent, events.front());
+}
 }  // namespace aql
 }  // namespace rocprofiler
@@ -83,6 +83,8 @@ public:
     rocprofiler_agent_id_t agent() const { return _agent; }
 
     rocprofiler_status_t can_collect();
+    // Number of counters of the block of the metric that can be collected together
+    int64_t block_limit(const counters::Metric&) const;
 
 private:
     static constexpr size_t MEM_PAGE_ALIGN = 0x1000;
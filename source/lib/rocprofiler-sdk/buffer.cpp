@@ -32,13 +32,16 @@
 #include "lib/rocprofiler-sdk/pc_sampling/service.hpp"
 #include "lib/rocprofiler-sdk/registration.hpp"
 
+#include <rocprofiler-sdk/experimental/buffer.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include <algorithm>
 #include <atomic>
 #include <exception>
 #include <mutex>
 #include <random>
+#include <utility>
 #include <vector>
 
 namespace rocprofiler
@@ -67,8 +70,124 @@ get_buffer_offset()
     }();
     return _v;
 }
+
+template <typename ContainerT>
+void
+invoke_buffer_callback(const instance* buff_v, ContainerT& buff_data)
+{
+    try
+    {
+        if(buff_v->callback)
+        {
+            buff_v->callback(rocprofiler_context_id_t{buff_v->context_id},
+                             rocprofiler_buffer_id_t{buff_v->buffer_id},
+                             buff_data.data(),
+                             buff_data.size(),
+                             buff_v->callback_data,
+                             buff_v->drop_count);
+        }
+    } catch(std::exception& e)
+    {
+        ROCP_ERROR << "buffer callback threw an exception: " << e.what();
+    }
+}
+
+// lanes owned by the current thread. Marks the lanes as inactive when the thread exits so that
+// they can be adopted by another thread
+struct thread_lane_cache
+{
+    using value_type = std::pair<uint64_t, std::shared_ptr<thread_lane>>;
+
+    ~thread_lane_cache()
+    {
+        for(auto& itr : lanes)
+            itr.second->active.store(false, std::memory_order_release);
+    }
+
+    std::vector<value_type> lanes = {};
+};
 }  // namespace
 
+void
+instance::allocate_internal_buffers(size_t num_buffers, size_t max_pool_bytes)
+{
+    num_buffers = std::min(std::max<size_t>(num_buffers, 1), buffers.size());
+    for(size_t i = 0; i < buffers.size(); ++i)
+    {
+        if(i < num_buffers)
+            buffers.at(i).allocate(size);
+        else
+            buffers.at(i).reset();
+    }
+
+    buffer_count.store(num_buffers);
+    buffer_idx.store(0);
+    max_bytes = std::max<uint64_t>(max_pool_bytes, num_buffers * size);
+}
+
+uint32_t
+instance::acquire_spare_buffer(uint32_t idx)
+{
+    auto _count = buffer_count.load(std::memory_order_acquire);
+    for(uint32_t i = 1; i < _count; ++i)
+    {
+        auto _idx = (idx + i) % _count;
+        if(!in_flight.at(_idx).load(std::memory_order_acquire)) return _idx;
+    }
+
+    // grow the pool if the memory cap allows it
+    if(size > 0 && _count < buffers.size() && (_count + 1) * size <= max_bytes)
+    {
+        buffers.at(_count).allocate(size);
+        buffer_count.store(_count + 1, std::memory_order_release);
+        ROCP_INFO << "buffer " << buffer_id << " grew to " << (_count + 1)
+                  << " internal buffers";
+        return _count;
+    }
+
+    return npos;
+}
+
+instance::lane_t*
+instance::get_thread_lane()
+{
+    static thread_local auto _cache = thread_lane_cache{};
+
+    // the number of buffers is small so a linear search is cheaper than hashing
+    for(const auto& itr : _cache.lanes)
+    {
+        if(itr.first == buffer_id) return itr.second.get();
+    }
+
+    auto _lk   = std::unique_lock<std::mutex>{lanes_mutex};
+    auto _lane = std::shared_ptr<lane_t>{};
+    for(auto& itr : lanes)
+    {
+        auto _expected = false;
+        if(itr->active.compare_exchange_strong(_expected, true, std::memory_order_acq_rel))
+        {
+            _lane = itr;
+            break;
+        }
+    }
+
+    if(!_lane) _lane = lanes.emplace_back(std::make_shared<lane_t>(size));
+
+    _cache.lanes.emplace_back(buffer_id, _lane);
+    return _lane.get();
+}
+
+std::vector<std::pair<instance::lane_t*, uint64_t>>
+instance::acquire_lanes(record_vec_t& _headers) const
+{
+    auto _lk  = std::unique_lock<std::mutex>{lanes_mutex};
+    auto _ret = std::vector<std::pair<lane_t*, uint64_t>>{};
+    _ret.reserve(lanes.size());
+    for(const auto& itr : lanes)
+        _ret.emplace_back(itr.get(), itr->lane.acquire(_headers));
+    return _ret;
+}
+
 bool
 is_valid_buffer_id(rocprofiler_buffer_id_t id)
 {
@@ -173,7 +292,56 @@ flush(rocprofiler_buffer_id_t buffer_id, bool wait)
         }
     }
 
-    auto idx = buff->buffer_idx++;
+    if(buff->mode == ROCPROFILER_BUFFER_MODE_PER_THREAD)
+    {
+        // the lanes have a single consumer so the syncer is held until the task completes
+        auto _task = [buffer_id, offset]() {
+            ROCP_ERROR_IF(registration::get_fini_status() > 0)
+                << "executing buffer (" << buffer_id.handle << ") flush task finalization!";
+
+            auto& buff_v = CHECK_NOTNULL(get_buffers())->at(buffer_id.handle - offset);
+
+            // merge the records published by every thread lane
+            auto buff_data = instance::record_vec_t{};
+            auto lanes     = buff_v->acquire_lanes(buff_data);
+
+            if(!buff_data.empty())
+                invoke_buffer_callback(buff_v.get(), buff_data);
+            else
+                ROCP_INFO << "buffer at " << buffer_id.handle << " is empty...";
+
+            // make the space available to the producers again
+            for(auto& [lane, pos] : lanes)
+                lane->lane.release(pos);
+
+            buff_v->syncer.clear();
+        };
+
+        task_group->exec(std::move(_task));
+        if(wait)
+        {
+            task_group->join();
+        }
+
+        return ROCPROFILER_STATUS_SUCCESS;
+    }
+
+    auto idx = buff->buffer_idx.load(std::memory_order_acquire);
+    if(idx == instance::npos)
+    {
+        // every internal buffer is already being flushed
+        buff->syncer.clear();
+        if(!wait) return ROCPROFILER_STATUS_ERROR_BUFFER_BUSY;
+        task_group->join();
+        return ROCPROFILER_STATUS_SUCCESS;
+    }
+
+    // swap in a spare buffer so that producers can continue while this one is being flushed.
+    // If there is no spare buffer, producers drop or block (depending on the policy) until a
+    // flush task completes and hands its buffer back
+    buff->in_flight.at(idx).store(true, std::memory_order_release);
+    buff->buffer_idx.store(buff->acquire_spare_buffer(idx), std::memory_order_release);
+    buff->syncer.clear();
 
     auto _task = [buffer_id, idx, offset]() {
         ROCP_ERROR_IF(registration::get_fini_status() > 0)
@@ -182,36 +350,29 @@ flush(rocprofiler_buffer_id_t buffer_id, bool wait)
         auto& buff_v          = CHECK_NOTNULL(get_buffers())->at(buffer_id.handle - offset);
         auto& buff_internal_v = buff_v->get_internal_buffer(idx);
 
+        // wait for producers which loaded the index before the swap to finish
+        buff_internal_v.seal();
+
         if(!buff_internal_v.is_empty())
         {
-            // get the array of record headers
-            auto buff_data = buff_internal_v.get_record_headers();
+            // get a view of the array of record headers
+            auto buff_data = buff_internal_v.get_record_header_view();
 
             // invoke buffer callback
-            try
-            {
-                if(buff_v->callback)
-                {
-                    buff_v->callback(rocprofiler_context_id_t{buff_v->context_id},
-                                     rocprofiler_buffer_id_t{buff_v->buffer_id},
-                                     buff_data.data(),
-                                     buff_data.size(),
-                                     buff_v->callback_data,
-                                     buff_v->drop_count);
-                }
-            } catch(std::exception& e)
-            {
-                ROCP_ERROR << "buffer callback threw an exception: " << e.what();
-            }
-            // clear the buffer
-            buff_internal_v.clear();
+            invoke_buffer_callback(buff_v.get(), buff_data);
         }
         else
         {
             ROCP_INFO << "buffer at " << buffer_id.handle << " is empty...";
         }
 
-        buff_v->syncer.clear();
+        // clear the buffer and re-enable emplacing into it
+        buff_internal_v.clear();
+        buff_v->in_flight.at(idx).store(false, std::memory_order_release);
+
+        // if the producers were left without a buffer, hand them this one
+        auto _expected = instance::npos;
+        buff_v->buffer_idx.compare_exchange_strong(_expected, idx, std::memory_order_acq_rel);
     };
 
     task_group->exec(std::move(_task));
@@ -253,11 +414,7 @@ rocprofiler_create_buffer(rocprofiler_context_id_t        context,
     auto& buff = CHECK_NOTNULL(rocprofiler::buffer::get_buffers())
                      ->at(opt_buff_id->handle - rocprofiler::buffer::get_buffer_offset());
 
-    // allocate the buffers. if it is lossless, we allocate a second buffer to store data while
-    // other buffer is being flushed
-    buff->buffers.front().allocate(size);
-    if(action == ROCPROFILER_BUFFER_POLICY_LOSSLESS) buff->buffers.back().allocate(size);
-
+    buff->size          = size;
     buff->watermark     = watermark;
     buff->policy        = action;
     buff->callback      = callback;
@@ -266,6 +423,88 @@ rocprofiler_create_buffer(rocprofiler_context_id_t        context,
     buff->buffer_id     = buffer_id->handle;
     buff->buffer_idx    = 0;
 
+    // allocate the buffers. if it is lossless, we allocate a second buffer to store data while
+    // other buffer is being flushed. The pool can be reconfigured via rocprofiler_set_buffer_pool
+    auto num_buffers = (action == ROCPROFILER_BUFFER_POLICY_LOSSLESS) ? 2 : 1;
+    buff->allocate_internal_buffers(num_buffers, 0);
+
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+rocprofiler_status_t
+rocprofiler_set_buffer_mode(rocprofiler_buffer_id_t buffer_id, rocprofiler_buffer_mode_t mode)
+{
+    if(rocprofiler::registration::get_init_status() > -1)
+        return ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED;
+
+    if(mode < ROCPROFILER_BUFFER_MODE_SHARED || mode >= ROCPROFILER_BUFFER_MODE_LAST)
+        return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    auto* buff = rocprofiler::buffer::get_buffer(buffer_id);
+    if(!buff) return ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND;
+
+    if(buff->mode == mode) return ROCPROFILER_STATUS_SUCCESS;
+
+    if(mode == ROCPROFILER_BUFFER_MODE_PER_THREAD)
+    {
+        // the shared buffers are no longer used, lanes are allocated on first use by each thread
+        for(auto& itr : buff->buffers)
+            itr.reset();
+        buff->buffer_idx = 0;
+    }
+    else
+    {
+        buff->allocate_internal_buffers(buff->buffer_count.load(), buff->max_bytes);
+    }
+
+    buff->mode = mode;
+
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+rocprofiler_status_t
+rocprofiler_set_buffer_pool(rocprofiler_buffer_id_t buffer_id,
+                            size_t                  num_buffers,
+                            size_t                  max_bytes)
+{
+    if(rocprofiler::registration::get_init_status() > -1)
+        return ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED;
+
+    if(num_buffers == 0 || num_buffers > rocprofiler::buffer::instance::max_buffer_count)
+        return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    auto* buff = rocprofiler::buffer::get_buffer(buffer_id);
+    if(!buff) return ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND;
+
+    if(buff->mode == ROCPROFILER_BUFFER_MODE_PER_THREAD)
+    {
+        // only record the configuration, the internal buffers are not used in this mode
+        buff->buffer_count = num_buffers;
+        buff->max_bytes    = std::max<uint64_t>(max_bytes, num_buffers * buff->size);
+    }
+    else
+    {
+        buff->allocate_internal_buffers(num_buffers, max_bytes);
+    }
+
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+rocprofiler_status_t
+rocprofiler_query_buffer_stats(rocprofiler_buffer_id_t buffer_id, rocprofiler_buffer_stats_t* stats)
+{
+    if(!stats) return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    auto* buff = rocprofiler::buffer::get_buffer(buffer_id);
+    if(!buff) return ROCPROFILER_STATUS_ERROR_BUFFER_NOT_FOUND;
+
+    *stats             = rocprofiler_buffer_stats_t{};
+    stats->size        = sizeof(rocprofiler_buffer_stats_t);
+    stats->num_buffers = buff->buffer_count.load(std::memory_order_acquire);
+    stats->drop_count  = buff->drop_count.load(std::memory_order_relaxed);
+    stats->stall_count = buff->stall_count.load(std::memory_order_relaxed);
+    stats->stall_ns    = buff->stall_ns.load(std::memory_order_relaxed);
+
     return ROCPROFILER_STATUS_SUCCESS;
 }
 
@@ -296,9 +535,23 @@ rocprofiler_destroy_buffer(rocprofiler_buffer_id_t buffer_id)
     // buffer is currently being flushed or destroyed
     if(buff->syncer.test_and_set()) return ROCPROFILER_STATUS_ERROR_BUFFER_BUSY;
 
+    for(const auto& itr : buff->in_flight)
+    {
+        if(itr.load(std::memory_order_acquire))
+        {
+            buff->syncer.clear();
+            return ROCPROFILER_STATUS_ERROR_BUFFER_BUSY;
+        }
+    }
+
     for(auto& itr : buff->buffers)
         itr.reset();
 
+    {
+        auto _lk = std::unique_lock<std::mutex>{buff->lanes_mutex};
+        buff->lanes.clear();
+    }
+
     buff->syncer.clear();
     buff.reset();
 
@@ -26,39 +26,106 @@
 #include <rocprofiler-sdk/fwd.h>
 
 #include "lib/common/container/record_header_buffer.hpp"
+#include "lib/common/container/record_header_lane.hpp"
 #include "lib/common/container/stable_vector.hpp"
 #include "lib/common/demangle.hpp"
+#include "lib/common/utility.hpp"
 
 #include <array>
 #include <atomic>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
+#include <thread>
+#include <vector>
 
 namespace rocprofiler
 {
 namespace buffer
 {
+/// lane written to by a single producer thread when the buffer is in
+/// ROCPROFILER_BUFFER_MODE_PER_THREAD mode. When the owning thread exits, the lane is marked
+/// inactive and the next thread which writes to the buffer adopts it (records still in the lane
+/// are preserved and delivered by the next flush).
+struct thread_lane
+{
+    explicit thread_lane(size_t nbytes)
+    : lane{nbytes}
+    {}
+
+    common::container::record_header_lane lane   = {};
+    std::atomic<bool>                     active = {true};
+};
+
 struct instance
 {
-    using buffer_t = common::container::record_header_buffer;
+    using buffer_t     = common::container::record_header_buffer;
+    using lane_t       = thread_lane;
+    using lane_vec_t   = std::vector<std::shared_ptr<lane_t>>;
+    using record_vec_t = buffer_t::record_ptr_vec_t;
 
-    mutable std::array<buffer_t, 2> buffers       = {};
+    // maximum number of internal buffers in the pool
+    static constexpr size_t max_buffer_count = 16;
+    // value of buffer_idx when every internal buffer is being flushed
+    static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+    using buffer_array_t = std::array<buffer_t, max_buffer_count>;
+    using in_flight_t    = std::array<std::atomic<bool>, max_buffer_count>;
+
+    mutable buffer_array_t          buffers       = {};
+    mutable in_flight_t             in_flight     = {};  // internal buffer is being flushed
+    mutable std::mutex              lanes_mutex   = {};
+    mutable lane_vec_t              lanes         = {};
     mutable std::atomic_flag        syncer        = ATOMIC_FLAG_INIT;
-    mutable std::atomic<uint32_t>   buffer_idx    = {};  // array index
+    mutable std::atomic<uint32_t>   buffer_idx    = {};   // array index
+    mutable std::atomic<uint32_t>   buffer_count  = {1};  // number of internal buffers
     mutable std::atomic<uint64_t>   drop_count    = {};
+    mutable std::atomic<uint64_t>   stall_count   = {};  // number of times a producer blocked
+    mutable std::atomic<uint64_t>   stall_ns      = {};  // time producers were blocked
     uint64_t                        watermark     = 0;
     uint64_t                        context_id    = 0;  // rocprofiler_context_id_t value
     uint64_t                        buffer_id     = 0;  // rocprofiler_buffer_id_t value
     uint64_t                        task_group_id = 0;  // thread-pool assignment
     rocprofiler_buffer_tracing_cb_t callback      = nullptr;
     void*                           callback_data = nullptr;
+    uint64_t                        size          = 0;  // requested size in bytes
+    uint64_t                        max_bytes     = 0;  // memory cap for the internal buffers
     rocprofiler_buffer_policy_t     policy        = ROCPROFILER_BUFFER_POLICY_NONE;
+    rocprofiler_buffer_mode_t       mode          = ROCPROFILER_BUFFER_MODE_SHARED;
 
     template <typename Tp>
     bool emplace(uint32_t, uint32_t, Tp&);
 
     buffer_t& get_internal_buffer();
     buffer_t& get_internal_buffer(size_t);
+
+    // allocates the first N internal buffers of the pool and sets the memory cap
+    void allocate_internal_buffers(size_t num_buffers, size_t max_pool_bytes);
+
+    // returns the index of an internal buffer, other than the given index, which is not being
+    // flushed. Allocates a new internal buffer if none are available and the memory cap allows
+    // it. Returns npos if every internal buffer is being flushed. Only invoked while holding the
+    // syncer.
+    uint32_t acquire_spare_buffer(uint32_t idx);
+
+    // returns the lane owned by the calling thread, creating or adopting one if necessary
+    lane_t* get_thread_lane();
+
+    // appends the headers of every record in the lanes to the given vector and returns the
+    // lanes with the position to release them to after the records have been consumed
+    std::vector<std::pair<lane_t*, uint64_t>> acquire_lanes(record_vec_t&) const;
+
+private:
+    template <typename Tp>
+    bool emplace_internal_buffer(uint32_t, uint32_t, Tp&);
+
+    template <typename Tp>
+    bool emplace_thread_lane(uint32_t, uint32_t, Tp&);
+
+    template <typename Tp>
+    void check_record_size(size_t, const Tp&) const;
 };
 
 using unique_buffer_vec_t = common::container::stable_vector<std::unique_ptr<instance>, 4>;
@@ -111,35 +178,110 @@ rocprofiler::buffer::flush(uint64_t buffer_idx, bool wait)
     return flush(rocprofiler_buffer_id_t{buffer_idx}, wait);
 }
 
+template <typename Tp>
+inline void
+rocprofiler::buffer::instance::check_record_size(size_t capacity, const Tp& value) const
+{
+    if(capacity < sizeof(value))
+    {
+        auto msg = std::stringstream{};
+        msg << "buffer " << buffer_id << " to small (size=" << capacity
+            << ") to hold an object of type " << common::cxx_demangle(typeid(value).name())
+            << " with size " << sizeof(value);
+        throw std::runtime_error(msg.str());
+    }
+}
+
 template <typename Tp>
 inline bool
 rocprofiler::buffer::instance::emplace(uint32_t category, uint32_t kind, Tp& value)
 {
-    // get the index of the current buffer
-    auto get_idx = [this]() { return buffer_idx.load(std::memory_order_acquire) % buffers.size(); };
+    if(mode == ROCPROFILER_BUFFER_MODE_PER_THREAD)
+        return emplace_thread_lane(category, kind, value);
+
+    return emplace_internal_buffer(category, kind, value);
+}
 
-    auto idx     = get_idx();
-    auto success = buffers.at(idx).emplace(category, kind, value);
+template <typename Tp>
+inline bool
+rocprofiler::buffer::instance::emplace_internal_buffer(uint32_t category, uint32_t kind, Tp& value)
+{
+    auto try_emplace = [this, category, kind, &value](uint32_t& _idx) {
+        while(_idx != npos)
+        {
+            if(buffers.at(_idx).emplace(category, kind, value)) return true;
+            // buffer was handed off to be flushed after the index was loaded
+            if(!buffers.at(_idx).is_sealed()) return false;
+            _idx = buffer_idx.load(std::memory_order_acquire);
+        }
+        return false;
+    };
+
+    // get the index of the current buffer
+    auto idx     = buffer_idx.load(std::memory_order_acquire);
+    auto success = try_emplace(idx);
     if(!success)
     {
-        if(buffers.at(idx).capacity() < sizeof(value))
+        if(idx != npos) check_record_size(buffers.at(idx).capacity(), value);
+
+        if(policy == ROCPROFILER_BUFFER_POLICY_LOSSLESS)
+        {
+            // hand the full buffer off to the flushing thread and swap in a spare buffer. This
+            // only blocks when every internal buffer is being flushed and the pool cannot grow
+            buffer::flush(buffer_id, false);
+            idx     = buffer_idx.load(std::memory_order_acquire);
+            success = try_emplace(idx);
+
+            if(!success)
+            {
+                auto _beg = common::timestamp_ns();
+                do
+                {
+                    std::this_thread::yield();
+                    buffer::flush(buffer_id, false);
+                    idx     = buffer_idx.load(std::memory_order_acquire);
+                    success = try_emplace(idx);
+                } while(!success);
+                stall_ns.fetch_add(common::timestamp_ns() - _beg, std::memory_order_relaxed);
+                stall_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        else
         {
-            auto msg = std::stringstream{};
-            msg << "buffer " << buffer_id << " to small (size=" << buffers.at(idx).capacity()
-                << ") to hold an object of type " << common::cxx_demangle(typeid(value).name())
-                << " with size " << sizeof(value);
-            throw std::runtime_error(msg.str());
+            ++drop_count;
         }
+    }
+
+    if(idx != npos && buffers.at(idx).count() >= watermark)
+    {
+        // flush without syncing
+        buffer::flush(buffer_id, false);
+    }
+
+    return success;
+}
+
+template <typename Tp>
+inline bool
+rocprofiler::buffer::instance::emplace_thread_lane(uint32_t category, uint32_t kind, Tp& value)
+{
+    auto& _lane   = get_thread_lane()->lane;
+    auto  success = _lane.emplace(category, kind, value);
+    if(!success)
+    {
+        check_record_size(_lane.capacity(), value);
 
         if(policy == ROCPROFILER_BUFFER_POLICY_LOSSLESS)
         {
-            // blocks until buffer is flushed
+            // blocks until the lane is drained
+            auto _beg = common::timestamp_ns();
             do
             {
                 buffer::flush(buffer_id, true);
-                idx     = get_idx();
-                success = buffers.at(idx).emplace(category, kind, value);
+                success = _lane.emplace(category, kind, value);
             } while(!success);
+            stall_ns.fetch_add(common::timestamp_ns() - _beg, std::memory_order_relaxed);
+            stall_count.fetch_add(1, std::memory_order_relaxed);
         }
         else
         {
@@ -147,7 +289,7 @@ rocprofiler::buffer::instance::emplace(uint32_t category, uint32_t kind, Tp& val
         }
     }
 
-    if(buffers.at(idx).count() >= watermark)
+    if(_lane.count() >= watermark)
     {
         // flush without syncing
         buffer::flush(buffer_id, false);
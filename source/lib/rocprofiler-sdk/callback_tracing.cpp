@@ -37,6 +37,7 @@
 #include "lib/rocprofiler-sdk/runtime_initialization.hpp"
 
 #include <rocprofiler-sdk/callback_tracing.h>
+#include <rocprofiler-sdk/experimental/tracing.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/hip/table_id.h>
 #include <rocprofiler-sdk/hsa/table_id.h>
@@ -157,6 +158,35 @@ rocprofiler_configure_callback_tracing_service(rocprofiler_context_id_t
     return ROCPROFILER_STATUS_SUCCESS;
 }
 
+rocprofiler_status_t
+rocprofiler_configure_callback_tracing_sampling(
+    rocprofiler_context_id_t                     context_id,
+    rocprofiler_callback_tracing_kind_t          kind,
+    const rocprofiler_tracing_operation_t*       operations,
+    size_t                                       operations_count,
+    const rocprofiler_tracing_sampling_config_t* config)
+{
+    if(rocprofiler::registration::get_init_status() > -1)
+        return ROCPROFILER_STATUS_ERROR_CONFIGURATION_LOCKED;
+
+    if(!rocprofiler::context::supports_sampling(kind))
+        return ROCPROFILER_STATUS_ERROR_KIND_NOT_FOUND;
+
+    if(!config) return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    auto* ctx = rocprofiler::context::get_mutable_registered_context(context_id);
+
+    if(!ctx) return ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_FOUND;
+
+    if(!ctx->callback_tracer || !ctx->callback_tracer->domains(kind))
+        return ROCPROFILER_STATUS_ERROR_CONTEXT_INVALID;
+
+    auto ops = std::vector<uint32_t>{};
+    if(operations) ops.assign(operations, operations + operations_count);
+
+    return rocprofiler::context::add_sampling(ctx->callback_tracer->sampling, kind, ops, *config);
+}
+
 rocprofiler_status_t
 rocprofiler_query_callback_tracing_kind_name(rocprofiler_callback_tracing_kind_t kind,
                                              const char**                        name,
@@ -103,6 +103,47 @@ get_active_contexts_impl()
     static auto* _v = new active_context_vec_t{reserve_size_t{active_context_vec_t::chunk_size}};
     return *_v;
 }
+
+std::atomic<const active_tracing_contexts*>&
+get_active_tracing_contexts_impl()
+{
+    using snapshot_ptr_t = std::atomic<const active_tracing_contexts*>;
+
+    static auto* _v = new snapshot_ptr_t{new active_tracing_contexts{}};
+    return *_v;
+}
+
+// every published snapshot is kept alive since readers do not hold a reference to it. Contexts
+// are rarely started/stopped so this only grows by one snapshot per change
+auto&
+get_tracing_snapshots()
+{
+    static auto* _v = new std::deque<std::unique_ptr<active_tracing_contexts>>{};
+    return *_v;
+}
+
+// requires get_contexts_mutex() to be held
+void
+update_active_tracing_contexts()
+{
+    auto _snapshot = std::make_unique<active_tracing_contexts>();
+
+    _snapshot->epoch = get_active_tracing_contexts_impl().load()->epoch + 1;
+    for(auto& itr : get_active_contexts_impl())
+    {
+        const auto* ctx = itr.load(std::memory_order_acquire);
+        if(!ctx || (!ctx->callback_tracer && !ctx->buffered_tracer)) continue;
+
+        _snapshot->contexts.emplace_back(ctx);
+        if(ctx->callback_tracer)
+            merge_domains(_snapshot->callback_domains, ctx->callback_tracer->domains);
+        if(ctx->buffered_tracer)
+            merge_domains(_snapshot->buffered_domains, ctx->buffered_tracer->domains);
+    }
+
+    get_active_tracing_contexts_impl().store(_snapshot.get(), std::memory_order_release);
+    get_tracing_snapshots().emplace_back(std::move(_snapshot));
+}
 }  // namespace
 
 context_array_t&
@@ -172,6 +213,12 @@ get_active_contexts(context_filter_t filter)
     return data;
 }
 
+const active_tracing_contexts&
+get_active_tracing_contexts()
+{
+    return *get_active_tracing_contexts_impl().load(std::memory_order_acquire);
+}
+
 // set the client index needs to be called before allocate_context()
 void
 push_client(uint32_t value)
@@ -322,6 +369,11 @@ start_context(rocprofiler_context_id_t context_id)
         return ROCPROFILER_STATUS_ERROR_CONTEXT_NOT_STARTED;
     }
 
+    {
+        auto _lk = std::unique_lock<std::mutex>{get_contexts_mutex()};
+        update_active_tracing_contexts();
+    }
+
     auto status = ROCPROFILER_STATUS_SUCCESS;
 
     if(cfg->counter_collection) rocprofiler::counters::start_context(cfg);
@@ -355,6 +407,8 @@ stop_context(rocprofiler_context_id_t idx)
                 auto nactive = get_num_active_contexts().load(std::memory_order_acquire);
                 if(nactive > 0) get_num_active_contexts().fetch_sub(1, std::memory_order_release);
 
+                update_active_tracing_contexts();
+
                 if(_expected->counter_collection)
                 {
                     rocprofiler::counters::stop_context(const_cast<context*>(_expected));
@@ -406,6 +460,8 @@ stop_client_contexts(rocprofiler_client_id_t client_id)
 void
 deactivate_client_contexts(rocprofiler_client_id_t client_id)
 {
+    auto _lk = std::unique_lock<std::mutex>{get_contexts_mutex()};
+
     for(auto& itr : get_active_contexts_impl())
     {
         const auto* itr_v = itr.load();
@@ -414,6 +470,8 @@ deactivate_client_contexts(rocprofiler_client_id_t client_id)
             itr.store(nullptr);
         }
     }
+
+    update_active_tracing_contexts();
 }
 
 void
@@ -30,6 +30,7 @@
 #include "lib/common/synchronized.hpp"
 #include "lib/rocprofiler-sdk/context/correlation_id.hpp"
 #include "lib/rocprofiler-sdk/context/domain.hpp"
+#include "lib/rocprofiler-sdk/context/sampling.hpp"
 #include "lib/rocprofiler-sdk/counters/core.hpp"
 #include "lib/rocprofiler-sdk/counters/device_counting.hpp"
 #include "lib/rocprofiler-sdk/external_correlation.hpp"
@@ -63,8 +64,9 @@ struct callback_tracing_service
     using domain_t         = rocprofiler_callback_tracing_kind_t;
     using callback_array_t = std::array<callback_data, domain_info<domain_t>::last>;
 
-    domain_context<domain_t> domains       = {};
-    callback_array_t         callback_data = {};
+    domain_context<domain_t>   domains       = {};
+    callback_array_t           callback_data = {};
+    tracing_sampling<domain_t> sampling      = {};
 };
 
 struct buffer_tracing_service
@@ -72,8 +74,9 @@ struct buffer_tracing_service
     using domain_t       = rocprofiler_buffer_tracing_kind_t;
     using buffer_array_t = std::array<rocprofiler_buffer_id_t, domain_info<domain_t>::last>;
 
-    domain_context<domain_t> domains     = {};
-    buffer_array_t           buffer_data = {};
+    domain_context<domain_t>   domains     = {};
+    buffer_array_t             buffer_data = {};
+    tracing_sampling<domain_t> sampling    = {};
 };
 
 struct dispatch_counter_collection_service
@@ -199,6 +202,22 @@ get_active_contexts(context_array_t& data, context_filter_t filter = default_con
 context_array_t
 get_active_contexts(context_filter_t filter = default_context_filter);
 
+/// \brief immutable snapshot of the active contexts with a callback or buffered tracing service
+///  and the union of the domains and operations they trace. A new snapshot with an incremented
+///  epoch is published whenever the set of active contexts changes.
+struct active_tracing_contexts
+{
+    uint64_t                                            epoch            = 0;
+    context_array_t                                     contexts         = {};
+    domain_context<rocprofiler_callback_tracing_kind_t> callback_domains = {};
+    domain_context<rocprofiler_buffer_tracing_kind_t>   buffered_domains = {};
+};
+
+/// \brief returns the current snapshot with a single acquire load. Snapshots are never freed so
+///  the reference remains valid even if the set of active contexts changes while it is in use.
+const active_tracing_contexts&
+get_active_tracing_contexts();
+
 /// \brief disable the contexturation.
 rocprofiler_status_t
 stop_client_contexts(rocprofiler_client_id_t id);
@@ -21,6 +21,7 @@
 // SOFTWARE.
 
 #include "lib/rocprofiler-sdk/context/correlation_id.hpp"
+#include "lib/common/environment.hpp"
 #include "lib/common/static_object.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
 #include "lib/rocprofiler-sdk/context/context.hpp"
@@ -28,20 +29,118 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace context
 {
 namespace
 {
+// number of retired correlation ids a thread caches before returning half of them to the
+// global free-list. Correlation ids are frequently retired on a different thread than the one
+// which created them (e.g. kernel dispatches retire on the HSA async signal handler thread) so
+// the global free-list is what moves them back to the creating thread.
+constexpr size_t correlation_id_cache_size = 256;
+
+struct correlation_id_pool
+{
+    using storage_type = common::container::stable_vector<std::unique_ptr<correlation_id>>;
+
+    std::mutex                   mutex     = {};
+    storage_type                 storage   = {};
+    std::vector<correlation_id*> free_list = {};
+};
+
+struct correlation_id_cache
+{
+    correlation_id_cache() { data.reserve(correlation_id_cache_size); }
+    ~correlation_id_cache();
+
+    correlation_id_cache(const correlation_id_cache&) = delete;
+    correlation_id_cache(correlation_id_cache&&)      = delete;
+    correlation_id_cache& operator=(const correlation_id_cache&) = delete;
+    correlation_id_cache& operator=(correlation_id_cache&&) = delete;
+
+    std::vector<correlation_id*> data = {};
+};
+
 auto*&
-get_correlation_id_map()
+get_correlation_id_pool()
+{
+    static auto*& _v = common::static_object<correlation_id_pool>::construct();
+    return _v;
+}
+
+auto&
+get_correlation_id_cache()
+{
+    static thread_local auto _v = correlation_id_cache{};
+    return _v;
+}
+
+bool
+correlation_id_never_free()
+{
+    static const auto _v = common::get_env("ROCPROFILER_CORRELATION_ID_NEVER_FREE", false);
+    return _v;
+}
+
+correlation_id_cache::~correlation_id_cache()
+{
+    // hand the cached correlation ids of an exiting thread back to the global free-list
+    auto* _pool = get_correlation_id_pool();
+    if(!_pool || data.empty()) return;
+
+    auto _lk = std::unique_lock<std::mutex>{_pool->mutex};
+    _pool->free_list.insert(_pool->free_list.end(), data.begin(), data.end());
+    data.clear();
+}
+
+correlation_id*
+acquire_correlation_id()
 {
-    using data_type  = common::container::stable_vector<std::unique_ptr<correlation_id>>;
-    static auto*& _v = common::static_object<common::Synchronized<data_type>>::construct();
+    auto& _cache = get_correlation_id_cache().data;
+    if(_cache.empty())
+    {
+        auto* _pool = get_correlation_id_pool();
+        if(!_pool) return nullptr;
+
+        auto  _lk  = std::unique_lock<std::mutex>{_pool->mutex};
+        auto& _fl  = _pool->free_list;
+        auto  _num = std::min<size_t>(_fl.size(), correlation_id_cache_size / 2);
+        if(_num == 0) return _pool->storage.emplace_back(std::make_unique<correlation_id>()).get();
+
+        _cache.insert(_cache.end(), _fl.end() - _num, _fl.end());
+        _fl.resize(_fl.size() - _num);
+    }
+
+    auto* _v = _cache.back();
+    _cache.pop_back();
     return _v;
 }
 
+void
+release_correlation_id(correlation_id* _corr_id)
+{
+    if(correlation_id_never_free()) return;
+
+    auto& _cache = get_correlation_id_cache().data;
+    _cache.emplace_back(_corr_id);
+    if(_cache.size() < correlation_id_cache_size) return;
+
+    auto* _pool = get_correlation_id_pool();
+    if(!_pool) return;
+
+    auto _half = _cache.begin() + (correlation_id_cache_size / 2);
+    auto _lk   = std::unique_lock<std::mutex>{_pool->mutex};
+    _pool->free_list.insert(_pool->free_list.end(), _half, _cache.end());
+    _cache.erase(_half, _cache.end());
+}
+
 auto&
 get_latest_correlation_id_impl()
 {
@@ -82,14 +181,14 @@ correlation_id::sub_ref_count()
                         ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT)));
         });
 
-        auto record = rocprofiler_buffer_tracing_correlation_id_retirement_record_t{
-            .size      = sizeof(rocprofiler_buffer_tracing_correlation_id_retirement_record_t),
-            .kind      = ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT,
-            .timestamp = common::timestamp_ns(),
-            .internal_correlation_id = internal};
-
         if(!ctxs.empty())
         {
+            auto record = rocprofiler_buffer_tracing_correlation_id_retirement_record_t{
+                .size      = sizeof(rocprofiler_buffer_tracing_correlation_id_retirement_record_t),
+                .kind      = ROCPROFILER_BUFFER_TRACING_CORRELATION_ID_RETIREMENT,
+                .timestamp = common::timestamp_ns(),
+                .internal_correlation_id = internal};
+
             for(const auto* itr : ctxs)
             {
                 auto* _buffer = buffer::get_buffer(itr->buffered_tracer->buffer_data.at(
@@ -103,11 +202,23 @@ correlation_id::sub_ref_count()
                 ROCP_FATAL_IF(!success) << "failed to emplace correlation id retirement";
             }
         }
+
+        // nothing may reference this correlation id after it has been retired
+        release_correlation_id(this);
     }
 
     return _ret;
 }
 
+void
+correlation_id::reset(uint32_t _cnt, rocprofiler_thread_id_t _tid, uint64_t _internal) noexcept
+{
+    thread_idx = _tid;
+    internal   = _internal;
+    m_kern_count.store(0);
+    m_ref_count.store(_cnt);
+}
+
 uint32_t
 correlation_id::add_kern_count()
 {
@@ -125,15 +236,13 @@ correlation_tracing_service::construct(uint32_t _init_ref_count)
 {
     ROCP_FATAL_IF(_init_ref_count == 0) << "must have reference count > 0";
 
-    auto  _internal_id = get_unique_internal_id();
-    auto* corr_id_map  = get_correlation_id_map();
-    if(!corr_id_map) return nullptr;
-    auto& ret = corr_id_map->wlock([](auto& data) -> auto& { return data.emplace_back(); });
-    ret       = std::make_unique<correlation_id>(_init_ref_count, common::get_tid(), _internal_id);
+    auto* ret = acquire_correlation_id();
+    if(!ret) return nullptr;
 
-    get_latest_correlation_id_impl().emplace_back(ret.get());
+    ret->reset(_init_ref_count, common::get_tid(), get_unique_internal_id());
+    get_latest_correlation_id_impl().emplace_back(ret);
 
-    return ret.get();
+    return ret;
 }
 
 correlation_id*
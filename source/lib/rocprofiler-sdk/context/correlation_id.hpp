@@ -71,6 +71,9 @@ struct correlation_id
     uint32_t add_kern_count();
     uint32_t sub_kern_count();
 
+    // re-initializes a correlation id taken from the recycling pool
+    void reset(uint32_t _cnt, rocprofiler_thread_id_t _tid, uint64_t _internal) noexcept;
+
 private:
     std::atomic<uint32_t> m_kern_count = {0};
     std::atomic<uint32_t> m_ref_count  = {0};
@@ -96,6 +99,11 @@ dump_correlation_stack(const char*);
 
 /// permits tools opportunity to modify the correlation id based on the domain, op, and
 /// the rocprofiler generated correlation id
+///
+/// correlation ids returned by construct are owned by a pool: once the reference count reaches
+/// zero, the correlation id is retired and handed back to a per-thread free-list for reuse.
+/// Setting ROCPROFILER_CORRELATION_ID_NEVER_FREE=1 disables the recycling (every correlation id
+/// is kept alive until finalization) which is useful when debugging reference counting errors.
 struct correlation_tracing_service
 {
     external_correlation::external_correlation external_correlator = {};
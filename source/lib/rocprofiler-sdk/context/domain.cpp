@@ -87,6 +87,31 @@ add_domain_op(domain_context<DomainT>& _cfg, DomainT _domain, uint32_t _op)
     return ROCPROFILER_STATUS_SUCCESS;
 }
 
+template <typename DomainT>
+void
+merge_domains(domain_context<DomainT>& _dst, const domain_context<DomainT>& _src)
+{
+    constexpr uint64_t one = 1;
+
+    for(int64_t _didx = 0; _didx < _src.array_size; ++_didx)
+    {
+        if(((one << _didx) & _src.domains) == 0) continue;
+
+        auto&       _dst_ops = _dst.opcodes.at(_didx);
+        const auto& _src_ops = _src.opcodes.at(_didx);
+
+        // no opcodes set means every operation in the domain is enabled
+        if(((one << _didx) & _dst.domains) == 0)
+            _dst_ops = _src_ops;
+        else if(_dst_ops.none() || _src_ops.none())
+            _dst_ops.reset();
+        else
+            _dst_ops |= _src_ops;
+
+        _dst.domains |= (one << _didx);
+    }
+}
+
 // instantiate the templates
 template struct domain_context<rocprofiler_callback_tracing_kind_t>;
 
@@ -111,5 +136,15 @@ template rocprofiler_status_t
 add_domain_op<rocprofiler_buffer_tracing_kind_t>(domain_context<rocprofiler_buffer_tracing_kind_t>&,
                                                  rocprofiler_buffer_tracing_kind_t,
                                                  uint32_t);
+
+template void
+merge_domains<rocprofiler_callback_tracing_kind_t>(
+    domain_context<rocprofiler_callback_tracing_kind_t>&,
+    const domain_context<rocprofiler_callback_tracing_kind_t>&);
+
+template void
+merge_domains<rocprofiler_buffer_tracing_kind_t>(
+    domain_context<rocprofiler_buffer_tracing_kind_t>&,
+    const domain_context<rocprofiler_buffer_tracing_kind_t>&);
 }  // namespace context
 }  // namespace rocprofiler
@@ -93,5 +93,10 @@ add_domain(domain_context<DomainT>&, DomainT);
 template <typename DomainT>
 rocprofiler_status_t
 add_domain_op(domain_context<DomainT>&, DomainT, uint32_t);
+
+/// merge the domains and operations enabled in the second argument into the first
+template <typename DomainT>
+void
+merge_domains(domain_context<DomainT>&, const domain_context<DomainT>&);
 }  // namespace context
 }  // namespace rocprofiler
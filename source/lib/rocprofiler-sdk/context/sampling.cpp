@@ -0,0 +1,192 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/context/sampling.hpp"
+#include "lib/common/utility.hpp"
+
+#include <rocprofiler-sdk/fwd.h>
+
+#include <algorithm>
+
+namespace rocprofiler
+{
+namespace context
+{
+tracing_sampler::tracing_sampler(const rocprofiler_tracing_sampling_config_t& _cfg)
+: config{_cfg}
+{}
+
+uint64_t
+tracing_sampler::operator()()
+{
+    switch(config.policy)
+    {
+        case ROCPROFILER_TRACING_SAMPLING_EVERY_NTH:
+        {
+            // the first call is always traced so that infrequent calls are not invisible
+            auto _idx = m_calls.fetch_add(1, std::memory_order_relaxed);
+            if(_idx % config.interval != 0) return 0;
+            return (_idx == 0) ? 1 : config.interval;
+        }
+        case ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH:
+        {
+            auto _idx = m_calls.fetch_add(1, std::memory_order_relaxed);
+            if(_idx < config.count) return 1;
+
+            _idx -= config.count;
+            if(_idx % config.interval != 0) return 0;
+            return (_idx == 0) ? 1 : config.interval;
+        }
+        case ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET:
+        {
+            // the bucket is refilled with `count` tokens at the start of every period. The window
+            // and the tokens taken from it share one atomic so the thread which moves the bucket
+            // to a new window also refills it and takes the first token
+            constexpr uint64_t tokens_mask = 0xffffffffULL;
+
+            auto _window = (common::timestamp_ns() / config.period) & tokens_mask;
+            auto _limit  = std::min<uint64_t>(config.count, tokens_mask);
+            auto _bucket = m_bucket.load(std::memory_order_relaxed);
+            while(true)
+            {
+                auto _tokens = ((_bucket >> 32) == _window) ? (_bucket & tokens_mask) : 0;
+                if(_tokens >= _limit)
+                {
+                    m_skipped.fetch_add(1, std::memory_order_relaxed);
+                    return 0;
+                }
+                if(m_bucket.compare_exchange_weak(
+                       _bucket, (_window << 32) | (_tokens + 1), std::memory_order_relaxed))
+                    break;
+            }
+            return m_skipped.exchange(0, std::memory_order_relaxed) + 1;
+        }
+        case ROCPROFILER_TRACING_SAMPLING_NONE:
+        case ROCPROFILER_TRACING_SAMPLING_LAST: break;
+    }
+
+    return 1;
+}
+
+bool
+is_valid(const rocprofiler_tracing_sampling_config_t& _cfg)
+{
+    switch(_cfg.policy)
+    {
+        case ROCPROFILER_TRACING_SAMPLING_NONE: return true;
+        case ROCPROFILER_TRACING_SAMPLING_EVERY_NTH:
+        case ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH: return (_cfg.interval > 0);
+        case ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET: return (_cfg.period > 0 && _cfg.count > 0);
+        case ROCPROFILER_TRACING_SAMPLING_LAST: break;
+    }
+    return false;
+}
+
+bool
+supports_sampling(rocprofiler_callback_tracing_kind_t _domain)
+{
+    switch(_domain)
+    {
+        case ROCPROFILER_CALLBACK_TRACING_HSA_CORE_API:
+        case ROCPROFILER_CALLBACK_TRACING_HSA_AMD_EXT_API:
+        case ROCPROFILER_CALLBACK_TRACING_HSA_IMAGE_EXT_API:
+        case ROCPROFILER_CALLBACK_TRACING_HSA_FINALIZE_EXT_API:
+        case ROCPROFILER_CALLBACK_TRACING_HIP_RUNTIME_API:
+        case ROCPROFILER_CALLBACK_TRACING_HIP_COMPILER_API: return true;
+        default: break;
+    }
+    return false;
+}
+
+bool
+supports_sampling(rocprofiler_buffer_tracing_kind_t _domain)
+{
+    switch(_domain)
+    {
+        case ROCPROFILER_BUFFER_TRACING_HSA_CORE_API:
+        case ROCPROFILER_BUFFER_TRACING_HSA_AMD_EXT_API:
+        case ROCPROFILER_BUFFER_TRACING_HSA_IMAGE_EXT_API:
+        case ROCPROFILER_BUFFER_TRACING_HSA_FINALIZE_EXT_API:
+        case ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API:
+        case ROCPROFILER_BUFFER_TRACING_HIP_COMPILER_API: return true;
+        default: break;
+    }
+    return false;
+}
+
+template <typename DomainT>
+rocprofiler_status_t
+add_sampling(tracing_sampling<DomainT>&                   _sampling,
+             DomainT                                      _domain,
+             const std::vector<uint32_t>&                 _ops,
+             const rocprofiler_tracing_sampling_config_t& _cfg)
+{
+    using sampling_t = tracing_sampling<DomainT>;
+
+    if(!supports_sampling(_domain)) return ROCPROFILER_STATUS_ERROR_KIND_NOT_FOUND;
+    if(!is_valid(_cfg)) return ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT;
+
+    for(auto itr : _ops)
+    {
+        if(itr >= sampling_t::padding) return ROCPROFILER_STATUS_ERROR_OPERATION_NOT_FOUND;
+    }
+
+    auto& _samplers = _sampling.samplers.at(_domain);
+    _samplers.resize(sampling_t::padding);
+
+    auto _make_sampler = [&_cfg]() -> std::unique_ptr<tracing_sampler> {
+        if(_cfg.policy == ROCPROFILER_TRACING_SAMPLING_NONE) return nullptr;
+        return std::make_unique<tracing_sampler>(_cfg);
+    };
+
+    if(_ops.empty())
+    {
+        for(auto& itr : _samplers)
+            itr = _make_sampler();
+    }
+    else
+    {
+        for(auto itr : _ops)
+            _samplers.at(itr) = _make_sampler();
+    }
+
+    _sampling.enabled = false;
+    for(const auto& ditr : _sampling.samplers)
+        for(const auto& itr : ditr)
+            _sampling.enabled = (_sampling.enabled || itr != nullptr);
+
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+template rocprofiler_status_t
+add_sampling(tracing_sampling<rocprofiler_callback_tracing_kind_t>&,
+             rocprofiler_callback_tracing_kind_t,
+             const std::vector<uint32_t>&,
+             const rocprofiler_tracing_sampling_config_t&);
+
+template rocprofiler_status_t
+add_sampling(tracing_sampling<rocprofiler_buffer_tracing_kind_t>&,
+             rocprofiler_buffer_tracing_kind_t,
+             const std::vector<uint32_t>&,
+             const rocprofiler_tracing_sampling_config_t&);
+}  // namespace context
+}  // namespace rocprofiler
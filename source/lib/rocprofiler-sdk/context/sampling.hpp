@@ -0,0 +1,106 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <rocprofiler-sdk/experimental/tracing.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include "lib/rocprofiler-sdk/context/domain.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace context
+{
+/// decides which calls to a single operation are traced. Shared by every thread calling the
+/// operation so the counters are atomic.
+struct tracing_sampler
+{
+    explicit tracing_sampler(const rocprofiler_tracing_sampling_config_t& _cfg);
+
+    ~tracing_sampler()                          = default;
+    tracing_sampler(const tracing_sampler&)     = delete;
+    tracing_sampler(tracing_sampler&&) noexcept = delete;
+    tracing_sampler& operator=(const tracing_sampler&) = delete;
+    tracing_sampler& operator=(tracing_sampler&&) noexcept = delete;
+
+    /// returns zero if the call should be skipped. Otherwise, returns the number of calls which
+    /// the traced call represents: the traced call plus the calls skipped since the last one
+    uint64_t operator()();
+
+    const rocprofiler_tracing_sampling_config_t config;
+
+private:
+    std::atomic<uint64_t> m_calls   = {0};
+    std::atomic<uint64_t> m_skipped = {0};
+    std::atomic<uint64_t> m_bucket  = {0};  // token bucket: window (high 32 bits) and tokens taken
+};
+
+/// validates the sampling configuration provided by a tool
+bool
+is_valid(const rocprofiler_tracing_sampling_config_t&);
+
+/// samplers for the operations of the tracing kinds of a callback or buffer tracing service
+template <typename DomainT>
+struct tracing_sampling
+{
+    static constexpr auto last    = domain_info<DomainT>::last;
+    static constexpr auto padding = domain_info<DomainT>::padding;
+
+    using sampler_vec_t   = std::vector<std::unique_ptr<tracing_sampler>>;
+    using sampler_array_t = std::array<sampler_vec_t, last>;
+
+    /// sampler for the given kind + operation or null if every call is traced
+    tracing_sampler* get(DomainT _domain, uint32_t _op) const
+    {
+        if(!enabled || _domain >= last) return nullptr;
+        const auto& _samplers = samplers[_domain];
+        return (_op < _samplers.size()) ? _samplers[_op].get() : nullptr;
+    }
+
+    bool            enabled  = false;
+    sampler_array_t samplers = {};
+};
+
+/// whether calls to the operations of the given kind may be sampled
+bool
+supports_sampling(rocprofiler_callback_tracing_kind_t);
+
+bool
+supports_sampling(rocprofiler_buffer_tracing_kind_t);
+
+/// installs a sampler with the given configuration for each operation. If `_ops` is empty,
+/// every operation in the kind is sampled.
+template <typename DomainT>
+rocprofiler_status_t
+add_sampling(tracing_sampling<DomainT>&                   _sampling,
+             DomainT                                      _domain,
+             const std::vector<uint32_t>&                 _ops,
+             const rocprofiler_tracing_sampling_config_t& _cfg);
+}  // namespace context
+}  // namespace rocprofiler
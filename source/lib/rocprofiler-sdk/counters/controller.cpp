@@ -27,14 +27,73 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include "lib/common/environment.hpp"
+#include "lib/common/logging.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
 #include "lib/rocprofiler-sdk/context/context.hpp"
+#include "lib/rocprofiler-sdk/counters/core.hpp"
 #include "lib/rocprofiler-sdk/counters/ioctl.hpp"
+#include "lib/rocprofiler-sdk/counters/pass_scheduler.hpp"
+
+#include <fmt/core.h>
 
 namespace rocprofiler
 {
 namespace counters
 {
+namespace
+{
+bool
+multipass_enabled()
+{
+    static auto _v = common::get_env("ROCPROFILER_COUNTER_MULTIPASS", false);
+    return _v;
+}
+
+// Splits a profile that cannot be collected in a single dispatch into passes that can
+rocprofiler_status_t
+setup_profile_passes(profile_config& config)
+{
+    auto block_limit = [&config](const Metric& counter) -> int64_t {
+        return config.pkt_generator->block_limit(counter);
+    };
+
+    const auto* asts = get_agent_ast_map(std::string(config.agent->name));
+    if(!asts) return ROCPROFILER_STATUS_ERROR_AST_GENERATION_FAILED;
+
+    auto passes = std::vector<counter_pass>{};
+    if(auto status = schedule_counter_passes(*asts, config.metrics, block_limit, passes);
+       status != ROCPROFILER_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    for(const auto& pass : passes)
+    {
+        auto pass_config     = std::make_shared<profile_config>();
+        pass_config->agent   = config.agent;
+        pass_config->metrics = pass.metrics;
+        if(auto status = counter_callback_info::setup_profile_config(pass_config);
+           status != ROCPROFILER_STATUS_SUCCESS)
+        {
+            return status;
+        }
+        if(auto status = pass_config->pkt_generator->can_collect();
+           status != ROCPROFILER_STATUS_SUCCESS)
+        {
+            return status;
+        }
+        config.passes.emplace_back(std::move(pass_config));
+    }
+
+    ROCP_INFO << fmt::format("Counter profile with {} metrics on {} is collected in {} passes",
+                             config.metrics.size(),
+                             config.agent->name,
+                             config.passes.size());
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+}  // namespace
+
 CounterController::CounterController()
 {
     // Pre-read metrics map file to catch faliures during initial setup.
@@ -51,6 +110,8 @@ CounterController::add_profile(std::shared_ptr<profile_config>&& config)
     uint64_t                     ret         = 0;
     _configs.wlock([&](auto& data) {
         config->id = rocprofiler_profile_config_id_t{.handle = profile_val};
+        for(auto& pass : config->passes)
+            pass->id = config->id;
         data.emplace(profile_val, std::move(config));
         ret = profile_val;
         profile_val++;
@@ -195,7 +256,15 @@ create_counter_profile(std::shared_ptr<profile_config> config)
 
     if(status = config->pkt_generator->can_collect(); status != ROCPROFILER_STATUS_SUCCESS)
     {
-        return status;
+        // Profiles exceeding the hardware limits are split into passes when enabled
+        if(status != ROCPROFILER_STATUS_ERROR_EXCEEDS_HW_LIMIT || !multipass_enabled())
+        {
+            return status;
+        }
+        if(status = setup_profile_passes(*config); status != ROCPROFILER_STATUS_SUCCESS)
+        {
+            return status;
+        }
     }
 
     get_controller().add_profile(std::move(config));
@@ -220,5 +289,14 @@ get_profile_config(rocprofiler_profile_config_id_t id)
         return nullptr;
     }
 }
+
+std::shared_ptr<profile_config>
+get_profile_pass(const std::shared_ptr<profile_config>& config, uint64_t kernel_id)
+{
+    if(!config || config->passes.empty()) return config;
+
+    auto idx = config->pass_rotation.wlock([&](auto& data) { return data[kernel_id]++; });
+    return config->passes.at(idx % config->passes.size());
+}
 }  // namespace counters
 }  // namespace rocprofiler
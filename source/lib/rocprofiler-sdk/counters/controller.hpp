@@ -34,6 +34,10 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 namespace rocprofiler
 {
 namespace counters
@@ -55,13 +59,27 @@ struct profile_config
     std::set<counters::Metric> required_special_counters{};
     // ASTs to evaluate
     std::vector<counters::EvaluateAST> asts{};
-    rocprofiler_profile_config_id_t    id{.handle = 0};
+    // ASTs compiled for evaluation (same order as asts)
+    std::vector<counters::EvaluateProgram> programs{};
+    rocprofiler_profile_config_id_t        id{.handle = 0};
     // Packet generator to create AQL packets for insertion
     std::unique_ptr<rocprofiler::aql::CounterPacketConstruct> pkt_generator{nullptr};
     // A packet cache of AQL packets. This allows reuse of AQL packets (preventing costly
     // allocation of new packets/destruction).
     rocprofiler::common::Synchronized<std::vector<std::unique_ptr<rocprofiler::hsa::AQLPacket>>>
         packets{};
+    // Metric ids (hw and special counters) that are given a slot in the decode arenas.
+    // Set with pkt_generator, the layout does not change afterwards.
+    std::vector<uint64_t> arena_layout{};
+    // A cache of arenas the AQL packets are decoded into. Same as packets, reusing the
+    // arenas avoids allocating the decoded results for every dispatch/sample.
+    rocprofiler::common::Synchronized<std::vector<std::unique_ptr<counters::DecodeArena>>>
+        arenas{};
+    // Profiles whose counters exceed the hardware limits when collected together are split
+    // into passes (see ROCPROFILER_COUNTER_MULTIPASS). Dispatches of the same kernel rotate
+    // through the passes, the pass to use next is kept per kernel id.
+    std::vector<std::shared_ptr<profile_config>>                            passes{};
+    rocprofiler::common::Synchronized<std::unordered_map<uint64_t, size_t>> pass_rotation{};
 };
 
 class CounterController
@@ -112,5 +130,10 @@ destroy_counter_profile(uint64_t id);
 std::shared_ptr<profile_config>
 get_profile_config(rocprofiler_profile_config_id_t id);
 
+// Returns the profile to collect for a dispatch of the kernel. Profiles split into passes
+// return their passes round-robin per kernel, otherwise the profile itself.
+std::shared_ptr<profile_config>
+get_profile_pass(const std::shared_ptr<profile_config>& config, uint64_t kernel_id);
+
 }  // namespace counters
 }  // namespace rocprofiler
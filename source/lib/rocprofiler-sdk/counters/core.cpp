@@ -51,11 +51,18 @@ counter_callback_info::setup_profile_config(std::shared_ptr<profile_config>& pro
     // This call needs to be thread protected in that only one thread must be setting up profile at
     // the same time.
 
-    auto& config     = *profile;
-    auto  agent_name = std::string(config.agent->name);
+    auto&       config     = *profile;
+    auto        agent_name = std::string(config.agent->name);
+    const auto* agent_map  = get_agent_ast_map(agent_name);
+    if(!agent_map)
+    {
+        ROCP_ERROR << fmt::format("Coult not build AST for {}", agent_name);
+        return ROCPROFILER_STATUS_ERROR_AST_GENERATION_FAILED;
+    }
+
     for(const auto& metric : config.metrics)
     {
-        auto req_counters = get_required_hardware_counters(get_ast_map(), agent_name, metric);
+        auto req_counters = get_required_hardware_counters(*agent_map, metric);
 
         if(!req_counters)
         {
@@ -77,14 +84,6 @@ counter_callback_info::setup_profile_config(std::shared_ptr<profile_config>& pro
             }
         }
 
-        const auto& asts      = get_ast_map();
-        const auto* agent_map = rocprofiler::common::get_val(asts, agent_name);
-        if(!agent_map)
-        {
-            ROCP_ERROR << fmt::format("Coult not build AST for {}", agent_name);
-            return ROCPROFILER_STATUS_ERROR_AST_GENERATION_FAILED;
-        }
-
         const auto* counter_ast = rocprofiler::common::get_val(*agent_map, metric.name());
         if(!counter_ast)
         {
@@ -102,8 +101,22 @@ counter_callback_info::setup_profile_config(std::shared_ptr<profile_config>& pro
                        << " " << e.what();
             return ROCPROFILER_STATUS_ERROR_AST_NOT_FOUND;
         }
+
+        try
+        {
+            config.programs.emplace_back(config.asts.back());
+        } catch(std::exception& e)
+        {
+            ROCP_ERROR << "Could not compile AST for " << metric.name() << " " << e.what();
+            return ROCPROFILER_STATUS_ERROR_AST_GENERATION_FAILED;
+        }
     }
 
+    for(const auto& metric : config.reqired_hw_counters)
+        config.arena_layout.emplace_back(metric.id());
+    for(const auto& metric : config.required_special_counters)
+        config.arena_layout.emplace_back(metric.id());
+
     profile->pkt_generator = std::make_unique<rocprofiler::aql::CounterPacketConstruct>(
         config.agent->id,
         std::vector<counters::Metric>{profile->reqired_hw_counters.begin(),
@@ -141,6 +154,27 @@ counter_callback_info::get_packet(std::unique_ptr<rocprofiler::hsa::AQLPacket>&
     return ROCPROFILER_STATUS_SUCCESS;
 }
 
+std::unique_ptr<DecodeArena>
+counter_callback_info::get_arena(profile_config& profile)
+{
+    std::unique_ptr<DecodeArena> arena{};
+    profile.arenas.wlock([&](auto& arena_vector) {
+        if(arena_vector.empty()) return;
+        arena = std::move(arena_vector.back());
+        arena_vector.pop_back();
+    });
+
+    if(!arena) arena = std::make_unique<DecodeArena>(profile.arena_layout);
+    return arena;
+}
+
+void
+counter_callback_info::return_arena(profile_config& profile, std::unique_ptr<DecodeArena>&& arena)
+{
+    if(!arena) return;
+    profile.arenas.wlock([&](auto& arena_vector) { arena_vector.emplace_back(std::move(arena)); });
+}
+
 void
 start_context(const context::context* ctx)
 {
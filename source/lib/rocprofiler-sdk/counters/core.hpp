@@ -70,6 +70,11 @@ struct counter_callback_info
 
     rocprofiler_status_t get_packet(std::unique_ptr<rocprofiler::hsa::AQLPacket>&,
                                     std::shared_ptr<profile_config>&);
+
+    // Take a decode arena from the cache of the profile (or create one) and return it once
+    // the decoded results are no longer needed.
+    static std::unique_ptr<DecodeArena> get_arena(profile_config&);
+    static void return_arena(profile_config&, std::unique_ptr<DecodeArena>&&);
 };
 
 uint64_t
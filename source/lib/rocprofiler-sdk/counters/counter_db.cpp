@@ -0,0 +1,625 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/counters/counter_db.hpp"
+#include "lib/common/logging.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+
+#include "yaml-cpp/exceptions.h"
+#include "yaml-cpp/node/convert.h"
+#include "yaml-cpp/node/detail/impl.h"
+#include "yaml-cpp/node/impl.h"
+#include "yaml-cpp/node/iterator.h"
+#include "yaml-cpp/node/node.h"
+#include "yaml-cpp/node/parse.h"
+#include "yaml-cpp/parser.h"
+
+#include <fmt/core.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace counters
+{
+namespace
+{
+constexpr char db_magic[8] = {'R', 'O', 'C', 'P', 'C', 'N', 'T', 'R'};
+
+// Offset and size of a string in the string table
+struct db_string
+{
+    uint32_t offset = 0;
+    uint32_t size   = 0;
+};
+
+struct db_header
+{
+    char     magic[8]           = {};
+    uint32_t version            = 0;
+    uint32_t num_definitions    = 0;
+    uint32_t num_asts           = 0;
+    uint32_t num_nodes          = 0;
+    uint32_t num_children       = 0;
+    uint32_t num_dimensions     = 0;
+    uint32_t num_selects        = 0;
+    uint32_t strings_size       = 0;
+    uint64_t file_size          = 0;
+    uint64_t yaml_hash          = 0;
+    uint64_t definitions_offset = 0;
+    uint64_t asts_offset        = 0;
+    uint64_t nodes_offset       = 0;
+    uint64_t children_offset    = 0;
+    uint64_t dimensions_offset  = 0;
+    uint64_t selects_offset     = 0;
+    uint64_t strings_offset     = 0;
+};
+
+struct db_definition
+{
+    db_string name         = {};
+    db_string architecture = {};
+    db_string block        = {};
+    db_string event        = {};
+    db_string description  = {};
+    db_string expression   = {};
+};
+
+// ASTs are sorted by expression
+struct db_ast
+{
+    db_string expression = {};
+    uint32_t  root       = 0;
+    uint32_t  reserved   = 0;
+};
+
+enum db_value_kind : uint32_t
+{
+    DB_VALUE_NONE = 0,
+    DB_VALUE_STRING,
+    DB_VALUE_NUMBER,
+};
+
+// Nodes of the ASTs are stored in pre-order, the children of a node follow it
+struct db_node
+{
+    uint32_t  type             = 0;
+    uint32_t  accumulate_op    = 0;
+    uint32_t  value_kind       = DB_VALUE_NONE;
+    uint32_t  children_begin   = 0;
+    int64_t   number           = 0;
+    db_string string           = {};
+    db_string reduce_op        = {};
+    uint32_t  children_count   = 0;
+    uint32_t  dimensions_begin = 0;
+    uint32_t  dimensions_count = 0;
+    uint32_t  selects_begin    = 0;
+    uint32_t  selects_count    = 0;
+    uint32_t  reserved         = 0;
+};
+
+struct db_select
+{
+    uint32_t  dimension = 0;
+    db_string value     = {};
+};
+
+static_assert(std::is_trivially_copyable<db_header>::value, "Expected trivially copyable type");
+static_assert(std::is_trivially_copyable<db_node>::value, "Expected trivially copyable type");
+static_assert(sizeof(db_node) == 64, "Unexpected size of an AST node");
+
+class db_writer
+{
+public:
+    db_string add_string(std::string_view str)
+    {
+        auto [itr, inserted] = _string_index.emplace(std::string{str}, db_string{});
+        if(inserted)
+        {
+            itr->second = {.offset = static_cast<uint32_t>(_strings.size()),
+                           .size   = static_cast<uint32_t>(str.size())};
+            _strings.append(str);
+        }
+        return itr->second;
+    }
+
+    void add_definition(const counter_definition& def)
+    {
+        _definitions.push_back({.name         = add_string(def.name),
+                                .architecture = add_string(def.architecture),
+                                .block        = add_string(def.block),
+                                .event        = add_string(def.event),
+                                .description  = add_string(def.description),
+                                .expression   = add_string(def.expression)});
+    }
+
+    void add_ast(std::string_view expression, const RawAST& ast)
+    {
+        auto str = add_string(expression);
+        _asts.push_back({.expression = str, .root = add_node(ast), .reserved = 0});
+    }
+
+    std::vector<char> finish(uint64_t yaml_hash)
+    {
+        std::sort(_asts.begin(), _asts.end(), [this](const db_ast& lhs, const db_ast& rhs) {
+            return get_string(lhs.expression) < get_string(rhs.expression);
+        });
+
+        auto out = std::vector<char>(sizeof(db_header), 0);
+        auto hdr = db_header{};
+        std::memcpy(hdr.magic, db_magic, sizeof(db_magic));
+        hdr.version            = CounterDatabase::format_version;
+        hdr.num_definitions    = static_cast<uint32_t>(_definitions.size());
+        hdr.num_asts           = static_cast<uint32_t>(_asts.size());
+        hdr.num_nodes          = static_cast<uint32_t>(_nodes.size());
+        hdr.num_children       = static_cast<uint32_t>(_children.size());
+        hdr.num_dimensions     = static_cast<uint32_t>(_dimensions.size());
+        hdr.num_selects        = static_cast<uint32_t>(_selects.size());
+        hdr.strings_size       = static_cast<uint32_t>(_strings.size());
+        hdr.yaml_hash          = yaml_hash;
+        hdr.definitions_offset = append(out, _definitions.data(), _definitions.size());
+        hdr.asts_offset        = append(out, _asts.data(), _asts.size());
+        hdr.nodes_offset       = append(out, _nodes.data(), _nodes.size());
+        hdr.children_offset    = append(out, _children.data(), _children.size());
+        hdr.dimensions_offset  = append(out, _dimensions.data(), _dimensions.size());
+        hdr.selects_offset     = append(out, _selects.data(), _selects.size());
+        hdr.strings_offset     = append(out, _strings.data(), _strings.size());
+        hdr.file_size          = out.size();
+        std::memcpy(out.data(), &hdr, sizeof(hdr));
+        return out;
+    }
+
+private:
+    std::string_view get_string(db_string str) const
+    {
+        return std::string_view{_strings}.substr(str.offset, str.size);
+    }
+
+    uint32_t add_node(const RawAST& ast)
+    {
+        auto idx = static_cast<uint32_t>(_nodes.size());
+        _nodes.emplace_back();
+
+        auto node          = db_node{};
+        node.type          = static_cast<uint32_t>(ast.type);
+        node.accumulate_op = static_cast<uint32_t>(ast.accumulate_op);
+        node.reduce_op     = add_string(ast.reduce_op);
+        if(const auto* str = std::get_if<std::string>(&ast.value))
+        {
+            node.value_kind = DB_VALUE_STRING;
+            node.string     = add_string(*str);
+        }
+        else if(const auto* num = std::get_if<int64_t>(&ast.value))
+        {
+            node.value_kind = DB_VALUE_NUMBER;
+            node.number     = *num;
+        }
+
+        // sorted so that the output does not depend on the hash of the set
+        node.dimensions_begin = static_cast<uint32_t>(_dimensions.size());
+        for(auto dim : ast.reduce_dimension_set)
+            _dimensions.emplace_back(static_cast<uint32_t>(dim));
+        std::sort(_dimensions.begin() + node.dimensions_begin, _dimensions.end());
+        node.dimensions_count = static_cast<uint32_t>(_dimensions.size()) - node.dimensions_begin;
+
+        node.selects_begin = static_cast<uint32_t>(_selects.size());
+        for(const auto& [dim, value] : ast.select_dimension_map)
+            _selects.push_back(
+                {.dimension = static_cast<uint32_t>(dim), .value = add_string(value)});
+        node.selects_count = static_cast<uint32_t>(_selects.size()) - node.selects_begin;
+
+        auto children = std::vector<uint32_t>{};
+        for(const auto* child : ast.counter_set)
+            children.emplace_back(add_node(*CHECK_NOTNULL(child)));
+        node.children_begin = static_cast<uint32_t>(_children.size());
+        node.children_count = static_cast<uint32_t>(children.size());
+        _children.insert(_children.end(), children.begin(), children.end());
+
+        _nodes.at(idx) = node;
+        return idx;
+    }
+
+    // Appends a section aligned to 8 bytes and returns its offset
+    template <typename Tp>
+    static uint64_t append(std::vector<char>& out, const Tp* data, size_t count)
+    {
+        out.resize((out.size() + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1), 0);
+        auto offset = out.size();
+        out.resize(offset + (count * sizeof(Tp)));
+        if(count > 0) std::memcpy(out.data() + offset, data, count * sizeof(Tp));
+        return offset;
+    }
+
+    std::unordered_map<std::string, db_string> _string_index = {};
+    std::string                                _strings      = {};
+    std::vector<db_definition>                 _definitions  = {};
+    std::vector<db_ast>                        _asts         = {};
+    std::vector<db_node>                       _nodes        = {};
+    std::vector<uint32_t>                      _children     = {};
+    std::vector<uint32_t>                      _dimensions   = {};
+    std::vector<db_select>                     _selects      = {};
+};
+
+// Read access to a validated database
+struct db_view
+{
+    const char* data = nullptr;
+
+    const db_header& header() const { return *reinterpret_cast<const db_header*>(data); }
+
+    template <typename Tp>
+    const Tp* section(uint64_t offset) const
+    {
+        return reinterpret_cast<const Tp*>(data + offset);
+    }
+
+    std::string_view get_string(db_string str) const
+    {
+        return std::string_view{section<char>(header().strings_offset) + str.offset, str.size};
+    }
+
+    std::unique_ptr<RawAST> make_ast(uint32_t idx) const
+    {
+        const auto& hdr  = header();
+        const auto& node = section<db_node>(hdr.nodes_offset)[idx];
+
+        auto ast =
+            std::make_unique<RawAST>(static_cast<NodeType>(node.type), std::vector<RawAST*>{});
+        ast->accumulate_op = static_cast<ACCUMULATE_OP_TYPE>(node.accumulate_op);
+        ast->reduce_op     = std::string{get_string(node.reduce_op)};
+        if(node.value_kind == DB_VALUE_STRING)
+            ast->value = std::string{get_string(node.string)};
+        else if(node.value_kind == DB_VALUE_NUMBER)
+            ast->value = node.number;
+
+        const auto* dims = section<uint32_t>(hdr.dimensions_offset) + node.dimensions_begin;
+        for(uint32_t i = 0; i < node.dimensions_count; ++i)
+            ast->reduce_dimension_set.emplace(
+                static_cast<rocprofiler_profile_counter_instance_types>(dims[i]));
+
+        const auto* selects = section<db_select>(hdr.selects_offset) + node.selects_begin;
+        for(uint32_t i = 0; i < node.selects_count; ++i)
+            ast->select_dimension_map.emplace(
+                static_cast<rocprofiler_profile_counter_instance_types>(selects[i].dimension),
+                std::string{get_string(selects[i].value)});
+
+        const auto* children = section<uint32_t>(hdr.children_offset) + node.children_begin;
+        for(uint32_t i = 0; i < node.children_count; ++i)
+        {
+            auto child = make_ast(children[i]);
+            ast->counter_set.emplace_back(child.get());
+            child.release();
+        }
+        return ast;
+    }
+};
+
+std::unique_ptr<RawAST>
+parse_expression(const std::string& expression)
+{
+    RawAST* ast = nullptr;
+    auto*   buf = yy_scan_string(expression.c_str());
+    try
+    {
+        yyparse(&ast);
+    } catch(std::exception& e)
+    {
+        ROCP_WARNING << fmt::format("Unable to parse expression {}: {}", expression, e.what());
+        ast = nullptr;
+    }
+    yy_delete_buffer(buf);
+    return std::unique_ptr<RawAST>{ast};
+}
+}  // namespace
+
+/**
+ * Expected YAML Format:
+ * COUNTER_NAME:
+ *  architectures:
+ *   gfxXX: // Can be more than one, / deliminated if they share idential data
+ *     block: <Optional>
+ *     event: <Optional>
+ *     expression: <optional>
+ *     description: <Optional>
+ *   gfxYY:
+ *      ...
+ *  description: General counter desctiption
+ */
+std::vector<char>
+CounterDatabase::compile(std::string_view yaml_data, bool with_asts)
+{
+    auto writer      = db_writer{};
+    auto yaml        = YAML::Load(std::string{yaml_data});
+    auto expressions = std::vector<std::string>{};
+    for(auto it = yaml.begin(); it != yaml.end(); ++it)
+    {
+        auto counter_name = it->first.as<std::string>();
+        if(counter_name == "schema-version") continue;
+        auto counter_def  = it->second;
+        auto def_iterator = counter_def["architectures"];
+
+        for(auto def_it = def_iterator.begin(); def_it != def_iterator.end(); ++def_it)
+        {
+            auto archs = def_it->first.as<std::string>();
+            auto def   = def_it->second;
+
+            std::string description;
+            if(def["description"])
+                description = def["description"].as<std::string>();
+            else if(counter_def["description"])
+                description = counter_def["description"].as<std::string>();
+            auto block      = (def["block"] ? def["block"].as<std::string>() : "");
+            auto event      = (def["event"] ? def["event"].as<std::string>() : "");
+            auto expression = (def["expression"] ? def["expression"].as<std::string>() : "");
+
+            // To save space in the YAML file, we combine architectures with the same
+            // definition into a single entry. Split these out into separate entries.
+            // architectures:
+            //     gfx10/gfx1010/gfx1030/gfx1031/.....9:
+            //     expression: 400*SQ_WAIT_INST_LDS/SQ_WAVES/GRBM_GUI_ACTIVE
+            std::stringstream ss(archs);
+            std::string       arch_name;
+            while(std::getline(ss, arch_name, '/'))
+            {
+                writer.add_definition({.name         = counter_name,
+                                       .architecture = arch_name,
+                                       .block        = block,
+                                       .event        = event,
+                                       .description  = description,
+                                       .expression   = expression});
+            }
+
+            if(with_asts) expressions.emplace_back(expression.empty() ? counter_name : expression);
+        }
+    }
+
+    std::sort(expressions.begin(), expressions.end());
+    expressions.erase(std::unique(expressions.begin(), expressions.end()), expressions.end());
+    for(const auto& expression : expressions)
+    {
+        if(auto ast = parse_expression(expression))
+            writer.add_ast(expression, *ast);
+        else
+            ROCP_WARNING << fmt::format("Expression {} is not stored in the counter database",
+                                        expression);
+    }
+
+    return writer.finish(hash_yaml(yaml_data));
+}
+
+uint64_t
+CounterDatabase::hash_yaml(std::string_view yaml)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(auto c : yaml)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+uint64_t
+CounterDatabase::yaml_hash() const
+{
+    return db_view{_data}.header().yaml_hash;
+}
+
+std::unique_ptr<CounterDatabase>
+CounterDatabase::open(const std::string& filename)
+{
+    int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if(fd < 0) return nullptr;
+
+    struct stat st  = {};
+    void*       ptr = MAP_FAILED;
+    if(::fstat(fd, &st) == 0 && st.st_size > 0)
+        ptr = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(ptr == MAP_FAILED) return nullptr;
+
+    auto db           = std::unique_ptr<CounterDatabase>{new CounterDatabase{}};
+    db->_mapping      = ptr;
+    db->_mapping_size = st.st_size;
+    db->_data         = static_cast<const char*>(ptr);
+    db->_size         = st.st_size;
+    if(!db->validate())
+    {
+        ROCP_WARNING << fmt::format("Counter database {} is not valid", filename);
+        return nullptr;
+    }
+    return db;
+}
+
+std::unique_ptr<CounterDatabase>
+CounterDatabase::from_buffer(std::vector<char>&& buffer)
+{
+    auto db     = std::unique_ptr<CounterDatabase>{new CounterDatabase{}};
+    db->_buffer = std::move(buffer);
+    db->_data   = db->_buffer.data();
+    db->_size   = db->_buffer.size();
+    if(!db->validate()) return nullptr;
+    return db;
+}
+
+std::unique_ptr<CounterDatabase>
+CounterDatabase::from_yaml(std::string_view yaml)
+{
+    return from_buffer(compile(yaml, false));
+}
+
+CounterDatabase::~CounterDatabase()
+{
+    if(_mapping) ::munmap(_mapping, _mapping_size);
+}
+
+counter_definition
+CounterDatabase::at(size_t idx) const
+{
+    CHECK_LT(idx, _num_definitions);
+
+    auto        view = db_view{_data};
+    const auto& def  = view.section<db_definition>(view.header().definitions_offset)[idx];
+    return {.name         = view.get_string(def.name),
+            .architecture = view.get_string(def.architecture),
+            .block        = view.get_string(def.block),
+            .event        = view.get_string(def.event),
+            .description  = view.get_string(def.description),
+            .expression   = view.get_string(def.expression)};
+}
+
+std::unique_ptr<RawAST>
+CounterDatabase::get_ast(std::string_view expression) const
+{
+    auto        view  = db_view{_data};
+    const auto* begin = view.section<db_ast>(view.header().asts_offset);
+    const auto* end   = begin + _num_asts;
+    const auto* itr =
+        std::lower_bound(begin, end, expression, [&view](const db_ast& ast, std::string_view val) {
+            return view.get_string(ast.expression) < val;
+        });
+    if(itr == end || view.get_string(itr->expression) != expression) return nullptr;
+    return view.make_ast(itr->root);
+}
+
+// Checks every offset and index of the database once so that it can be used without checks
+bool
+CounterDatabase::validate()
+{
+    if(!_data || _size < sizeof(db_header)) return false;
+
+    auto        view = db_view{_data};
+    const auto& hdr  = view.header();
+    if(std::memcmp(hdr.magic, db_magic, sizeof(db_magic)) != 0) return false;
+    if(hdr.version != format_version)
+    {
+        ROCP_INFO << fmt::format("Counter database version {} does not match version {}",
+                                 hdr.version,
+                                 format_version);
+        return false;
+    }
+    if(hdr.file_size != _size) return false;
+
+    auto in_bounds = [this](uint64_t offset, uint64_t count, size_t size) {
+        return (offset % alignof(uint64_t)) == 0 && offset <= _size &&
+               count <= (_size - offset) / size;
+    };
+    if(!in_bounds(hdr.definitions_offset, hdr.num_definitions, sizeof(db_definition)) ||
+       !in_bounds(hdr.asts_offset, hdr.num_asts, sizeof(db_ast)) ||
+       !in_bounds(hdr.nodes_offset, hdr.num_nodes, sizeof(db_node)) ||
+       !in_bounds(hdr.children_offset, hdr.num_children, sizeof(uint32_t)) ||
+       !in_bounds(hdr.dimensions_offset, hdr.num_dimensions, sizeof(uint32_t)) ||
+       !in_bounds(hdr.selects_offset, hdr.num_selects, sizeof(db_select)) ||
+       !in_bounds(hdr.strings_offset, hdr.strings_size, sizeof(char)))
+    {
+        return false;
+    }
+
+    auto valid_string = [&hdr](db_string str) {
+        return str.offset <= hdr.strings_size && str.size <= hdr.strings_size - str.offset;
+    };
+    auto valid_range = [](uint32_t begin, uint32_t count, uint32_t size) {
+        return begin <= size && count <= size - begin;
+    };
+    auto valid_dimension = [](uint32_t dim) { return dim < ROCPROFILER_DIMENSION_LAST; };
+
+    const auto* defs = view.section<db_definition>(hdr.definitions_offset);
+    for(uint32_t i = 0; i < hdr.num_definitions; ++i)
+    {
+        const auto& def = defs[i];
+        for(auto str :
+            {def.name, def.architecture, def.block, def.event, def.description, def.expression})
+        {
+            if(!valid_string(str)) return false;
+        }
+    }
+
+    const auto* children   = view.section<uint32_t>(hdr.children_offset);
+    const auto* dims       = view.section<uint32_t>(hdr.dimensions_offset);
+    const auto* selects    = view.section<db_select>(hdr.selects_offset);
+    const auto* nodes      = view.section<db_node>(hdr.nodes_offset);
+    auto        has_parent = std::vector<bool>(hdr.num_nodes, false);
+    for(uint32_t i = 0; i < hdr.num_nodes; ++i)
+    {
+        const auto& node = nodes[i];
+        if(node.type > ACCUMULATE_NODE || node.value_kind > DB_VALUE_NUMBER ||
+           node.accumulate_op > static_cast<uint32_t>(ACCUMULATE_OP_TYPE::HIGH_RESOLUTION) ||
+           !valid_string(node.string) || !valid_string(node.reduce_op) ||
+           !valid_range(node.children_begin, node.children_count, hdr.num_children) ||
+           !valid_range(node.dimensions_begin, node.dimensions_count, hdr.num_dimensions) ||
+           !valid_range(node.selects_begin, node.selects_count, hdr.num_selects))
+        {
+            return false;
+        }
+
+        // children follow their parent and have a single parent, which rules out cycles and
+        // shared subtrees
+        for(uint32_t j = 0; j < node.children_count; ++j)
+        {
+            auto child = children[node.children_begin + j];
+            if(child <= i || child >= hdr.num_nodes || has_parent.at(child)) return false;
+            has_parent.at(child) = true;
+        }
+        for(uint32_t j = 0; j < node.dimensions_count; ++j)
+        {
+            if(!valid_dimension(dims[node.dimensions_begin + j])) return false;
+        }
+        for(uint32_t j = 0; j < node.selects_count; ++j)
+        {
+            const auto& select = selects[node.selects_begin + j];
+            if(!valid_dimension(select.dimension) || !valid_string(select.value)) return false;
+        }
+    }
+
+    const auto* asts = view.section<db_ast>(hdr.asts_offset);
+    for(uint32_t i = 0; i < hdr.num_asts; ++i)
+    {
+        if(!valid_string(asts[i].expression) || asts[i].root >= hdr.num_nodes ||
+           has_parent.at(asts[i].root))
+        {
+            return false;
+        }
+        // sorted for the lookup
+        if(i > 0 && !(view.get_string(asts[i - 1].expression) <
+                      view.get_string(asts[i].expression)))
+        {
+            return false;
+        }
+    }
+
+    _num_definitions = hdr.num_definitions;
+    _num_asts        = hdr.num_asts;
+    return true;
+}
+}  // namespace counters
+}  // namespace rocprofiler
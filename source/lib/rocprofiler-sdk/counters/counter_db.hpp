@@ -0,0 +1,114 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/rocprofiler-sdk/counters/parser/raw_ast.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace counters
+{
+// Definition of a counter on a single architecture
+struct counter_definition
+{
+    std::string_view name         = {};
+    std::string_view architecture = {};
+    std::string_view block        = {};
+    std::string_view event        = {};
+    std::string_view description  = {};
+    std::string_view expression   = {};
+};
+
+/**
+ * Counter definitions in a compact binary format which is used in place (memory mapped).
+ * Contains the definitions of counter_defs.yaml split by architecture, in the order of
+ * the YAML file, and optionally the parsed ASTs of the counter expressions so that the
+ * expression parser does not have to run when the ASTs of an agent are constructed. The
+ * database is compiled from the YAML file at build time (counter_defs.db) and in memory
+ * (without ASTs) when the counter definitions are loaded from YAML.
+ */
+class CounterDatabase
+{
+public:
+    static constexpr uint32_t format_version = 2;
+
+    /**
+     * @brief Compile counter definitions in the YAML format
+     *
+     * @param [in] yaml       Counter definitions
+     * @param [in] with_asts  Parse the expressions and store the ASTs. Expressions which
+     *                        fail to parse are not stored and left to the parser at runtime.
+     * @return std::vector<char> The compiled database
+     */
+    static std::vector<char> compile(std::string_view yaml, bool with_asts);
+
+    // Hash of the YAML counter definitions, stored in the compiled database
+    static uint64_t hash_yaml(std::string_view yaml);
+
+    // Maps a compiled database, nullptr if the file does not exist or is not valid
+    static std::unique_ptr<CounterDatabase> open(const std::string& filename);
+
+    // Database of the compiled bytes, nullptr if they are not valid
+    static std::unique_ptr<CounterDatabase> from_buffer(std::vector<char>&& buffer);
+
+    // Database of counter definitions in the YAML format, compiled without ASTs
+    static std::unique_ptr<CounterDatabase> from_yaml(std::string_view yaml);
+
+    ~CounterDatabase();
+
+    CounterDatabase(const CounterDatabase&) = delete;
+    CounterDatabase& operator=(const CounterDatabase&) = delete;
+
+    size_t             size() const { return _num_definitions; }
+    counter_definition at(size_t idx) const;
+
+    size_t num_asts() const { return _num_asts; }
+
+    // Hash of the YAML counter definitions the database was compiled from
+    uint64_t yaml_hash() const;
+    // AST of a counter expression (or of the name of a counter without expression).
+    // nullptr if the database does not contain it.
+    std::unique_ptr<RawAST> get_ast(std::string_view expression) const;
+
+private:
+    CounterDatabase() = default;
+
+    bool validate();
+
+    std::vector<char> _buffer          = {};
+    void*             _mapping         = nullptr;
+    size_t            _mapping_size    = 0;
+    const char*       _data            = nullptr;
+    size_t            _size            = 0;
+    size_t            _num_definitions = 0;
+    size_t            _num_asts        = 0;
+};
+}  // namespace counters
+}  // namespace rocprofiler
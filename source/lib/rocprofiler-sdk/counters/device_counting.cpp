@@ -126,10 +126,10 @@ agent_async_handler(hsa_signal_value_t /*signal_v*/, void* data)
     const auto& prof_config = callback_data.profile;
 
     // Decode the AQL packet data
-    auto decoded_pkt =
-        EvaluateAST::read_pkt(prof_config->pkt_generator.get(), *callback_data.packet);
+    auto arena = counter_callback_info::get_arena(*prof_config);
+    EvaluateAST::read_pkt(prof_config->pkt_generator.get(), *callback_data.packet, *arena);
     EvaluateAST::read_special_counters(
-        *prof_config->agent, prof_config->required_special_counters, decoded_pkt);
+        *prof_config->agent, prof_config->required_special_counters, *arena);
 
     auto* buf = buffer::get_buffer(callback_data.buffer.handle);
     if(!buf && callback_data.buffer != rocprofiler_buffer_id_t{.handle = 0})
@@ -139,19 +139,20 @@ agent_async_handler(hsa_signal_value_t /*signal_v*/, void* data)
         return false;
     }
 
-    if(decoded_pkt.empty())
+    if(arena->empty())
     {
+        counter_callback_info::return_arena(*prof_config, std::move(arena));
         // reset the signal to allow another sample to start
         hsa::get_core_table()->hsa_signal_store_relaxed_fn(callback_data.completion, 1);
         return true;
     }
 
+    static thread_local auto scratch = EvaluateProgram::scratch_t{};
+
     // Write out the AQL data to the buffer
-    for(auto& ast : prof_config->asts)
+    for(const auto& program : prof_config->programs)
     {
-        std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
-        auto* ret = CHECK_NOTNULL(ast.evaluate(decoded_pkt, cache));
-        ast.set_out_id(*ret);
+        auto* ret = CHECK_NOTNULL(program.evaluate(*arena, scratch));
         for(auto& val : *ret)
         {
             val.user_data = callback_data.user_data;
@@ -165,6 +166,7 @@ agent_async_handler(hsa_signal_value_t /*signal_v*/, void* data)
                     ROCPROFILER_BUFFER_CATEGORY_COUNTERS, ROCPROFILER_COUNTER_RECORD_VALUE, val);
         }
     }
+    counter_callback_info::return_arena(*prof_config, std::move(arena));
 
     // reset the signal to allow another sample to start
     hsa::get_core_table()->hsa_signal_store_relaxed_fn(callback_data.completion, 1);
@@ -424,6 +426,9 @@ start_agent_ctx(const context::context* ctx)
                 auto config = rocprofiler::counters::get_profile_config(config_id);
                 if(!config) return ROCPROFILER_STATUS_ERROR_PROFILE_NOT_FOUND;
 
+                // Device counting has no dispatches to rotate the passes of a profile over
+                if(!config->passes.empty()) return ROCPROFILER_STATUS_ERROR_EXCEEDS_HW_LIMIT;
+
                 if(!cb_ctx->device_counter_collection)
                 {
                     return ROCPROFILER_STATUS_ERROR_CONTEXT_INVALID;
@@ -23,6 +23,8 @@
 #include "dimensions.hpp"
 
 #include <cstdint>
+#include <set>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -33,6 +35,7 @@
 
 #include "lib/common/static_object.hpp"
 #include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/agent.hpp"
 #include "lib/rocprofiler-sdk/aql/helpers.hpp"
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
 #include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
@@ -103,10 +106,17 @@ get_dimension_cache()
             construct([]() -> std::unordered_map<uint64_t, std::vector<MetricDimension>> {
                 std::unordered_map<uint64_t, std::vector<MetricDimension>> dims;
 
-                const auto& asts = counters::get_ast_map();
-                for(const auto& [gfx, metrics] : asts)
+                // Dimensions are only known for the agents of the system, the ASTs of
+                // other architectures are not constructed
+                auto archs = std::set<std::string>{};
+                for(const auto* agent : rocprofiler::agent::get_agents())
+                    archs.emplace(agent->name);
+
+                for(const auto& gfx : archs)
                 {
-                    for(const auto& [metric, ast] : metrics)
+                    const auto* metrics = counters::get_agent_ast_map(gfx);
+                    if(!metrics) continue;
+                    for(const auto& [metric, ast] : *metrics)
                     {
                         auto ast_copy = ast;
                         try
@@ -138,7 +138,8 @@ queue_cb(const context::context*                                         ctx,
         return no_instrumentation();
     }
 
-    auto prof_config = get_controller().get_profile_cfg(req_profile);
+    // Profiles split into passes collect one of the passes for this dispatch
+    auto prof_config = get_profile_pass(get_controller().get_profile_cfg(req_profile), kernel_id);
     CHECK(prof_config);
 
     std::unique_ptr<rocprofiler::hsa::AQLPacket> ret_pkt;
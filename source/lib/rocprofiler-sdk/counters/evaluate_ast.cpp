@@ -27,9 +27,11 @@
 #include <algorithm>
 #include <cstdint>
 #include <exception>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <stdexcept>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -38,6 +40,7 @@
 #include <rocprofiler-sdk/rocprofiler.h>
 
 #include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/counters/counter_db.hpp"
 #include "lib/rocprofiler-sdk/counters/dimensions.hpp"
 #include "lib/rocprofiler-sdk/counters/id_decode.hpp"
 #include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
@@ -238,69 +241,115 @@ perform_selection(std::map<rocprofiler_profile_counter_instance_types, std::stri
     return input_array;
 }
 
-}  // namespace
+// AST of a counter. Uses the precompiled AST of the counter database when there is one.
+std::unique_ptr<RawAST>
+get_raw_ast(const Metric& metric)
+{
+    const auto& text = metric.expression().empty() ? metric.name() : metric.expression();
+    if(const auto* db = counters::getCounterDatabase())
+    {
+        if(auto ast = db->get_ast(text)) return ast;
+    }
 
-const std::unordered_map<std::string, EvaluateASTMap>&
-get_ast_map()
+    RawAST* ast = nullptr;
+    auto*   buf = yy_scan_string(text.c_str());
+    yyparse(&ast);
+    yy_delete_buffer(buf);
+    return std::unique_ptr<RawAST>{ast};
+}
+
+EvaluateASTMap
+build_agent_ast_map(const std::string& gfx, const std::vector<Metric>& metrics)
 {
-    static std::unordered_map<std::string, EvaluateASTMap> ast_map = []() {
-        std::unordered_map<std::string, EvaluateASTMap> data;
-        const auto& metric_map = *CHECK_NOTNULL(counters::getMetricMap());
-        for(const auto& [gfx, metrics] : metric_map)
+    std::unordered_map<std::string, Metric> by_name;
+    for(const auto& metric : metrics)
+    {
+        by_name.emplace(metric.name(), metric);
+    }
+
+    EvaluateASTMap eval_map;
+    for(auto& [_, metric] : by_name)
+    {
+        auto ast = get_raw_ast(metric);
+        if(!ast)
+        {
+            ROCP_ERROR << fmt::format("Unable to parse metric {}", metric);
+            throw std::runtime_error(fmt::format("Unable to parse metric {}", metric));
+        }
+        try
+        {
+            auto& evaluate_ast_node =
+                eval_map
+                    .emplace(metric.name(),
+                             EvaluateAST({.handle = metric.id()}, by_name, *ast, gfx))
+                    .first->second;
+            evaluate_ast_node.validate_raw_ast(
+                by_name);  // TODO: refactor and consolidate internal post-construction
+                           // logic as a Finish() method
+        } catch(std::exception& e)
         {
-            // TODO: Remove global XML from derived counters...
-            if(gfx == "global") continue;
+            ROCP_ERROR << e.what();
+            throw std::runtime_error(
+                fmt::format("AST was not generated for {}:{}", gfx, metric.name()));
+        }
+    }
 
-            std::unordered_map<std::string, Metric> by_name;
-            for(const auto& metric : metrics)
-            {
-                by_name.emplace(metric.name(), metric);
-            }
+    for(auto& [name, ast] : eval_map)
+    {
+        ast.expand_derived(eval_map);
+    }
+    return eval_map;
+}
 
-            auto& eval_map = data.emplace(gfx, EvaluateASTMap{}).first->second;
-            for(auto& [_, metric] : by_name)
-            {
-                RawAST* ast = nullptr;
-                auto*   buf =
-                    yy_scan_string(metric.expression().empty() ? metric.name().c_str()
-                                                               : metric.expression().c_str());
-                yyparse(&ast);
-                if(!ast)
-                {
-                    ROCP_ERROR << fmt::format("Unable to parse metric {}", metric);
-                    throw std::runtime_error(fmt::format("Unable to parse metric {}", metric));
-                }
-                try
-                {
-                    auto& evaluate_ast_node =
-                        eval_map
-                            .emplace(metric.name(),
-                                     EvaluateAST({.handle = metric.id()}, by_name, *ast, gfx))
-                            .first->second;
-                    evaluate_ast_node.validate_raw_ast(
-                        by_name);  // TODO: refactor and consolidate internal post-construction
-                                   // logic as a Finish() method
-                } catch(std::exception& e)
-                {
-                    ROCP_ERROR << e.what();
-                    throw std::runtime_error(
-                        fmt::format("AST was not generated for {}:{}", gfx, metric.name()));
-                }
-                yy_delete_buffer(buf);
-                delete ast;
-            }
+// ASTs constructed so far, by agent. Entries are never removed so pointers stay valid.
+common::Synchronized<std::unordered_map<std::string, EvaluateASTMap>>&
+get_ast_cache()
+{
+    static common::Synchronized<std::unordered_map<std::string, EvaluateASTMap>> cache = {};
+    return cache;
+}
+}  // namespace
 
-            for(auto& [name, ast] : eval_map)
-            {
-                ast.expand_derived(eval_map);
-            }
-        }
+const EvaluateASTMap*
+get_agent_ast_map(const std::string& agent)
+{
+    return get_ast_cache().wlock([&agent](auto& cache) -> const EvaluateASTMap* {
+        if(const auto* eval_map = rocprofiler::common::get_val(cache, agent)) return eval_map;
+
+        // TODO: Remove global XML from derived counters...
+        if(agent == "global") return nullptr;
+        const auto* metrics =
+            rocprofiler::common::get_val(*CHECK_NOTNULL(counters::getMetricMap()), agent);
+        if(!metrics) return nullptr;
+        return &cache.emplace(agent, build_agent_ast_map(agent, *metrics)).first->second;
+    });
+}
 
-        return data;
+const std::unordered_map<std::string, EvaluateASTMap>&
+get_ast_map()
+{
+    static const auto& ast_map = []() -> const std::unordered_map<std::string, EvaluateASTMap>& {
+        for(const auto& [gfx, _] : *CHECK_NOTNULL(counters::getMetricMap()))
+            get_agent_ast_map(gfx);
+        return get_ast_cache().rlock(
+            [](const auto& cache) -> const std::unordered_map<std::string, EvaluateASTMap>& {
+                return cache;
+            });
     }();
     return ast_map;
 }
 
+std::optional<std::set<Metric>>
+get_required_hardware_counters(const EvaluateASTMap& asts, const Metric& metric)
+{
+    const auto* counter_ast = rocprofiler::common::get_val(asts, metric.name());
+    if(!counter_ast) return std::nullopt;
+
+    std::set<Metric> required_counters;
+    counter_ast->get_required_counters(asts, required_counters);
+    return required_counters;
+}
+
 std::optional<std::set<Metric>>
 get_required_hardware_counters(const std::unordered_map<std::string, EvaluateASTMap>& asts,
                                const std::string&                                     agent,
@@ -308,12 +357,7 @@ get_required_hardware_counters(const std::unordered_map<std::string, EvaluateAST
 {
     const auto* agent_map = rocprofiler::common::get_val(asts, agent);
     if(!agent_map) return std::nullopt;
-    const auto* counter_ast = rocprofiler::common::get_val(*agent_map, metric.name());
-    if(!counter_ast) return std::nullopt;
-
-    std::set<Metric> required_counters;
-    counter_ast->get_required_counters(*agent_map, required_counters);
-    return required_counters;
+    return get_required_hardware_counters(*agent_map, metric);
 }
 
 EvaluateAST::EvaluateAST(rocprofiler_counter_id_t                       out_id,
@@ -614,38 +658,80 @@ get_agent_property(std::string_view property, const rocprofiler_agent_t& agent)
     });
 }
 
-void
-EvaluateAST::read_special_counters(
-    const rocprofiler_agent_t&        agent,
-    const std::set<counters::Metric>& required_special_counters,
-    std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>& out_map)
+DecodeArena::DecodeArena(const std::vector<uint64_t>& metric_ids)
 {
-    for(const auto& metric : required_special_counters)
+    for(auto id : metric_ids)
     {
-        if(!out_map[metric.id()].empty()) out_map[metric.id()].clear();
-        auto& record = out_map[metric.id()].emplace_back();
-        set_counter_in_rec(record.id, {.handle = metric.id()});
-        set_dim_in_rec(record.id, ROCPROFILER_DIMENSION_NONE, 0);
-
-        record.counter_value = get_agent_property(metric.name(), agent);
+        if(id >= _slots.size()) _slots.resize(id + 1, no_slot);
+        if(_slots[id] != no_slot) continue;
+        _slots[id] = static_cast<int32_t>(_records.size());
+        _records.emplace_back();
     }
 }
 
-std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>
-EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket& pkt)
+void
+DecodeArena::clear()
+{
+    for(auto& records : _records)
+        records.clear();
+}
+
+bool
+DecodeArena::empty() const
+{
+    for(const auto& records : _records)
+        if(!records.empty()) return false;
+    return true;
+}
+
+DecodeArena::records_t*
+DecodeArena::get(uint64_t metric_id)
+{
+    if(metric_id >= _slots.size() || _slots[metric_id] == no_slot) return nullptr;
+    return &_records[_slots[metric_id]];
+}
+
+const DecodeArena::records_t*
+DecodeArena::get(uint64_t metric_id) const
+{
+    if(metric_id >= _slots.size() || _slots[metric_id] == no_slot) return nullptr;
+    return &_records[_slots[metric_id]];
+}
+
+namespace
+{
+void
+write_special_counter(std::vector<rocprofiler_record_counter_t>& records,
+                      const counters::Metric&                    metric,
+                      const rocprofiler_agent_t&                 agent)
+{
+    records.clear();
+    auto& record = records.emplace_back();
+    set_counter_in_rec(record.id, {.handle = metric.id()});
+    set_dim_in_rec(record.id, ROCPROFILER_DIMENSION_NONE, 0);
+
+    record.counter_value = get_agent_property(metric.name(), agent);
+}
+
+/**
+ * Iterate the samples of an AQL packet. get_records(metric_id) returns the vector the
+ * record of the sample is appended to or nullptr if the sample should be dropped.
+ */
+template <typename FuncT>
+void
+iterate_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket& pkt, FuncT&& get_records)
 {
     struct it_data
     {
-        std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>* data;
-        const aql::CounterPacketConstruct*                                       pkt_gen;
-        aqlprofile_agent_handle_t                                                agent;
+        std::remove_reference_t<FuncT>*    get_records;
+        const aql::CounterPacketConstruct* pkt_gen;
+        aqlprofile_agent_handle_t          agent;
     };
 
     auto aql_agent = *CHECK_NOTNULL(rocprofiler::agent::get_aql_agent(pkt_gen->agent()));
 
-    std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>> ret;
-    if(pkt.empty) return ret;
-    it_data aql_data{.data = &ret, .pkt_gen = pkt_gen, .agent = aql_agent};
+    if(pkt.empty) return;
+    it_data aql_data{.get_records = &get_records, .pkt_gen = pkt_gen, .agent = aql_agent};
 
     hsa_status_t status = aqlprofile_pmc_iterate_data(
         pkt.handle,
@@ -656,9 +742,10 @@ EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket
 
             if(!metric) return HSA_STATUS_SUCCESS;
 
-            auto& vec = it.data->emplace(metric->id(), std::vector<rocprofiler_record_counter_t>{})
-                            .first->second;
-            auto& next_rec = vec.emplace_back();
+            auto* vec = (*it.get_records)(metric->id());
+            if(!vec) return HSA_STATUS_SUCCESS;
+
+            auto& next_rec = vec->emplace_back();
             set_counter_in_rec(next_rec.id, {.handle = metric->id()});
             // Actual dimension info needs to be used here in the future
             auto aql_status = aql::set_dim_id_from_sample(next_rec.id, it.agent, event, counter_id);
@@ -676,9 +763,47 @@ EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket
     {
         ROCP_ERROR << "AqlProfile could not decode packet";
     }
+}
+}  // namespace
+
+void
+EvaluateAST::read_special_counters(
+    const rocprofiler_agent_t&        agent,
+    const std::set<counters::Metric>& required_special_counters,
+    std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>& out_map)
+{
+    for(const auto& metric : required_special_counters)
+        write_special_counter(out_map[metric.id()], metric, agent);
+}
+
+void
+EvaluateAST::read_special_counters(const rocprofiler_agent_t&        agent,
+                                   const std::set<counters::Metric>& required_special_counters,
+                                   DecodeArena&                      arena)
+{
+    for(const auto& metric : required_special_counters)
+    {
+        if(auto* records = arena.get(metric.id())) write_special_counter(*records, metric, agent);
+    }
+}
+
+std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>
+EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen, hsa::AQLPacket& pkt)
+{
+    std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>> ret;
+    iterate_pkt(pkt_gen, pkt, [&ret](uint64_t metric_id) { return &ret[metric_id]; });
     return ret;
 }
 
+void
+EvaluateAST::read_pkt(const aql::CounterPacketConstruct* pkt_gen,
+                      hsa::AQLPacket&                    pkt,
+                      DecodeArena&                       arena)
+{
+    arena.clear();
+    iterate_pkt(pkt_gen, pkt, [&arena](uint64_t metric_id) { return arena.get(metric_id); });
+}
+
 void
 EvaluateAST::set_out_id(std::vector<rocprofiler_record_counter_t>& results) const
 {
@@ -836,5 +961,406 @@ EvaluateAST::evaluate(
     return nullptr;
 }
 
+namespace
+{
+template <typename OpT>
+void
+apply_op(double* __restrict a, const double* __restrict b, size_t n, OpT&& op)
+{
+    for(size_t i = 0; i < n; ++i)
+        a[i] = op(a[i], b[i]);
+}
+
+template <typename OpT>
+void
+apply_op(double* __restrict a, double b, size_t n, OpT&& op)
+{
+    for(size_t i = 0; i < n; ++i)
+        a[i] = op(a[i], b);
+}
+
+template <typename OpT>
+void
+apply_op(EvaluateProgram::register_t& a, const EvaluateProgram::register_t& b, OpT&& op)
+{
+    const auto n1 = a.values.size();
+    const auto n2 = b.values.size();
+
+    CHECK(n1 > 0 && n2 > 0);
+
+    if(n2 == 1)
+        apply_op(a.values.data(), b.values.front(), n1, std::forward<OpT>(op));
+    else if(n1 == n2)
+        apply_op(a.values.data(), b.values.data(), n1, std::forward<OpT>(op));
+    else
+        throw std::runtime_error(fmt::format("Mismatched Sizes {}, {}", n1, n2));
+}
+
+/**
+ * Writes the output records, the equivalent of set_out_id() on a copy of the records
+ */
+template <typename FuncT>
+void
+write_output(std::vector<rocprofiler_record_counter_t>& output,
+             rocprofiler_counter_id_t                   counter,
+             size_t                                     n,
+             FuncT&&                                    get_record)
+{
+    rocprofiler_counter_instance_id_t out_id = 0;
+    set_counter_in_rec(out_id, counter);
+    constexpr auto dim_mask = MAX_64 >> COUNTER_BIT_LENGTH;
+
+    output.resize(n);
+    for(size_t i = 0; i < n; ++i)
+    {
+        auto [id, value]     = get_record(i);
+        auto& record         = output[i];
+        record.id            = (id & dim_mask) | out_id;
+        record.counter_value = value;
+        record.dispatch_id   = 0;
+        record.user_data     = {.value = 0};
+        record.agent_id      = {.handle = 0};
+    }
+}
+
+/**
+ * Reduce all instances to a single value. Same as perform_reduction_to_single_instance: the
+ * first minimum/maximum keeps its instance id while the sum and average use id 0.
+ */
+void
+reduce_all(ReduceOperation reduce_op, EvaluateProgram::register_t& reg)
+{
+    const auto*                       values = reg.values.data();
+    const auto                        n      = reg.values.size();
+    auto                              result = 0.0;
+    rocprofiler_counter_instance_id_t id     = 0;
+
+    switch(reduce_op)
+    {
+        case REDUCE_NONE: break;
+        case REDUCE_MIN:
+        case REDUCE_MAX:
+        {
+            size_t pos = 0;
+            for(size_t i = 1; i < n; ++i)
+            {
+                bool better = (reduce_op == REDUCE_MIN) ? (values[i] < values[pos])
+                                                        : (values[pos] < values[i]);
+                if(better) pos = i;
+            }
+            result = values[pos];
+            id     = reg.id(pos);
+            break;
+        }
+        case REDUCE_SUM:
+        case REDUCE_AVG:
+        {
+            for(size_t i = 0; i < n; ++i)
+                result += values[i];
+            if(reduce_op == REDUCE_AVG) result /= n;
+            break;
+        }
+    }
+
+    set_dim_in_rec(id, ROCPROFILER_DIMENSION_NONE, 0);
+    reg.values.assign(1, result);
+    reg.set_ids(1, id);
+}
+
+/**
+ * Reduce the instances which only differ in the masked dimensions. The groups are kept in an
+ * unordered_map keyed the same way as perform_reduction so that the output order matches.
+ */
+void
+reduce_dimensions(ReduceOperation reduce_op, uint64_t mask, EvaluateProgram::register_t& reg)
+{
+    struct group_t
+    {
+        double                            value{0};
+        rocprofiler_counter_instance_id_t id{0};
+        size_t                            count{0};
+    };
+
+    auto groups = std::unordered_map<int64_t, group_t>{};
+    for(size_t i = 0; i < reg.values.size(); ++i)
+    {
+        auto  id    = reg.id(i) & ~mask;
+        auto  value = reg.values[i];
+        auto& group = groups[id];
+
+        switch(reduce_op)
+        {
+            case REDUCE_NONE: break;
+            case REDUCE_MIN:
+            case REDUCE_MAX:
+            {
+                bool better = (reduce_op == REDUCE_MIN) ? (value < group.value)
+                                                        : (group.value < value);
+                if(group.count == 0 || better)
+                {
+                    group.value = value;
+                    group.id    = id;
+                }
+                break;
+            }
+            case REDUCE_SUM:
+            case REDUCE_AVG: group.value += value; break;
+        }
+        ++group.count;
+    }
+
+    reg.values.clear();
+    reg.set_ids(0, 0);
+    for(auto& [key, group] : groups)
+    {
+        if(reduce_op == REDUCE_AVG) group.value /= group.count;
+        reg.values.emplace_back(group.value);
+        reg.ids.emplace_back(group.id);
+    }
+
+    if(reg.ids.size() == 1) set_dim_in_rec(reg.ids.front(), ROCPROFILER_DIMENSION_NONE, 0);
+}
+}  // namespace
+
+void
+EvaluateProgram::register_t::set_ids(size_t n, rocprofiler_counter_instance_id_t id)
+{
+    ids.assign(n, id);
+    records = nullptr;
+}
+
+void
+EvaluateProgram::register_t::own_ids()
+{
+    if(!records) return;
+    ids.assign(values.size(), 0);
+    for(size_t i = 0; i < ids.size(); ++i)
+        ids[i] = records[i].id;
+    records = nullptr;
+}
+
+EvaluateProgram::EvaluateProgram(const EvaluateAST& ast)
+: _out_id(ast.out_id())
+{
+    compile(ast, 0);
+}
+
+void
+EvaluateProgram::compile(const EvaluateAST& ast, uint32_t reg)
+{
+    _num_registers = std::max<size_t>(_num_registers, reg + 1);
+
+    auto emit = [&](opcode_t op) -> instruction_t& {
+        auto& inst = _instructions.emplace_back();
+        inst.op    = op;
+        inst.dst   = reg;
+        return inst;
+    };
+
+    auto emit_binary = [&](opcode_t op) {
+        compile(ast.children().at(0), reg);
+        compile(ast.children().at(1), reg + 1);
+        emit(op).src = reg + 1;
+    };
+
+    switch(ast.type())
+    {
+        case NONE:
+        case CONSTANT_NODE:
+        case RANGE_NODE: _valid = false; break;
+        case NUMBER_NODE: emit(OP_CONSTANT).value = ast.raw_value(); break;
+        case ADDITION_NODE: emit_binary(OP_ADD); break;
+        case SUBTRACTION_NODE: emit_binary(OP_SUB); break;
+        case MULTIPLY_NODE: emit_binary(OP_MUL); break;
+        case DIVIDE_NODE: emit_binary(OP_DIV); break;
+        case ACCUMULATE_NODE:
+        case REFERENCE_NODE:
+        {
+            emit(OP_LOAD).arg = ast.metric().id();
+            _metric_names.emplace(ast.metric().id(), ast.metric().name());
+        }
+        break;
+        case REDUCE_NODE:
+        {
+            compile(ast.children().at(0), reg);
+
+            const auto& dims       = ast.reduce_dimension_set();
+            size_t      bit_length = DIM_BIT_LENGTH / ROCPROFILER_DIMENSION_LAST;
+            uint64_t    mask       = 0;
+            for(auto dim : dims)
+                mask |= (MAX_64 >> (64 - bit_length)) << ((dim - 1) * bit_length);
+
+            auto& inst      = emit(OP_REDUCE);
+            inst.reduce_op  = ast.reduce_op();
+            inst.reduce_all = dims.empty() || dims.size() == ROCPROFILER_DIMENSION_LAST - 1;
+            inst.arg        = mask;
+        }
+        break;
+        case SELECT_NODE:
+        {
+            compile(ast.children().at(0), reg);
+
+            auto& selections = _selections.emplace_back();
+            for(const auto& [dim, range] : ast.select_dimension_map())
+            {
+                auto& selection     = selections.emplace_back();
+                selection.dimension = dim;
+                selection.range     = range;
+                try
+                {
+                    selection.encoded = get_int_encoded_dimensions_from_string(range);
+                } catch(std::exception&)
+                {
+                    // reported when evaluated, same as EvaluateAST::evaluate
+                }
+            }
+            emit(OP_SELECT).arg = _selections.size() - 1;
+        }
+        break;
+    }
+}
+
+template <typename LookupT>
+std::vector<rocprofiler_record_counter_t>*
+EvaluateProgram::evaluate_impl(LookupT&& lookup, scratch_t& scratch) const
+{
+    if(!_valid) return nullptr;
+
+    // base counters are copied as is
+    if(_instructions.size() == 1 && _instructions.front().op == OP_LOAD)
+    {
+        const auto  id     = _instructions.front().arg;
+        const auto* result = lookup(id);
+        if(!result)
+            throw std::runtime_error(
+                fmt::format("Unable to lookup results for metric {}", _metric_names.at(id)));
+
+        const auto* records = result->data();
+        write_output(scratch.output, _out_id, result->size(), [records](size_t i) {
+            return std::make_pair(records[i].id, records[i].counter_value);
+        });
+        return &scratch.output;
+    }
+
+    auto& regs = scratch.registers;
+    if(regs.size() < _num_registers) regs.resize(_num_registers);
+
+    for(const auto& inst : _instructions)
+    {
+        auto& dst = regs[inst.dst];
+        switch(inst.op)
+        {
+            case OP_LOAD:
+            {
+                const auto* result = lookup(inst.arg);
+                if(!result)
+                    throw std::runtime_error(fmt::format("Unable to lookup results for metric {}",
+                                                         _metric_names.at(inst.arg)));
+
+                const auto n = result->size();
+                dst.values.resize(n);
+                for(size_t i = 0; i < n; ++i)
+                    dst.values[i] = (*result)[i].counter_value;
+                dst.records = result->data();
+            }
+            break;
+            case OP_CONSTANT:
+            {
+                dst.values.assign(1, inst.value);
+                dst.set_ids(1, 0);
+            }
+            break;
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+            {
+                // the output takes the instances of the larger operand, which becomes the
+                // left-hand side of the operation (see EvaluateAST::evaluate)
+                auto& src = regs[inst.src];
+                if(dst.values.size() < src.values.size()) std::swap(dst, src);
+
+                if(inst.op == OP_ADD)
+                    apply_op(dst, src, [](double a, double b) { return a + b; });
+                else if(inst.op == OP_SUB)
+                    apply_op(dst, src, [](double a, double b) { return a - b; });
+                else if(inst.op == OP_MUL)
+                    apply_op(dst, src, [](double a, double b) { return a * b; });
+                else
+                    apply_op(dst, src, [](double a, double b) { return (b == 0 ? 0 : a / b); });
+            }
+            break;
+            case OP_REDUCE:
+            {
+                if(inst.reduce_op == REDUCE_NONE)
+                    throw std::runtime_error(fmt::format("Invalid Second argument to reduce(): {}",
+                                                         static_cast<int>(inst.reduce_op)));
+                if(dst.values.empty()) break;
+
+                if(inst.reduce_all)
+                    reduce_all(inst.reduce_op, dst);
+                else
+                    reduce_dimensions(inst.reduce_op, inst.arg, dst);
+            }
+            break;
+            case OP_SELECT:
+            {
+                size_t bit_length = DIM_BIT_LENGTH / ROCPROFILER_DIMENSION_LAST;
+                dst.own_ids();
+                for(const auto& selection : _selections.at(inst.arg))
+                {
+                    if(dst.values.empty()) break;
+
+                    int64_t encoded = selection.encoded
+                                          ? *selection.encoded
+                                          : get_int_encoded_dimensions_from_string(selection.range);
+                    int64_t mask =
+                        (MAX_64 >> (64 - bit_length)) << ((selection.dimension - 1) * bit_length);
+
+                    size_t kept = 0;
+                    for(size_t i = 0; i < dst.values.size(); ++i)
+                    {
+                        auto id = dst.ids[i];
+                        if((encoded & (1 << rec_to_dim_pos(id, selection.dimension))) == 0)
+                            continue;
+                        dst.values[kept] = dst.values[i];
+                        dst.ids[kept]    = (id | mask) ^ mask;
+                        ++kept;
+                    }
+                    dst.values.resize(kept);
+                    dst.ids.resize(kept);
+                }
+            }
+            break;
+        }
+    }
+
+    auto& result = regs.front();
+    result.own_ids();
+    write_output(scratch.output, _out_id, result.values.size(), [&](size_t i) {
+        return std::make_pair(result.ids[i], result.values[i]);
+    });
+    return &scratch.output;
+}
+
+std::vector<rocprofiler_record_counter_t>*
+EvaluateProgram::evaluate(const results_map_t& results_map, scratch_t& scratch) const
+{
+    return evaluate_impl(
+        [&results_map](uint64_t id) { return rocprofiler::common::get_val(results_map, id); },
+        scratch);
+}
+
+std::vector<rocprofiler_record_counter_t>*
+EvaluateProgram::evaluate(const DecodeArena& arena, scratch_t& scratch) const
+{
+    return evaluate_impl(
+        [&arena](uint64_t id) -> const DecodeArena::records_t* {
+            const auto* records = arena.get(id);
+            return (records && !records->empty()) ? records : nullptr;
+        },
+        scratch);
+}
+
 }  // namespace counters
 }  // namespace rocprofiler
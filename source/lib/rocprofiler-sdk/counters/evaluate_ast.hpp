@@ -22,8 +22,13 @@
 
 #pragma once
 
+#include <map>
+#include <optional>
 #include <set>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "lib/rocprofiler-sdk/aql/packet_construct.hpp"
 #include "lib/rocprofiler-sdk/counters/dimensions.hpp"
@@ -61,6 +66,38 @@ enum ReduceOperation
     REDUCE_AVG,
 };
 
+/**
+ * @brief Reusable storage for the records decoded from the AQL packet of a profile. The
+ *        metrics of the profile (hardware and special counters) are assigned a dense slot
+ *        when the arena is constructed, lookups are an index into a table instead of a
+ *        hash. Clearing the arena keeps the capacity of every slot, decoding into an arena
+ *        that was used before does not allocate unless a metric has more instances than
+ *        previously seen.
+ */
+class DecodeArena
+{
+public:
+    using records_t = std::vector<rocprofiler_record_counter_t>;
+
+    DecodeArena() = default;
+    explicit DecodeArena(const std::vector<uint64_t>& metric_ids);
+
+    // Remove the records of all metrics
+    void clear();
+    // True if no records are stored for any metric
+    bool empty() const;
+
+    // Records of a metric, nullptr if the metric is not part of the arena
+    records_t*       get(uint64_t metric_id);
+    const records_t* get(uint64_t metric_id) const;
+
+private:
+    static constexpr int32_t no_slot = -1;
+
+    std::vector<int32_t>   _slots{};  // metric id -> index into _records
+    std::vector<records_t> _records{};
+};
+
 class EvaluateAST
 {
 public:
@@ -137,6 +174,15 @@ public:
         const aql::CounterPacketConstruct* pkt_gen,
         hsa::AQLPacket&                    pkt);
 
+    /**
+     * @brief Same as above but the records are written into an arena. Previous contents
+     *        of the arena are cleared. Records of metrics that are not part of the arena
+     *        are dropped.
+     */
+    static void read_pkt(const aql::CounterPacketConstruct* pkt_gen,
+                         hsa::AQLPacket&                    pkt,
+                         DecodeArena&                       arena);
+
     /**
      * @brief Insert special counter values, such as constants of the agent (i.e. max waves)
      *        and kernel duration into the output map.
@@ -150,11 +196,28 @@ public:
         const std::set<counters::Metric>& required_special_counters,
         std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>& out_map);
 
+    static void read_special_counters(const rocprofiler_agent_t&        agent,
+                                      const std::set<counters::Metric>& required_special_counters,
+                                      DecodeArena&                      arena);
+
     NodeType                            type() const { return _type; }
     ReduceOperation                     reduce_op() const { return _reduce_op; }
     const std::vector<EvaluateAST>&     children() const { return _children; }
     const Metric&                       metric() const { return _metric; }
     const std::vector<MetricDimension>& dimension_types() const { return _dimension_types; }
+    double                              raw_value() const { return _raw_value; }
+
+    const std::unordered_set<rocprofiler_profile_counter_instance_types>& reduce_dimension_set()
+        const
+    {
+        return _reduce_dimension_set;
+    }
+
+    const std::map<rocprofiler_profile_counter_instance_types, std::string>& select_dimension_map()
+        const
+    {
+        return _select_dimension_map;
+    }
 
     /**
      * @brief When an evaluation is complete, set the output id of the results. This is called
@@ -181,6 +244,125 @@ private:
     rocprofiler_counter_id_t                                          _out_id{.handle = 0};
 };
 
+/**
+ * @brief Linear form of an EvaluateAST used to evaluate counters at the end of a dispatch
+ *        or sample. The AST is flattened into a list of instructions in evaluation order.
+ *        Each instruction reads and writes registers which store the values and the
+ *        instance ids of a node in separate arrays, so that the arithmetic operations are
+ *        simple loops over doubles. Registers are allocated as a stack, the number of
+ *        registers is the depth of the AST.
+ *
+ *        The results are identical to EvaluateAST::evaluate() followed by
+ *        EvaluateAST::set_out_id(), except that dispatch_id, user_data and agent_id of the
+ *        output records are zero. These fields are set by the caller.
+ */
+class EvaluateProgram
+{
+public:
+    using results_map_t = std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>;
+
+    struct register_t
+    {
+        std::vector<double>                            values{};
+        std::vector<rocprofiler_counter_instance_id_t> ids{};
+        // ids are read from the loaded records until an operation changes them
+        const rocprofiler_record_counter_t* records{nullptr};
+
+        rocprofiler_counter_instance_id_t id(size_t i) const
+        {
+            return (records) ? records[i].id : ids[i];
+        }
+
+        void set_ids(size_t n, rocprofiler_counter_instance_id_t id);
+        void own_ids();
+    };
+
+    /**
+     * @brief Registers and output storage of evaluate(). Reusing the same scratch (i.e.
+     *        one per thread) avoids any allocations once the registers have grown to the
+     *        largest result.
+     */
+    struct scratch_t
+    {
+        std::vector<register_t>                   registers{};
+        std::vector<rocprofiler_record_counter_t> output{};
+    };
+
+    /**
+     * @brief Compile an AST. The AST should be expanded (see EvaluateAST::expand_derived)
+     *        beforehand. Throws if a node has an unexpected number of children.
+     */
+    explicit EvaluateProgram(const EvaluateAST& ast);
+
+    /**
+     * @brief Evaluate the program on the decoded results.
+     *
+     * @param [in] results_map  Results decoded from the AQL packet. Not modified.
+     * @param [in] scratch      Storage for the registers and the output
+     *
+     * @return std::vector<rocprofiler_record_counter_t>* Output records with the out id
+     *          set, stored in scratch and valid until scratch is used again. nullptr if
+     *          the AST cannot be evaluated.
+     */
+    std::vector<rocprofiler_record_counter_t>* evaluate(const results_map_t& results_map,
+                                                        scratch_t&           scratch) const;
+
+    /**
+     * @brief Evaluate the program on results decoded into an arena. A metric without
+     *        records in the arena is treated as missing.
+     */
+    std::vector<rocprofiler_record_counter_t>* evaluate(const DecodeArena& arena,
+                                                        scratch_t&         scratch) const;
+
+    const rocprofiler_counter_id_t& out_id() const { return _out_id; }
+    size_t                          num_instructions() const { return _instructions.size(); }
+    size_t                          num_registers() const { return _num_registers; }
+
+private:
+    enum opcode_t
+    {
+        OP_LOAD = 0,
+        OP_CONSTANT,
+        OP_ADD,
+        OP_SUB,
+        OP_MUL,
+        OP_DIV,
+        OP_REDUCE,
+        OP_SELECT,
+    };
+
+    struct selection_t
+    {
+        rocprofiler_profile_counter_instance_types dimension{};
+        std::string                                range{};
+        std::optional<int64_t>                     encoded{};
+    };
+
+    struct instruction_t
+    {
+        opcode_t        op{OP_LOAD};
+        ReduceOperation reduce_op{REDUCE_NONE};
+        uint32_t        dst{0};  // output and first operand
+        uint32_t        src{0};  // second operand of arithmetic operations
+        uint64_t        arg{0};  // metric id, reduction mask, or index into _selections
+        double          value{0};
+        bool            reduce_all{false};
+    };
+
+    void compile(const EvaluateAST& ast, uint32_t reg);
+
+    template <typename LookupT>
+    std::vector<rocprofiler_record_counter_t>* evaluate_impl(LookupT&&  lookup,
+                                                             scratch_t& scratch) const;
+
+    std::vector<instruction_t>                _instructions{};
+    std::vector<std::vector<selection_t>>     _selections{};
+    std::unordered_map<uint64_t, std::string> _metric_names{};
+    size_t                                    _num_registers{0};
+    bool                                      _valid{true};
+    rocprofiler_counter_id_t                  _out_id{.handle = 0};
+};
+
 using EvaluateASTMap = std::unordered_map<std::string, EvaluateAST>;
 
 /**
@@ -190,6 +372,13 @@ using EvaluateASTMap = std::unordered_map<std::string, EvaluateAST>;
 const std::unordered_map<std::string, EvaluateASTMap>&
 get_ast_map();
 
+/**
+ * Construct the ASTs of the counters of a single agent (GFXIP) on first use.
+ * Returns nullptr if the agent has no counter definitions.
+ */
+const EvaluateASTMap*
+get_agent_ast_map(const std::string& agent);
+
 /**
  * Get the required basic/hardware counters needed to evaluate a
  * specific metric (may be multiple HW counters if a derived metric).
@@ -198,6 +387,9 @@ std::optional<std::set<Metric>>
 get_required_hardware_counters(const std::unordered_map<std::string, EvaluateASTMap>& asts,
                                const std::string&                                     agent,
                                const Metric&                                          metric);
+
+std::optional<std::set<Metric>>
+get_required_hardware_counters(const EvaluateASTMap& asts, const Metric& metric);
 int64_t
 get_agent_property(std::string_view property, const rocprofiler_agent_t& agent);
 }  // namespace counters
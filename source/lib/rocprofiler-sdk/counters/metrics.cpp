@@ -29,22 +29,18 @@
 #include "lib/common/synchronized.hpp"
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk/agent.hpp"
+#include "lib/rocprofiler-sdk/counters/counter_db.hpp"
 
 #include "glog/logging.h"
 
 #include "rocprofiler-sdk/fwd.h"
-#include "yaml-cpp/exceptions.h"
-#include "yaml-cpp/node/convert.h"
-#include "yaml-cpp/node/detail/impl.h"
-#include "yaml-cpp/node/impl.h"
-#include "yaml-cpp/node/iterator.h"
-#include "yaml-cpp/node/node.h"
-#include "yaml-cpp/node/parse.h"
-#include "yaml-cpp/parser.h"
 
 #include <dlfcn.h>  // for dladdr
 #include <cstdint>
 #include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
 
 namespace rocprofiler
 {
@@ -96,24 +92,41 @@ get_constants()
     }
     return constants;
 }
+std::string
+findViaInstallPath(const std::string& filename)
+{
+    Dl_info dl_info = {};
+    ROCP_INFO << filename << " is being looked up via install path";
+    if(dladdr(reinterpret_cast<const void*>(rocprofiler_query_available_agents), &dl_info) != 0)
+    {
+        return common::filesystem::path{dl_info.dli_fname}.parent_path().parent_path() /
+               fmt::format("share/rocprofiler-sdk/{}", filename);
+    }
+    return filename;
+}
+
+std::string
+findViaEnvironment(const std::string& filename)
+{
+    if(const char* metrics_path = nullptr; (metrics_path = getenv("ROCPROFILER_METRICS_PATH")))
+    {
+        ROCP_INFO << filename << " is being looked up via env variable ROCPROFILER_METRICS_PATH";
+        return common::filesystem::path{std::string{metrics_path}} / filename;
+    }
+    // No environment variable, lookup via install path
+    return findViaInstallPath(filename);
+}
+
 /**
- * Expected YAML Format:
- * COUNTER_NAME:
- *  architectures:
- *   gfxXX: // Can be more than one, / deliminated if they share idential data
- *     block: <Optional>
- *     event: <Optional>
- *     expression: <optional>
- *     description: <Optional>
- *   gfxYY:
- *      ...
- *  description: General counter desctiption
+ * Loads the counter definitions. The database precompiled from counter_defs.yaml at build
+ * time is used unless the definitions are changed by ROCPROFILER_METRICS_PATH, a custom
+ * counter definition or an edit of the installed counter_defs.yaml, in which case the YAML
+ * is compiled in memory.
  */
-MetricMap
-loadYAML(const std::string& filename, bool load_constants = false, bool load_derived = false)
+std::unique_ptr<CounterDatabase>
+loadCounterDatabase()
 {
-    MetricMap ret;
-    auto      override = getCustomCounterDefinition().wlock([&](auto& data) {
+    auto override = getCustomCounterDefinition().wlock([&](auto& data) {
         data.loaded = true;
         return data;
     });
@@ -121,9 +134,28 @@ loadYAML(const std::string& filename, bool load_constants = false, bool load_der
     std::stringstream counter_data;
     if(override.data.empty() || override.append)
     {
-        ROCP_INFO << "Loading Counter Config: " << filename;
-        std::ifstream file(filename);
+        auto counters_path = findViaEnvironment("counter_defs.yaml");
+        ROCP_FATAL_IF(!common::filesystem::exists(counters_path))
+            << "metric xml file '" << counters_path << "' does not exist";
+        std::ifstream file(counters_path);
         counter_data << file.rdbuf();
+
+        if(override.data.empty() && getenv("ROCPROFILER_METRICS_PATH") == nullptr)
+        {
+            auto db_path = findViaInstallPath("counter_defs.db");
+            if(auto db = CounterDatabase::open(db_path))
+            {
+                if(db->yaml_hash() == CounterDatabase::hash_yaml(counter_data.str()))
+                {
+                    ROCP_INFO << "Loading Counter Database: " << db_path;
+                    return db;
+                }
+                ROCP_WARNING << counters_path << " was modified after " << db_path
+                             << " was generated, the counter database is not used";
+            }
+        }
+
+        ROCP_INFO << "Loading Counter Config: " << counters_path;
     }
 
     if(!override.data.empty())
@@ -132,89 +164,42 @@ loadYAML(const std::string& filename, bool load_constants = false, bool load_der
         counter_data << override.data;
     }
 
-    auto yaml = YAML::Load(counter_data.str());
+    return CounterDatabase::from_yaml(counter_data.str());
+}
 
-    for(auto it = yaml.begin(); it != yaml.end(); ++it)
+MetricMap
+loadMetrics(bool load_constants, bool load_derived)
+{
+    MetricMap   ret;
+    const auto& db = *CHECK_NOTNULL(getCounterDatabase());
+    for(size_t i = 0; i < db.size(); ++i)
     {
-        auto counter_name = it->first.as<std::string>();
-        if(counter_name == "schema-version") continue;
-        auto counter_def  = it->second;
-        auto def_iterator = counter_def["architectures"];
-
-        for(auto def_it = def_iterator.begin(); def_it != def_iterator.end(); ++def_it)
+        auto  def       = db.at(i);
+        auto  arch_name = std::string{def.architecture};
+        auto& metricVec = ret.emplace(arch_name, std::vector<Metric>()).first->second;
+        if(metricVec.empty() && load_constants)
         {
-            auto archs = def_it->first.as<std::string>();
-            auto def   = def_it->second;
-            // To save space in the YAML file, we combine architectures with the same
-            // definition into a single entry. Split these out into separate entries.
-            // architectures:
-            //     gfx10/gfx1010/gfx1030/gfx1031/.....9:
-            //     expression: 400*SQ_WAIT_INST_LDS/SQ_WAVES/GRBM_GUI_ACTIVE
-            std::vector<std::string> result;
-            std::stringstream        ss(archs);
-            std::string              arch_name;
-
-            while(std::getline(ss, arch_name, '/'))
-            {
-                auto& metricVec = ret.emplace(arch_name, std::vector<Metric>()).first->second;
-                if(metricVec.empty() && load_constants)
-                {
-                    metricVec.insert(
-                        metricVec.end(), get_constants().begin(), get_constants().end());
-                }
+            metricVec.insert(metricVec.end(), get_constants().begin(), get_constants().end());
+        }
 
-                if((def["expression"] && load_derived) || (!load_derived && !def["expression"]))
-                {
-                    std::string description;
-                    if(def["description"])
-                        description = def["description"].as<std::string>();
-                    else if(counter_def["description"])
-                        description = counter_def["description"].as<std::string>();
-                    metricVec.emplace_back(
-                        arch_name,
-                        counter_name,
-                        (def["block"] ? def["block"].as<std::string>() : ""),
-                        (def["event"] ? def["event"].as<std::string>() : ""),
-                        description,
-                        (def["expression"] ? def["expression"].as<std::string>() : ""),
-                        "",
-                        current_id());
-                    current_id()++;
-                    ROCP_TRACE << fmt::format("Inserted info {}: {}", arch_name, metricVec.back());
-                }
-            }
+        if(def.expression.empty() != load_derived)
+        {
+            metricVec.emplace_back(arch_name,
+                                   std::string{def.name},
+                                   std::string{def.block},
+                                   std::string{def.event},
+                                   std::string{def.description},
+                                   std::string{def.expression},
+                                   "",
+                                   current_id());
+            current_id()++;
+            ROCP_TRACE << fmt::format("Inserted info {}: {}", arch_name, metricVec.back());
         }
     }
     ROCP_FATAL_IF(current_id() > 65536)
         << "Counter count exceeds 16 bits, which may break counter id output";
     return ret;
 }
-
-std::string
-findViaInstallPath(const std::string& filename)
-{
-    Dl_info dl_info = {};
-    ROCP_INFO << filename << " is being looked up via install path";
-    if(dladdr(reinterpret_cast<const void*>(rocprofiler_query_available_agents), &dl_info) != 0)
-    {
-        return common::filesystem::path{dl_info.dli_fname}.parent_path().parent_path() /
-               fmt::format("share/rocprofiler-sdk/{}", filename);
-    }
-    return filename;
-}
-
-std::string
-findViaEnvironment(const std::string& filename)
-{
-    if(const char* metrics_path = nullptr; (metrics_path = getenv("ROCPROFILER_METRICS_PATH")))
-    {
-        ROCP_INFO << filename << " is being looked up via env variable ROCPROFILER_METRICS_PATH";
-        return common::filesystem::path{std::string{metrics_path}} / filename;
-    }
-    // No environment variable, lookup via install path
-    return findViaInstallPath(filename);
-}
-
 }  // namespace
 
 rocprofiler_status_t
@@ -229,22 +214,24 @@ setCustomCounterDefinition(const CustomCounterDefinition& def)
     });
 }
 
+const CounterDatabase*
+getCounterDatabase()
+{
+    static auto*& db =
+        common::static_object<std::unique_ptr<CounterDatabase>>::construct(loadCounterDatabase());
+    return CHECK_NOTNULL(db)->get();
+}
+
 MetricMap
 getDerivedHardwareMetrics()
 {
-    auto counters_path = findViaEnvironment("counter_defs.yaml");
-    ROCP_FATAL_IF(!common::filesystem::exists(counters_path))
-        << "metric xml file '" << counters_path << "' does not exist";
-    return loadYAML(counters_path, false, true);
+    return loadMetrics(false, true);
 }
 
 MetricMap
 getBaseHardwareMetrics()
 {
-    auto counters_path = findViaEnvironment("counter_defs.yaml");
-    ROCP_FATAL_IF(!common::filesystem::exists(counters_path))
-        << "metric xml file '" << counters_path << "' does not exist";
-    return loadYAML(counters_path, true, false);
+    return loadMetrics(true, false);
 }
 
 const MetricIdMap*
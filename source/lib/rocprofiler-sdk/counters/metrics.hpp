@@ -95,6 +95,14 @@ struct CustomCounterDefinition
 using MetricMap   = std::unordered_map<std::string, std::vector<Metric>>;
 using MetricIdMap = std::unordered_map<uint64_t, Metric>;
 
+class CounterDatabase;
+
+/**
+ * Counter definitions loaded from the precompiled database or the YAML file
+ */
+const CounterDatabase*
+getCounterDatabase();
+
 /**
  * Get base hardware counters for all GFXs Map<GFX Name, Counters>
  */
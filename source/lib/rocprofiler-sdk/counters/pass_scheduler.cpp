@@ -0,0 +1,299 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/rocprofiler-sdk/counters/pass_scheduler.hpp"
+#include "lib/common/logging.hpp"
+#include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
+
+#include <rocprofiler-sdk/rocprofiler.h>
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+namespace rocprofiler
+{
+namespace counters
+{
+namespace
+{
+// Number of passes tried by the search before the best assignment found so far is used
+constexpr size_t search_budget = 1ul << 16;
+
+struct counter_usage
+{
+    size_t counter = 0;  // index of the distinct hardware counter (id and flags)
+    size_t block   = 0;  // index into the block limits
+};
+
+struct pass_state
+{
+    std::unordered_map<size_t, size_t> refs         = {};  // requests using a counter
+    std::vector<int64_t>               block_counts = {};
+};
+
+class pass_search
+{
+public:
+    pass_search(std::vector<std::vector<counter_usage>> items,
+                std::vector<int64_t>                    limits,
+                size_t                                  lower_bound)
+    : _items{std::move(items)}
+    , _limits{std::move(limits)}
+    , _lower_bound{lower_bound}
+    , _assignment(_items.size(), 0)
+    , _required(_limits.size(), 0)
+    {}
+
+    std::vector<size_t> run()
+    {
+        search(0);
+        return _best_assignment;
+    }
+
+    size_t num_passes() const { return _best; }
+    size_t steps() const { return _steps; }
+
+private:
+    bool done() const { return _best <= _lower_bound || _steps >= search_budget; }
+
+    bool fits(const std::vector<counter_usage>& item, const pass_state& pass)
+    {
+        bool ok = true;
+        for(const auto& usage : item)
+        {
+            if(pass.refs.count(usage.counter) > 0) continue;
+            if(pass.block_counts[usage.block] + (++_required[usage.block]) > _limits[usage.block])
+                ok = false;
+        }
+        for(const auto& usage : item)
+            _required[usage.block] = 0;
+        return ok;
+    }
+
+    void add(const std::vector<counter_usage>& item, pass_state& pass)
+    {
+        for(const auto& usage : item)
+        {
+            if(pass.refs[usage.counter]++ == 0) ++pass.block_counts[usage.block];
+        }
+    }
+
+    void remove(const std::vector<counter_usage>& item, pass_state& pass)
+    {
+        for(const auto& usage : item)
+        {
+            auto itr = pass.refs.find(usage.counter);
+            if(--itr->second == 0)
+            {
+                --pass.block_counts[usage.block];
+                pass.refs.erase(itr);
+            }
+        }
+    }
+
+    void search(size_t idx)
+    {
+        ++_steps;
+        if(_passes.size() >= _best) return;
+        if(idx == _items.size())
+        {
+            _best            = _passes.size();
+            _best_assignment = _assignment;
+            return;
+        }
+
+        const auto& item = _items.at(idx);
+        for(size_t i = 0; i < _passes.size(); ++i)
+        {
+            if(!fits(item, _passes.at(i))) continue;
+
+            add(item, _passes.at(i));
+            _assignment.at(idx) = i;
+            search(idx + 1);
+            remove(item, _passes.at(i));
+            if(done()) return;
+        }
+
+        // a new pass is only useful if it can still beat the best assignment
+        if(_passes.size() + 1 >= _best) return;
+
+        _passes.emplace_back().block_counts.assign(_limits.size(), 0);
+        add(item, _passes.back());
+        _assignment.at(idx) = _passes.size() - 1;
+        search(idx + 1);
+        _passes.pop_back();
+    }
+
+    std::vector<std::vector<counter_usage>> _items           = {};
+    std::vector<int64_t>                    _limits          = {};
+    size_t                                  _lower_bound     = 0;
+    std::vector<size_t>                     _assignment      = {};
+    std::vector<size_t>                     _best_assignment = {};
+    std::vector<int64_t>                    _required        = {};
+    std::vector<pass_state>                 _passes          = {};
+    size_t                                  _best  = std::numeric_limits<size_t>::max();
+    size_t                                  _steps = 0;
+};
+}  // namespace
+
+rocprofiler_status_t
+partition_counter_passes(const std::vector<pass_request>& requests,
+                         const block_limit_func_t&        block_limit,
+                         std::vector<counter_pass>&       passes)
+{
+    passes.clear();
+    if(requests.empty()) return ROCPROFILER_STATUS_SUCCESS;
+
+    // Dense block indices and the distinct counters of every block
+    auto block_index    = std::unordered_map<std::string, size_t>{};
+    auto block_names    = std::vector<std::string>{};
+    auto limits         = std::vector<int64_t>{};
+    auto block_counters = std::vector<std::set<size_t>>{};
+    auto counter_index  = std::map<Metric, size_t>{};
+    auto items          = std::vector<std::vector<counter_usage>>{};
+    for(const auto& request : requests)
+    {
+        auto& item = items.emplace_back();
+        for(const auto& counter : request.hw_counters)
+        {
+            auto [itr, inserted] = block_index.emplace(counter.block(), limits.size());
+            if(inserted)
+            {
+                block_names.emplace_back(counter.block());
+                limits.emplace_back(block_limit(counter));
+                block_counters.emplace_back();
+            }
+            auto idx = counter_index.emplace(counter, counter_index.size()).first->second;
+            item.push_back({.counter = idx, .block = itr->second});
+            block_counters.at(itr->second).emplace(idx);
+        }
+
+        // the counters of a metric have to fit in a single pass
+        auto usage = std::vector<int64_t>(limits.size(), 0);
+        for(const auto& itr : item)
+        {
+            if(++usage.at(itr.block) > limits.at(itr.block))
+            {
+                ROCP_ERROR << fmt::format("{} requires more counters of block {} than the "
+                                          "hardware limit ({})",
+                                          request.metric.name(),
+                                          block_names.at(itr.block),
+                                          limits.at(itr.block));
+                return ROCPROFILER_STATUS_ERROR_EXCEEDS_HW_LIMIT;
+            }
+        }
+    }
+
+    size_t lower_bound = 1;
+    for(size_t i = 0; i < limits.size(); ++i)
+    {
+        auto count  = static_cast<int64_t>(block_counters.at(i).size());
+        lower_bound = std::max<size_t>(lower_bound, (count + limits.at(i) - 1) / limits.at(i));
+    }
+
+    // Most constrained metrics first: highest fraction of a block limit, then the most
+    // counters. Ties keep the order of the request so the result is deterministic.
+    auto weight = [&](size_t idx) {
+        auto usage = std::vector<int64_t>(limits.size(), 0);
+        auto value = 0.0;
+        for(const auto& itr : items.at(idx))
+        {
+            auto used = static_cast<double>(++usage.at(itr.block));
+            value     = std::max(value, used / static_cast<double>(limits.at(itr.block)));
+        }
+        return value;
+    };
+
+    auto order   = std::vector<size_t>(items.size());
+    auto weights = std::vector<double>(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    for(size_t i = 0; i < items.size(); ++i)
+        weights.at(i) = weight(i);
+    std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        if(weights.at(lhs) != weights.at(rhs)) return weights.at(lhs) > weights.at(rhs);
+        return items.at(lhs).size() > items.at(rhs).size();
+    });
+
+    auto sorted_items = std::vector<std::vector<counter_usage>>{};
+    for(auto idx : order)
+        sorted_items.emplace_back(items.at(idx));
+
+    auto search     = pass_search{std::move(sorted_items), limits, lower_bound};
+    auto assignment = search.run();
+
+    ROCP_INFO << fmt::format("Scheduled {} metrics in {} passes (lower bound: {}, steps: {})",
+                             requests.size(),
+                             search.num_passes(),
+                             lower_bound,
+                             search.steps());
+
+    // passes keep the request order of the metrics
+    auto pass_of = std::vector<size_t>(requests.size(), 0);
+    for(size_t i = 0; i < order.size(); ++i)
+        pass_of.at(order.at(i)) = assignment.at(i);
+
+    passes.resize(search.num_passes());
+    for(size_t i = 0; i < requests.size(); ++i)
+    {
+        auto& pass = passes.at(pass_of.at(i));
+        pass.metrics.emplace_back(requests.at(i).metric);
+        pass.hw_counters.insert(requests.at(i).hw_counters.begin(),
+                                requests.at(i).hw_counters.end());
+    }
+    return ROCPROFILER_STATUS_SUCCESS;
+}
+
+rocprofiler_status_t
+schedule_counter_passes(const EvaluateASTMap&      asts,
+                        const std::vector<Metric>& metrics,
+                        const block_limit_func_t&  block_limit,
+                        std::vector<counter_pass>& passes)
+{
+    auto requests = std::vector<pass_request>{};
+    for(const auto& metric : metrics)
+    {
+        auto req_counters = get_required_hardware_counters(asts, metric);
+        if(!req_counters)
+        {
+            ROCP_ERROR << fmt::format("Could not find counter {}", metric.name());
+            return ROCPROFILER_STATUS_ERROR_PROFILE_COUNTER_NOT_FOUND;
+        }
+
+        auto& request  = requests.emplace_back();
+        request.metric = metric;
+        for(const auto& counter : *req_counters)
+        {
+            if(counter.special().empty()) request.hw_counters.emplace(counter);
+        }
+    }
+
+    return partition_counter_passes(requests, block_limit, passes);
+}
+}  // namespace counters
+}  // namespace rocprofiler
@@ -0,0 +1,96 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
+#include "lib/rocprofiler-sdk/counters/metrics.hpp"
+
+#include <rocprofiler-sdk/fwd.h>
+
+#include <cstdint>
+#include <functional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace rocprofiler
+{
+namespace counters
+{
+// Maximum number of counters of a hardware block that can be collected at the same time
+// (per block instance). Called with one of the hardware counters of the block.
+using block_limit_func_t = std::function<int64_t(const Metric&)>;
+
+// A requested metric and the hardware counters required to evaluate it
+struct pass_request
+{
+    Metric           metric      = {};
+    std::set<Metric> hw_counters = {};
+};
+
+// Metrics that are collected together in a single dispatch
+struct counter_pass
+{
+    // requested metrics that are evaluated from this pass (in the order of the request)
+    std::vector<Metric> metrics = {};
+    // hardware counters collected by this pass
+    std::set<Metric> hw_counters = {};
+};
+
+/**
+ * @brief Partition requested metrics into the smallest number of passes for which the
+ *        hardware counters of every block stay within the block limit. The hardware counters
+ *        of a metric are always collected in the same pass and a hardware counter shared by
+ *        metrics of a pass is collected once. Passes are assigned by a search that starts
+ *        from first-fit decreasing and stops at the lower bound given by the most used block
+ *        (or after a fixed number of steps). The result only depends on the requests and the
+ *        block limits.
+ *
+ * @param [in] requests     Metrics and their hardware counters
+ * @param [in] block_limit  Block limits of the agent
+ * @param [out] passes      Passes, every requested metric is in exactly one pass
+ * @return ::rocprofiler_status_t ROCPROFILER_STATUS_ERROR_EXCEEDS_HW_LIMIT if the hardware
+ *         counters of a single metric exceed a block limit.
+ */
+rocprofiler_status_t
+partition_counter_passes(const std::vector<pass_request>& requests,
+                         const block_limit_func_t&        block_limit,
+                         std::vector<counter_pass>&       passes);
+
+/**
+ * @brief Same as partition_counter_passes() for the metrics of an agent. Derived metrics are
+ *        expanded into their hardware counters with get_required_hardware_counters().
+ *        Special counters (i.e. agent constants) do not use hardware counters.
+ *
+ * @param [in] asts         ASTs of the counters of the agent, normally get_agent_ast_map()
+ * @return ::rocprofiler_status_t ROCPROFILER_STATUS_ERROR_PROFILE_COUNTER_NOT_FOUND if a
+ *         metric is not defined for the agent.
+ */
+rocprofiler_status_t
+schedule_counter_passes(const EvaluateASTMap&      asts,
+                        const std::vector<Metric>& metrics,
+                        const block_limit_func_t&  block_limit,
+                        std::vector<counter_pass>& passes);
+}  // namespace counters
+}  // namespace rocprofiler
@@ -22,95 +22,233 @@
 
 #pragma once
 
+#include "lib/common/container/mpmc_queue.hpp"
 #include "lib/rocprofiler-sdk/counters/sample_processing.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace rocprofiler
 {
 namespace counters
 {
+// Backpressure of a consumer_thread_t
+struct consumer_stats_t
+{
+    size_t depth            = 0;  // data waiting in the queue
+    size_t max_depth        = 0;  // largest number of data waiting in the queue
+    size_t processed        = 0;  // data consumed by the worker threads
+    size_t inline_processed = 0;  // data consumed by the thread calling add()
+};
+
+/**
+ * Consumes data on a pool of worker threads. Data is passed through a bounded lock-free
+ * queue. When the queue is full (or no workers are running), the thread calling add()
+ * consumes the oldest data itself instead of blocking.
+ *
+ * Every data gets a sequence number in the order of add(). Work the consume function does
+ * between ticket_t::wait() and ticket_t::release() (i.e. writing records to a buffer)
+ * happens in sequence order, the rest of the consume function runs concurrently. The
+ * ticket is released when the consume function returns.
+ */
 template <typename DataType>
 class consumer_thread_t
 {
     static constexpr size_t SIZE = 128;
-    using consume_func_t         = std::function<void(DataType&&)>;
 
 public:
-    consumer_thread_t(consume_func_t func) { this->consume_fn = func; }
+    class ticket_t
+    {
+    public:
+        ~ticket_t() { release(); }
+
+        ticket_t(const ticket_t&) = delete;
+        ticket_t(ticket_t&&)      = delete;
+        ticket_t& operator=(const ticket_t&) = delete;
+        ticket_t& operator=(ticket_t&&) = delete;
+
+        // Wait until all data with a lower sequence number released their ticket
+        void wait() const
+        {
+            if(!done) consumer.wait_turn(seq);
+        }
+
+        // Let the data with the next sequence number proceed. Waits for the turn of this
+        // data first if wait() was not called.
+        void release()
+        {
+            if(done) return;
+            consumer.wait_turn(seq);
+            consumer.turn.store(seq + 1, std::memory_order_release);
+            done = true;
+        }
+
+        uint64_t sequence() const { return seq; }
+
+    private:
+        friend class consumer_thread_t;
+
+        ticket_t(consumer_thread_t& _consumer, uint64_t _seq)
+        : consumer{_consumer}
+        , seq{_seq}
+        {}
+
+        consumer_thread_t& consumer;
+        uint64_t           seq  = 0;
+        bool               done = false;
+    };
+
+    using consume_func_t        = std::function<void(DataType&&, ticket_t&)>;
+    using simple_consume_func_t = std::function<void(DataType&&)>;
+
+    consumer_thread_t(consume_func_t func, size_t num_workers = 1, size_t capacity = SIZE)
+    : consume_fn{std::move(func)}
+    , workers_count{std::max<size_t>(num_workers, 1)}
+    , queue{std::max<size_t>(capacity, 1)}
+    {}
+
+    consumer_thread_t(simple_consume_func_t func, size_t num_workers = 1, size_t capacity = SIZE)
+    : consumer_thread_t(
+          [func = std::move(func)](DataType&& data, ticket_t&) { func(std::move(data)); },
+          num_workers,
+          capacity)
+    {}
+
     virtual ~consumer_thread_t() { exit(); }
 
     void start()
     {
-        std::unique_lock<std::mutex> lk(mut);
+        std::unique_lock<std::mutex> lk(start_mut);
 
         if(valid.exchange(true)) return;
-        exited.store(false);
 
-        consumer = std::thread{&consumer_thread_t::consumer_loop, this};
+        for(size_t i = 0; i < workers_count; ++i)
+            workers.emplace_back(&consumer_thread_t::consumer_loop, this);
     }
 
     void exit()
     {
-        std::unique_lock<std::mutex> lk(mut);
+        std::unique_lock<std::mutex> lk(start_mut);
 
         valid.store(false);
-        cv.notify_all();
+        {
+            std::unique_lock<std::mutex> sleep_lk(mut);
+            cv.notify_all();
+        }
 
-        if(!exited) cv.wait(lk, [&] { return exited.load(); });
-        if(consumer.joinable()) consumer.join();
+        for(auto& itr : workers)
+            if(itr.joinable()) itr.join();
+        workers.clear();
+
+        // data added while the workers were exiting
+        while(consume_one(inline_processed))
+        {}
     }
 
     void add(DataType&& params)
     {
-        std::unique_lock<std::mutex> lk(mut);
+        while(!queue.try_push(std::move(params)))
+        {
+            // queue is full: make space by consuming the oldest data on this thread
+            consume_one(inline_processed);
+        }
 
-        if(read_ptr + buffer.size() <= write_ptr || !valid)
+        auto depth = queue.size();
+        auto prev  = max_depth.load(std::memory_order_relaxed);
+        while(depth > prev && !max_depth.compare_exchange_weak(prev, depth))
+        {}
+
+        if(!valid)
         {
             // If not possible to use consumer thread, proccess with this thread
-            consume_fn(std::move(params));
+            consume_one(inline_processed);
             return;
         }
 
-        buffer.at(write_ptr % buffer.size()) = std::move(params);
-        write_ptr.fetch_add(1);
-        cv.notify_all();
+        // pairs with the fence in consumer_loop: either the worker sees the data or this
+        // thread sees the sleeping worker
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(sleeping.load() > 0)
+        {
+            std::unique_lock<std::mutex> lk(mut);
+            cv.notify_one();
+        }
+    }
+
+    consumer_stats_t stats() const
+    {
+        return consumer_stats_t{.depth            = queue.size(),
+                                .max_depth        = max_depth.load(),
+                                .processed        = processed.load(),
+                                .inline_processed = inline_processed.load()};
     }
 
+    size_t num_workers() const { return workers_count; }
+    size_t capacity() const { return queue.capacity(); }
+
 protected:
     void consumer_loop()
     {
         while(true)
         {
-            while(read_ptr == write_ptr)
+            if(consume_one(processed)) continue;
+
+            if(!valid)
             {
-                std::unique_lock<std::mutex> lk(mut);
-                cv.wait(lk, [&] { return read_ptr != write_ptr || !valid; });
-                if(!valid && read_ptr == write_ptr)
-                {
-                    exited.store(true);
-                    cv.notify_all();
-                    return;
-                }
+                while(consume_one(processed))
+                {}
+                return;
             }
 
-            auto retrieved = std::move(buffer.at(read_ptr % buffer.size()));
-            read_ptr.fetch_add(1);
-            consume_fn(std::move(retrieved));
+            std::unique_lock<std::mutex> lk(mut);
+            sleeping.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            cv.wait(lk, [&] { return !queue.empty() || !valid; });
+            sleeping.fetch_sub(1);
+        }
+    }
+
+    bool consume_one(std::atomic<size_t>& counter)
+    {
+        auto     data = DataType{};
+        uint64_t seq  = 0;
+        if(!queue.try_pop(data, &seq)) return false;
+
+        {
+            auto ticket = ticket_t{*this, seq};
+            consume_fn(std::move(data), ticket);
         }
+        counter.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    void wait_turn(uint64_t seq) const
+    {
+        // data is popped in sequence order, the data with lower sequence numbers is being
+        // consumed by other threads
+        while(turn.load(std::memory_order_acquire) != seq)
+            std::this_thread::yield();
     }
 
-    consume_func_t             consume_fn;
-    std::atomic<bool>          valid{false};
-    std::atomic<bool>          exited{true};
-    std::mutex                 mut;
-    std::atomic<size_t>        write_ptr{0};
-    std::atomic<size_t>        read_ptr{0};
-    std::array<DataType, SIZE> buffer;
-    std::thread                consumer;
-    std::condition_variable    cv;
+    consume_func_t                           consume_fn;
+    size_t                                   workers_count = 1;
+    common::container::mpmc_queue<DataType> queue;
+    std::atomic<bool>                        valid{false};
+    std::mutex                               start_mut;
+    std::mutex                               mut;
+    std::condition_variable                  cv;
+    std::atomic<size_t>                      sleeping{0};
+    std::atomic<uint64_t>                    turn{0};
+    std::atomic<size_t>                      max_depth{0};
+    std::atomic<size_t>                      processed{0};
+    std::atomic<size_t>                      inline_processed{0};
+    std::vector<std::thread>                 workers;
 };
 
 }  // namespace counters
@@ -25,6 +25,9 @@
 #include "lib/rocprofiler-sdk/counters/sample_processing.hpp"
 
 #include "lib/common/container/small_vector.hpp"
+#include "lib/common/environment.hpp"
+#include "lib/common/logging.hpp"
+#include "lib/common/scope_destructor.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/common/utility.hpp"
 #include "lib/rocprofiler-sdk/buffer.hpp"
@@ -37,22 +40,39 @@
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/rocprofiler.h>
 
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <thread>
+
 namespace rocprofiler
 {
 namespace counters
 {
-std::mutex&
-get_buffer_mut()
+namespace
+{
+using consumer_t = consumer_thread_t<completed_cb_params_t>;
+
+size_t
+get_num_workers()
+{
+    auto _ncpu = std::min<size_t>(std::thread::hardware_concurrency(), 4);
+    return std::max<size_t>(common::get_env("ROCPROFILER_COUNTER_COLLECTION_WORKERS", _ncpu), 1);
+}
+
+size_t
+get_queue_size()
 {
-    static auto*& mut = common::static_object<std::mutex>::construct();
-    return *CHECK_NOTNULL(mut);
+    return common::get_env("ROCPROFILER_COUNTER_COLLECTION_QUEUE_SIZE", size_t{1024});
 }
+}  // namespace
 
 /**
- * Callback called by HSA interceptor when the kernel has completed processing.
+ * Callback called by HSA interceptor when the kernel has completed processing. Decoding and
+ * evaluation run concurrently on the workers.
  */
 void
-proccess_completed_cb(completed_cb_params_t&& params)
+proccess_completed_cb(completed_cb_params_t&& params, consumer_t::ticket_t& ticket)
 {
     auto& info          = params.info;
     auto& session       = *params.session;
@@ -62,12 +82,6 @@ proccess_completed_cb(completed_cb_params_t&& params)
 
     ROCP_FATAL_IF(pkt == nullptr) << "AQL packet is a nullptr!";
 
-    auto decoded_pkt = EvaluateAST::read_pkt(prof_config->pkt_generator.get(), *pkt);
-    EvaluateAST::read_special_counters(
-        *prof_config->agent, prof_config->required_special_counters, decoded_pkt);
-
-    prof_config->packets.wlock([&](auto& pkt_vector) { pkt_vector.emplace_back(std::move(pkt)); });
-
     common::container::small_vector<rocprofiler_record_counter_t, 128> out;
     rocprofiler::buffer::instance*                                     buf = nullptr;
 
@@ -88,23 +102,50 @@ proccess_completed_cb(completed_cb_params_t&& params)
         }
     }
 
-    auto _dispatch_id = session.callback_record.dispatch_info.dispatch_id;
-    for(auto& ast : prof_config->asts)
+    static thread_local auto scratch = EvaluateProgram::scratch_t{};
+
     {
-        std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>> cache;
-        auto* ret = ast.evaluate(decoded_pkt, cache);
-        CHECK(ret);
-        ast.set_out_id(*ret);
+        // the arena is returned to the pool before waiting for the ticket, even if decoding or
+        // evaluation throws
+        auto arena       = counter_callback_info::get_arena(*prof_config);
+        auto _arena_dtor = common::scope_destructor{[&prof_config, &arena]() {
+            counter_callback_info::return_arena(*prof_config, std::move(arena));
+        }};
 
-        out.reserve(out.size() + ret->size());
-        for(auto& val : *ret)
         {
-            val.agent_id    = prof_config->agent->id;
-            val.dispatch_id = _dispatch_id;
-            out.emplace_back(val);
+            // the AQL packet is returned to the pool once the counters are read from it, even if
+            // reading them throws
+            auto _pkt_dtor = common::scope_destructor{[&prof_config, &pkt]() {
+                prof_config->packets.wlock(
+                    [&](auto& pkt_vector) { pkt_vector.emplace_back(std::move(pkt)); });
+            }};
+
+            EvaluateAST::read_pkt(prof_config->pkt_generator.get(), *pkt, *arena);
+            EvaluateAST::read_special_counters(
+                *prof_config->agent, prof_config->required_special_counters, *arena);
+        }
+
+        auto _dispatch_id = session.callback_record.dispatch_info.dispatch_id;
+        for(const auto& program : prof_config->programs)
+        {
+            auto* ret = program.evaluate(*arena, scratch);
+            CHECK(ret);
+
+            out.reserve(out.size() + ret->size());
+            for(auto& val : *ret)
+            {
+                val.agent_id    = prof_config->agent->id;
+                val.dispatch_id = _dispatch_id;
+                out.emplace_back(val);
+            }
         }
     }
 
+    // records of the dispatches are written, and the record callback is invoked, in the order
+    // the dispatches completed. The record callback is never invoked concurrently, this is part
+    // of the contract of rocprofiler_profile_counting_record_callback_t.
+    ticket.wait();
+
     if(!out.empty())
     {
         if(buf)
@@ -120,8 +161,6 @@ proccess_completed_cb(completed_cb_params_t&& params)
             }
             _header.dispatch_info = session.callback_record.dispatch_info;
 
-            auto _lk = std::unique_lock{get_buffer_mut()};  // Buffer records need to be in order
-
             buf->emplace(ROCPROFILER_BUFFER_CATEGORY_COUNTERS,
                          ROCPROFILER_COUNTER_RECORD_PROFILE_COUNTING_DISPATCH_HEADER,
                          _header);
@@ -152,13 +191,17 @@ proccess_completed_cb(completed_cb_params_t&& params)
                                   info->record_callback_args);
         }
     }
+    ticket.release();
+
+    // release the reference acquired in process_callback_data
+    if(auto* _corr_id = session.correlation_id) _corr_id->sub_ref_count();
 }
 
 auto&
 callback_thread_get()
 {
-    using consumer_t = consumer_thread_t<completed_cb_params_t>;
-    static auto*& _v = common::static_object<consumer_t>::construct(proccess_completed_cb);
+    static auto*& _v = common::static_object<consumer_t>::construct(
+        consumer_t::consume_func_t{proccess_completed_cb}, get_num_workers(), get_queue_size());
     return *CHECK_NOTNULL(_v);
 }
 
@@ -171,12 +214,33 @@ callback_thread_start()
 void
 callback_thread_stop()
 {
-    callback_thread_get().exit();
+    auto& consumer = callback_thread_get();
+    consumer.exit();
+
+    auto stats = consumer.stats();
+    ROCP_INFO << fmt::format("counter collection processed {} dispatches on {} workers and {} "
+                             "on the completion thread (queue capacity: {}, max depth: {})",
+                             stats.processed,
+                             consumer.num_workers(),
+                             stats.inline_processed,
+                             consumer.capacity(),
+                             stats.max_depth);
+    ROCP_WARNING_IF(stats.inline_processed > 0)
+        << fmt::format("{} counter collection dispatches were processed on the completion thread "
+                       "because the queue was full. Increase "
+                       "ROCPROFILER_COUNTER_COLLECTION_WORKERS or "
+                       "ROCPROFILER_COUNTER_COLLECTION_QUEUE_SIZE to avoid delaying completion "
+                       "signals",
+                       stats.inline_processed);
 }
 
 void
 process_callback_data(completed_cb_params_t&& params)
 {
+    // processing may be deferred to the consumer thread so the correlation id must not be
+    // retired (and recycled) before the records referencing it are generated
+    if(auto* _corr_id = CHECK_NOTNULL(params.session)->correlation_id) _corr_id->add_ref_count();
+
     callback_thread_get().add(std::move(params));
 }
 
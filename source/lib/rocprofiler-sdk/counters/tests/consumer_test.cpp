@@ -22,9 +22,11 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <future>
 #include <mutex>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -112,5 +114,102 @@ TEST(consumer, multithreaded)
         EXPECT_EQ(var.load(), expected);
 }
 
+TEST(consumer, multiworker)
+{
+    auto       array = std::make_shared<result_array_t>();
+    consumer_t consumer(consume_fn, 4, 64);
+    consumer.start();
+
+    auto produce_fn = [&](size_t tid) {
+        for(size_t i = 0; i < NUM_ELEMENTS; i++)
+            consumer.add(DummyData{i, tid, array});
+    };
+
+    {
+        std::vector<std::future<void>> threads{};
+        for(size_t i = 0; i < NUM_THREADS; i++)
+            threads.push_back(std::async(std::launch::async, produce_fn, i + 1));
+    }
+
+    consumer.exit();
+
+    size_t expected = NUM_THREADS * (NUM_THREADS + 1) / 2;
+
+    for(auto& var : *array)
+        EXPECT_EQ(var.load(), expected);
+
+    auto stats = consumer.stats();
+    EXPECT_EQ(stats.depth, 0);
+    EXPECT_LE(stats.max_depth, consumer.capacity());
+    EXPECT_EQ(stats.processed + stats.inline_processed, NUM_THREADS * NUM_ELEMENTS);
+}
+
+TEST(consumer, ordered)
+{
+    constexpr size_t num_data = 1ul << 14;
+
+    using ordered_consumer_t = consumer_thread_t<size_t>;
+
+    auto written   = std::vector<size_t>{};
+    auto sequences = std::vector<uint64_t>{};
+    written.reserve(num_data);
+    sequences.reserve(num_data);
+
+    auto ordered_fn = [&](size_t&& data, ordered_consumer_t::ticket_t& ticket) {
+        // unordered work, finishes out of order on the workers
+        if(data % 7 == 0) std::this_thread::yield();
+
+        ticket.wait();
+        written.emplace_back(data);
+        sequences.emplace_back(ticket.sequence());
+        ticket.release();
+    };
+
+    ordered_consumer_t consumer(ordered_consumer_t::consume_func_t{ordered_fn}, 4, 16);
+    consumer.start();
+
+    for(size_t i = 0; i < num_data; i++)
+        consumer.add(size_t{i});
+
+    consumer.exit();
+
+    ASSERT_EQ(written.size(), num_data);
+    for(size_t i = 0; i < num_data; i++)
+    {
+        EXPECT_EQ(written.at(i), i);
+        EXPECT_EQ(sequences.at(i), i);
+    }
+}
+
+TEST(consumer, backpressure)
+{
+    constexpr size_t num_data = 32;
+
+    auto       array = std::make_shared<result_array_t>();
+    consumer_t consumer(
+        [](DummyData&& data) {
+            // stall the only worker so the queue fills up
+            if(data.index == 0) std::this_thread::sleep_for(std::chrono::milliseconds{50});
+            consume_fn(std::move(data));
+        },
+        1,
+        4);
+    consumer.start();
+
+    for(size_t i = 0; i < num_data; i++)
+        consumer.add(DummyData{i, 1, array});
+
+    consumer.exit();
+
+    for(size_t i = 0; i < num_data; i++)
+        EXPECT_EQ(array->at(i).load(), 1);
+
+    auto stats = consumer.stats();
+    EXPECT_EQ(consumer.capacity(), 4);
+    EXPECT_EQ(stats.max_depth, 4);
+    EXPECT_GT(stats.inline_processed, 0);
+    EXPECT_EQ(stats.processed + stats.inline_processed, num_data);
+}
+
 }  // namespace counters
 }  // namespace rocprofiler
@@ -410,8 +410,8 @@ TEST(core, check_callbacks)
             cb_info->user_cb       = user_dispatch_cb;
             cb_info->callback_args = static_cast<void*>(&expected);
 
-            context::correlation_id corr_id;
-            corr_id.internal = count++;
+            // hold a reference so the completed callback never retires this correlation id
+            context::correlation_id corr_id{1, 0, count++};
 
             hsa::rocprofiler_packet pkt;
             pkt.ext_amd_aql_pm4.header = count++;
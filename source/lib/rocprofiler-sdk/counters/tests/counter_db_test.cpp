@@ -0,0 +1,227 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <fmt/core.h>
+#include <gtest/gtest.h>
+
+#include "lib/rocprofiler-sdk/counters/counter_db.hpp"
+#include "lib/rocprofiler-sdk/counters/metrics.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+
+namespace
+{
+using namespace rocprofiler::counters;
+
+constexpr auto test_yaml = R"(
+schema-version: 1
+GRBM_GUI_ACTIVE:
+  architectures:
+    gfx9/gfx90a:
+      block: GRBM
+      event: 2
+  description: The GUI is Active
+SQ_WAVES:
+  architectures:
+    gfx90a:
+      block: SQ
+      event: 4
+      description: Count number of waves sent to SQs
+  description: Waves
+MEAN_OCCUPANCY:
+  architectures:
+    gfx90a:
+      expression: reduce(accumulate(SQ_WAVES,HIGH_RES),sum)/reduce(GRBM_GUI_ACTIVE,max)
+  description: Mean occupancy
+SE_WAVES:
+  architectures:
+    gfx9/gfx90a:
+      expression: select(reduce(SQ_WAVES, sum, [DIMENSION_XCC]), [DIMENSION_SHADER_ENGINE=[2]])*4
+)";
+
+std::string
+parse(const std::string& expression)
+{
+    RawAST* ast = nullptr;
+    auto*   buf = yy_scan_string(expression.c_str());
+    yyparse(&ast);
+    yy_delete_buffer(buf);
+    if(!ast) return std::string{};
+    auto ret = fmt::format("{}", *ast);
+    delete ast;
+    return ret;
+}
+}  // namespace
+
+TEST(counter_db, compile)
+{
+    auto db = CounterDatabase::from_buffer(CounterDatabase::compile(test_yaml, true));
+    ASSERT_TRUE(db);
+
+    // definitions are split by architecture and kept in the order of the YAML file
+    const auto expected = std::vector<std::vector<std::string>>{
+        {"GRBM_GUI_ACTIVE", "gfx9", "GRBM", "2", "The GUI is Active", ""},
+        {"GRBM_GUI_ACTIVE", "gfx90a", "GRBM", "2", "The GUI is Active", ""},
+        {"SQ_WAVES", "gfx90a", "SQ", "4", "Count number of waves sent to SQs", ""},
+        {"MEAN_OCCUPANCY",
+         "gfx90a",
+         "",
+         "",
+         "Mean occupancy",
+         "reduce(accumulate(SQ_WAVES,HIGH_RES),sum)/reduce(GRBM_GUI_ACTIVE,max)"},
+        {"SE_WAVES",
+         "gfx9",
+         "",
+         "",
+         "",
+         "select(reduce(SQ_WAVES, sum, [DIMENSION_XCC]), [DIMENSION_SHADER_ENGINE=[2]])*4"},
+        {"SE_WAVES",
+         "gfx90a",
+         "",
+         "",
+         "",
+         "select(reduce(SQ_WAVES, sum, [DIMENSION_XCC]), [DIMENSION_SHADER_ENGINE=[2]])*4"},
+    };
+    ASSERT_EQ(db->size(), expected.size());
+    for(size_t i = 0; i < expected.size(); ++i)
+    {
+        auto def = db->at(i);
+        EXPECT_EQ(def.name, expected[i][0]);
+        EXPECT_EQ(def.architecture, expected[i][1]);
+        EXPECT_EQ(def.block, expected[i][2]);
+        EXPECT_EQ(def.event, expected[i][3]);
+        EXPECT_EQ(def.description, expected[i][4]);
+        EXPECT_EQ(def.expression, expected[i][5]);
+    }
+
+    // ASTs of the expressions and of the names of the base counters
+    EXPECT_EQ(db->num_asts(), 4);
+    for(size_t i = 0; i < db->size(); ++i)
+    {
+        auto def  = db->at(i);
+        auto text = std::string{def.expression.empty() ? def.name : def.expression};
+        auto ast  = db->get_ast(text);
+        ASSERT_TRUE(ast) << text;
+        EXPECT_EQ(fmt::format("{}", *ast), parse(text));
+    }
+    EXPECT_FALSE(db->get_ast("NOT_A_COUNTER"));
+
+    // compiled at runtime from YAML without ASTs
+    auto yaml_db = CounterDatabase::from_yaml(test_yaml);
+    ASSERT_TRUE(yaml_db);
+    EXPECT_EQ(yaml_db->size(), db->size());
+    EXPECT_EQ(yaml_db->num_asts(), 0);
+    EXPECT_FALSE(yaml_db->get_ast("SQ_WAVES"));
+}
+
+TEST(counter_db, counter_defs)
+{
+    // The precompiled ASTs must match the parser for every definition in use
+    const auto* db = getCounterDatabase();
+    ASSERT_TRUE(db);
+    ASSERT_GT(db->size(), 0);
+    for(size_t i = 0; i < db->size(); ++i)
+    {
+        auto def  = db->at(i);
+        auto text = std::string{def.expression.empty() ? def.name : def.expression};
+        if(auto ast = db->get_ast(text)) EXPECT_EQ(fmt::format("{}", *ast), parse(text)) << text;
+    }
+}
+
+TEST(counter_db, open)
+{
+    auto data = CounterDatabase::compile(test_yaml, true);
+    auto path = fmt::format("counter_db_test_{}.db", getpid());
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    auto db = CounterDatabase::open(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(db);
+    EXPECT_EQ(db->size(), 6);
+    EXPECT_EQ(db->at(2).name, "SQ_WAVES");
+    EXPECT_TRUE(db->get_ast("SQ_WAVES"));
+
+    EXPECT_FALSE(CounterDatabase::open(path));
+}
+
+TEST(counter_db, yaml_hash)
+{
+    // the hash of the YAML is stored so that an edited counter_defs.yaml is detected
+    auto db = CounterDatabase::from_buffer(CounterDatabase::compile(test_yaml, true));
+    ASSERT_TRUE(db);
+    EXPECT_EQ(db->yaml_hash(), CounterDatabase::hash_yaml(test_yaml));
+    EXPECT_NE(db->yaml_hash(), CounterDatabase::hash_yaml(std::string{test_yaml} + "\n"));
+    EXPECT_EQ(CounterDatabase::from_yaml(test_yaml)->yaml_hash(), db->yaml_hash());
+}
+
+TEST(counter_db, invalid)
+{
+    const auto data = CounterDatabase::compile(test_yaml, true);
+    ASSERT_TRUE(CounterDatabase::from_buffer(std::vector<char>{data}));
+
+    EXPECT_FALSE(CounterDatabase::from_buffer(std::vector<char>{}));
+
+    // truncated
+    for(size_t size : {size_t{16}, data.size() / 2, data.size() - 1})
+    {
+        auto truncated = std::vector<char>(data.begin(), data.begin() + size);
+        EXPECT_FALSE(CounterDatabase::from_buffer(std::move(truncated))) << size;
+    }
+
+    // bad magic
+    auto bad_magic = data;
+    bad_magic[0]   = 'X';
+    EXPECT_FALSE(CounterDatabase::from_buffer(std::move(bad_magic)));
+
+    // unsupported version
+    auto bad_version = data;
+    auto version     = CounterDatabase::format_version + 1;
+    std::memcpy(bad_version.data() + 8, &version, sizeof(version));
+    EXPECT_FALSE(CounterDatabase::from_buffer(std::move(bad_version)));
+
+    // corrupting any single byte of the header or sections is either detected or yields a
+    // database which can be used safely
+    for(size_t i = 0; i < data.size(); ++i)
+    {
+        auto corrupt = data;
+        corrupt[i]   = static_cast<char>(0xff);
+        if(auto db = CounterDatabase::from_buffer(std::move(corrupt)))
+        {
+            for(size_t j = 0; j < db->size(); ++j)
+            {
+                auto def  = db->at(j);
+                auto text = std::string{def.expression.empty() ? def.name : def.expression};
+                db->get_ast(text);
+            }
+        }
+    }
+}
@@ -0,0 +1,292 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
+#include "lib/rocprofiler-sdk/counters/id_decode.hpp"
+#include "lib/rocprofiler-sdk/counters/metrics.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+#include "rocprofiler-sdk/fwd.h"
+
+namespace
+{
+using namespace rocprofiler::counters;
+
+using results_map_t = std::unordered_map<uint64_t, std::vector<rocprofiler_record_counter_t>>;
+using ast_cache_t   = std::vector<std::unique_ptr<std::vector<rocprofiler_record_counter_t>>>;
+
+// base counters have XCC x SE instances, except for SINGLE which has one value
+const std::unordered_map<std::string, Metric> test_metrics = {
+    {"VOORHEES", Metric("gfx9", "VOORHEES", "a", "a", "a", "", "", 0)},
+    {"KRUEGER", Metric("gfx9", "KRUEGER", "a", "a", "a", "", "", 1)},
+    {"MYERS", Metric("gfx9", "MYERS", "a", "a", "a", "", "", 2)},
+    {"SINGLE", Metric("gfx9", "SINGLE", "a", "a", "a", "", "", 3)},
+    {"BATES", Metric("gfx9", "BATES", "a", "a", "a", "VOORHEES+KRUEGER", "", 4)},
+    {"KRAMER", Metric("gfx9", "KRAMER", "a", "a", "a", "MYERS*BATES/SINGLE", "", 5)},
+    {"TORRANCE", Metric("gfx9", "TORRANCE", "a", "a", "a", "KRAMER/(KRUEGER-MYERS)", "", 6)},
+    {"GHOSTFACE",
+     Metric("gfx9", "GHOSTFACE", "a", "a", "a", "100*reduce(BATES,sum)/reduce(MYERS,max)", "", 7)},
+    {"LECTER",
+     Metric("gfx9",
+            "LECTER",
+            "a",
+            "a",
+            "a",
+            "reduce(VOORHEES*KRUEGER,avr,[DIMENSION_SHADER_ENGINE])",
+            "",
+            8)},
+    {"CARRIE",
+     Metric("gfx9", "CARRIE", "a", "a", "a", "select(BATES-MYERS,[DIMENSION_XCC=[1]])", "", 9)},
+    {"PENNYWISE",
+     Metric("gfx9",
+            "PENNYWISE",
+            "a",
+            "a",
+            "a",
+            "(VOORHEES+KRUEGER+MYERS)/(VOORHEES*SINGLE)-reduce(KRUEGER/MYERS,min)",
+            "",
+            10)},
+};
+
+EvaluateASTMap
+construct_asts()
+{
+    auto asts = EvaluateASTMap{};
+    for(const auto& [name, metric] : test_metrics)
+    {
+        RawAST* ast = nullptr;
+        auto    buf = yy_scan_string(metric.expression().empty() ? metric.name().c_str()
+                                                                 : metric.expression().c_str());
+        yyparse(&ast);
+        CHECK(ast) << metric.expression() << " " << metric.name();
+        asts.emplace(name, EvaluateAST({.handle = metric.id()}, test_metrics, *ast, "gfx9"));
+        yy_delete_buffer(buf);
+        delete ast;
+    }
+
+    for(auto& [name, ast] : asts)
+        ast.expand_derived(asts);
+    return asts;
+}
+
+results_map_t
+construct_results(size_t num_xcc, size_t num_se, uint64_t seed)
+{
+    auto rng   = std::mt19937_64{seed};
+    auto value = std::uniform_int_distribution<int>{0, 1000};
+
+    auto results = results_map_t{};
+    for(const auto& [name, metric] : test_metrics)
+    {
+        if(!metric.expression().empty()) continue;
+
+        auto& records = results[metric.id()];
+        for(size_t xcc = 0; xcc < num_xcc; ++xcc)
+        {
+            for(size_t se = 0; se < num_se; ++se)
+            {
+                auto& record = records.emplace_back();
+                set_counter_in_rec(record.id, {.handle = metric.id()});
+                set_dim_in_rec(record.id, ROCPROFILER_DIMENSION_XCC, xcc);
+                set_dim_in_rec(record.id, ROCPROFILER_DIMENSION_SHADER_ENGINE, se);
+                record.counter_value = value(rng);
+                if(name == "SINGLE") break;
+            }
+            if(name == "SINGLE") break;
+        }
+    }
+    return results;
+}
+
+std::vector<rocprofiler_record_counter_t>
+evaluate_ast(const EvaluateAST& ast, const results_map_t& results)
+{
+    // EvaluateAST::evaluate modifies the AST (number nodes) and the results
+    auto copy    = ast;
+    auto decoded = results;
+    auto cache   = ast_cache_t{};
+    auto ret     = copy.evaluate(decoded, cache);
+    CHECK(ret);
+    copy.set_out_id(*ret);
+    return *ret;
+}
+}  // namespace
+
+TEST(evaluate_program, matches_evaluate_ast)
+{
+    auto asts = construct_asts();
+
+    for(auto [num_xcc, num_se] : {std::pair<size_t, size_t>{1, 1}, {2, 4}, {8, 4}})
+    {
+        auto results = construct_results(num_xcc, num_se, num_xcc * num_se);
+        auto scratch = EvaluateProgram::scratch_t{};
+
+        for(const auto& [name, ast] : asts)
+        {
+            auto program  = EvaluateProgram{ast};
+            auto expected = evaluate_ast(ast, results);
+
+            // evaluate twice to make sure nothing is left over in the scratch
+            for(size_t i = 0; i < 2; ++i)
+            {
+                auto* ret = program.evaluate(results, scratch);
+                ASSERT_TRUE(ret) << name;
+                ASSERT_EQ(ret->size(), expected.size()) << name;
+                for(size_t j = 0; j < expected.size(); ++j)
+                {
+                    EXPECT_EQ(ret->at(j).id, expected.at(j).id) << name << " " << j;
+                    EXPECT_DOUBLE_EQ(ret->at(j).counter_value, expected.at(j).counter_value)
+                        << name << " " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST(evaluate_program, missing_results)
+{
+    auto asts    = construct_asts();
+    auto results = construct_results(2, 4, 0);
+    results.erase(test_metrics.at("MYERS").id());
+
+    auto scratch = EvaluateProgram::scratch_t{};
+    EXPECT_THROW(EvaluateProgram{asts.at("MYERS")}.evaluate(results, scratch), std::runtime_error);
+    EXPECT_THROW(EvaluateProgram{asts.at("KRAMER")}.evaluate(results, scratch),
+                 std::runtime_error);
+    EXPECT_NE(EvaluateProgram{asts.at("BATES")}.evaluate(results, scratch), nullptr);
+}
+
+TEST(evaluate_program, decode_arena)
+{
+    auto asts   = construct_asts();
+    auto layout = std::vector<uint64_t>{};
+    for(const auto& [name, metric] : test_metrics)
+        if(metric.expression().empty()) layout.emplace_back(metric.id());
+
+    auto arena = DecodeArena{layout};
+    EXPECT_TRUE(arena.empty());
+    EXPECT_EQ(arena.get(test_metrics.at("BATES").id()), nullptr);
+    EXPECT_EQ(arena.get(1000), nullptr);
+
+    auto scratch   = EvaluateProgram::scratch_t{};
+    auto slice_ptr = std::unordered_map<uint64_t, const rocprofiler_record_counter_t*>{};
+    for(auto [num_xcc, num_se] : {std::pair<size_t, size_t>{8, 4}, {2, 4}, {8, 4}})
+    {
+        auto results = construct_results(num_xcc, num_se, num_xcc + num_se);
+
+        // fill the arena the same way EvaluateAST::read_pkt does
+        arena.clear();
+        EXPECT_TRUE(arena.empty());
+        for(const auto& [id, records] : results)
+        {
+            auto* slice = arena.get(id);
+            ASSERT_NE(slice, nullptr);
+            for(const auto& record : records)
+                slice->emplace_back(record);
+
+            // the slices keep their capacity, smaller or equal results do not reallocate
+            auto itr = slice_ptr.emplace(id, slice->data()).first;
+            EXPECT_EQ(itr->second, slice->data());
+        }
+        EXPECT_FALSE(arena.empty());
+
+        for(const auto& [name, ast] : asts)
+        {
+            auto  program  = EvaluateProgram{ast};
+            auto  expected = evaluate_ast(ast, results);
+            auto* ret      = program.evaluate(arena, scratch);
+            ASSERT_TRUE(ret) << name;
+            ASSERT_EQ(ret->size(), expected.size()) << name;
+            for(size_t j = 0; j < expected.size(); ++j)
+            {
+                EXPECT_EQ(ret->at(j).id, expected.at(j).id) << name << " " << j;
+                EXPECT_DOUBLE_EQ(ret->at(j).counter_value, expected.at(j).counter_value)
+                    << name << " " << j;
+            }
+        }
+    }
+
+    // a metric without records is treated as missing
+    arena.get(test_metrics.at("MYERS").id())->clear();
+    EXPECT_THROW(EvaluateProgram{asts.at("KRAMER")}.evaluate(arena, scratch), std::runtime_error);
+    EXPECT_NE(EvaluateProgram{asts.at("BATES")}.evaluate(arena, scratch), nullptr);
+}
+
+TEST(evaluate_program, benchmark)
+{
+    using clock_t = std::chrono::steady_clock;
+
+    auto asts     = construct_asts();
+    auto programs = std::vector<EvaluateProgram>{};
+    for(const auto& [name, ast] : asts)
+        programs.emplace_back(ast);
+
+    for(auto [num_xcc, num_se] : {std::pair<size_t, size_t>{1, 4}, {8, 32}})
+    {
+        auto       results    = construct_results(num_xcc, num_se, 0);
+        const auto iterations = size_t{20000} / num_xcc;
+
+        // accumulate the results so the evaluations cannot be optimized away
+        auto ast_sum = 0.0;
+        auto ast_beg = clock_t::now();
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(auto& [name, ast] : asts)
+            {
+                auto  cache = ast_cache_t{};
+                auto* ret   = ast.evaluate(results, cache);
+                ast.set_out_id(*ret);
+                ast_sum += ret->size();
+            }
+        }
+        auto ast_end = clock_t::now();
+
+        auto scratch     = EvaluateProgram::scratch_t{};
+        auto program_sum = 0.0;
+        auto program_beg = clock_t::now();
+        for(size_t i = 0; i < iterations; ++i)
+        {
+            for(const auto& program : programs)
+                program_sum += program.evaluate(results, scratch)->size();
+        }
+        auto program_end = clock_t::now();
+
+        EXPECT_EQ(ast_sum, program_sum);
+
+        auto per_dispatch = [iterations](auto beg, auto end) {
+            return std::chrono::duration<double, std::micro>(end - beg).count() / iterations;
+        };
+        std::cout << "[ evaluate ] " << asts.size() << " metrics, " << num_xcc * num_se
+                  << " instances: EvaluateAST " << per_dispatch(ast_beg, ast_end)
+                  << " us/dispatch, EvaluateProgram " << per_dispatch(program_beg, program_end)
+                  << " us/dispatch" << std::endl;
+    }
+}
@@ -0,0 +1,263 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/counters/evaluate_ast.hpp"
+#include "lib/rocprofiler-sdk/counters/metrics.hpp"
+#include "lib/rocprofiler-sdk/counters/parser/reader.hpp"
+#include "lib/rocprofiler-sdk/counters/pass_scheduler.hpp"
+
+namespace
+{
+using namespace rocprofiler::counters;
+
+// Block limits of a typical agent, the scheduler does not need an agent for these
+int64_t
+test_block_limit(const Metric& metric)
+{
+    static const auto limits = std::unordered_map<std::string, int64_t>{
+        {"SQ", 8}, {"TCC", 4}, {"TCP", 4}, {"TA", 2}, {"TD", 2}, {"GRBM", 2}, {"CPC", 2}};
+    if(const auto* limit = rocprofiler::common::get_val(limits, metric.block())) return *limit;
+    return 4;
+}
+
+Metric
+hw_counter(const std::string& name, const std::string& block, uint64_t id)
+{
+    return Metric("gfx9", name, block, "1", "", "", "", id);
+}
+
+// ASTs of the counters of an agent. get_agent_ast_map() requires the agent properties of a GPU for
+// the constants, counters which cannot be built without them are left out.
+EvaluateASTMap
+load_agent_asts(const std::string& agent)
+{
+    auto by_name = std::unordered_map<std::string, Metric>{};
+    for(const auto& metric : getMetricsForAgent(agent))
+        by_name.emplace(metric.name(), metric);
+
+    auto eval_map = EvaluateASTMap{};
+    for(const auto& [name, metric] : by_name)
+    {
+        RawAST* ast = nullptr;
+        auto*   buf = yy_scan_string(metric.expression().empty() ? metric.name().c_str()
+                                                                 : metric.expression().c_str());
+        yyparse(&ast);
+        yy_delete_buffer(buf);
+        if(!ast) continue;
+        try
+        {
+            eval_map.emplace(name, EvaluateAST({.handle = metric.id()}, by_name, *ast, agent));
+        } catch(std::exception&)
+        {}
+        delete ast;
+    }
+
+    // drop derived counters which depend on a counter that could not be built
+    auto missing = [&eval_map](const auto& self, const EvaluateAST& node) -> bool {
+        if(!node.metric().expression().empty() && eval_map.count(node.metric().name()) == 0)
+            return true;
+        for(const auto& child : node.children())
+            if(self(self, child)) return true;
+        return false;
+    };
+    for(bool erased = true; erased;)
+    {
+        erased = false;
+        for(auto itr = eval_map.begin(); itr != eval_map.end();)
+        {
+            if(missing(missing, itr->second))
+            {
+                itr    = eval_map.erase(itr);
+                erased = true;
+            }
+            else
+                ++itr;
+        }
+    }
+
+    for(auto& [name, ast] : eval_map)
+        ast.expand_derived(eval_map);
+    return eval_map;
+}
+
+// Checks the properties every schedule must have and returns the number of passes
+size_t
+validate_passes(const std::vector<pass_request>& requests,
+                const std::vector<counter_pass>& passes,
+                const block_limit_func_t&        block_limit)
+{
+    auto scheduled = std::map<uint64_t, size_t>{};
+    for(const auto& pass : passes)
+    {
+        EXPECT_FALSE(pass.metrics.empty());
+
+        auto block_counts = std::map<std::string, int64_t>{};
+        for(const auto& counter : pass.hw_counters)
+            ++block_counts[counter.block()];
+        for(const auto& counter : pass.hw_counters)
+            EXPECT_LE(block_counts.at(counter.block()), block_limit(counter)) << counter.name();
+
+        for(const auto& metric : pass.metrics)
+            ++scheduled[metric.id()];
+    }
+
+    for(const auto& request : requests)
+    {
+        EXPECT_EQ(scheduled[request.metric.id()], 1) << request.metric.name();
+        for(const auto& pass : passes)
+        {
+            for(const auto& metric : pass.metrics)
+            {
+                if(metric.id() != request.metric.id()) continue;
+                for(const auto& counter : request.hw_counters)
+                    EXPECT_EQ(pass.hw_counters.count(counter), 1)
+                        << request.metric.name() << " " << counter.name();
+            }
+        }
+    }
+    return passes.size();
+}
+}  // namespace
+
+TEST(pass_scheduler, shared_counters)
+{
+    auto sq_waves = hw_counter("SQ_WAVES", "SQ", 0);
+    auto sq_insts = hw_counter("SQ_INSTS", "SQ", 1);
+    auto sq_busy  = hw_counter("SQ_BUSY", "SQ", 2);
+    auto grbm     = hw_counter("GRBM_COUNT", "GRBM", 3);
+
+    // With a limit of 2 per block, these fit in a single pass because the metrics share
+    // counters and shared counters are collected once
+    auto requests = std::vector<pass_request>{
+        {hw_counter("A", "", 10), {sq_waves, sq_insts}},
+        {hw_counter("B", "", 11), {sq_waves, grbm}},
+        {hw_counter("C", "", 12), {sq_insts}},
+    };
+    auto limit  = [](const Metric&) -> int64_t { return 2; };
+    auto passes = std::vector<counter_pass>{};
+    ASSERT_EQ(partition_counter_passes(requests, limit, passes), ROCPROFILER_STATUS_SUCCESS);
+    EXPECT_EQ(validate_passes(requests, passes, limit), 1);
+
+    // Third SQ counter does not fit
+    requests.push_back({hw_counter("D", "", 13), {sq_busy}});
+    ASSERT_EQ(partition_counter_passes(requests, limit, passes), ROCPROFILER_STATUS_SUCCESS);
+    EXPECT_EQ(validate_passes(requests, passes, limit), 2);
+
+    // A metric which needs more than the limit on its own cannot be scheduled
+    requests.push_back({hw_counter("E", "", 14), {sq_waves, sq_insts, sq_busy}});
+    EXPECT_EQ(partition_counter_passes(requests, limit, passes),
+              ROCPROFILER_STATUS_ERROR_EXCEEDS_HW_LIMIT);
+}
+
+TEST(pass_scheduler, minimal_passes)
+{
+    // Metrics with 2, 1, 3, 2, 1, 3 SQ counters and a limit of 4. First-fit in the order of
+    // the request needs 4 passes, the minimum is 3: [3,1] [3,1] [2,2]
+    auto requests = std::vector<pass_request>{};
+    auto sizes    = std::vector<size_t>{2, 1, 3, 2, 1, 3};
+    auto next_id  = uint64_t{0};
+    for(size_t i = 0; i < sizes.size(); ++i)
+    {
+        auto& request  = requests.emplace_back();
+        request.metric = hw_counter("M" + std::to_string(i), "", 100 + i);
+        for(size_t j = 0; j < sizes.at(i); ++j)
+        {
+            request.hw_counters.emplace(hw_counter("C" + std::to_string(next_id), "SQ", next_id));
+            ++next_id;
+        }
+    }
+
+    auto limit  = [](const Metric&) -> int64_t { return 4; };
+    auto passes = std::vector<counter_pass>{};
+    ASSERT_EQ(partition_counter_passes(requests, limit, passes), ROCPROFILER_STATUS_SUCCESS);
+    EXPECT_EQ(validate_passes(requests, passes, limit), 3);
+
+    // the result does not depend on anything else than the request
+    auto again = std::vector<counter_pass>{};
+    ASSERT_EQ(partition_counter_passes(requests, limit, again), ROCPROFILER_STATUS_SUCCESS);
+    ASSERT_EQ(again.size(), passes.size());
+    for(size_t i = 0; i < passes.size(); ++i)
+        EXPECT_EQ(again.at(i).hw_counters, passes.at(i).hw_counters);
+}
+
+TEST(pass_scheduler, yaml_metrics)
+{
+    // Schedules the counters defined in counter_defs.yaml without a GPU
+    for(const auto* agent : {"gfx90a", "gfx942"})
+    {
+        auto asts    = load_agent_asts(agent);
+        auto metrics = std::vector<Metric>{};
+        for(const auto& metric : getMetricsForAgent(agent))
+        {
+            if(!metric.special().empty() || asts.count(metric.name()) == 0) continue;
+
+            // skip metrics which cannot be collected in a single pass with the test limits
+            auto single = std::vector<counter_pass>{};
+            if(schedule_counter_passes(asts, {metric}, test_block_limit, single) !=
+               ROCPROFILER_STATUS_SUCCESS)
+                continue;
+            metrics.emplace_back(metric);
+        }
+        ASSERT_FALSE(metrics.empty()) << agent;
+
+        auto passes = std::vector<counter_pass>{};
+        ASSERT_EQ(schedule_counter_passes(asts, metrics, test_block_limit, passes),
+                  ROCPROFILER_STATUS_SUCCESS);
+
+        auto requests       = std::vector<pass_request>{};
+        auto block_counters = std::map<std::string, std::set<Metric>>{};
+        for(const auto& metric : metrics)
+        {
+            auto& request  = requests.emplace_back();
+            request.metric = metric;
+
+            auto req_counters = get_required_hardware_counters(asts, metric);
+            ASSERT_TRUE(req_counters) << metric.name();
+            for(const auto& counter : *req_counters)
+            {
+                if(!counter.special().empty()) continue;
+                request.hw_counters.emplace(counter);
+                block_counters[counter.block()].emplace(counter);
+            }
+        }
+
+        auto num_passes = validate_passes(requests, passes, test_block_limit);
+
+        // every block needs at least ceil(counters / limit) passes
+        for(const auto& [block, counters] : block_counters)
+        {
+            auto limit = test_block_limit(Metric("gfx9", "", block, "", "", "", "", 0));
+            EXPECT_GE(num_passes, (counters.size() + limit - 1) / limit) << block;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Compiles counter_defs.yaml into the binary counter database (counter_defs.db) at build time
+
+#include "lib/rocprofiler-sdk/counters/counter_db.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+int
+main(int argc, char** argv)
+{
+    if(argc != 3)
+    {
+        std::cerr << "usage: " << argv[0] << " <counter_defs.yaml> <counter_defs.db>\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ifstream input(argv[1]);
+    if(!input)
+    {
+        std::cerr << "unable to open " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    std::stringstream yaml;
+    yaml << input.rdbuf();
+
+    auto data = rocprofiler::counters::CounterDatabase::compile(yaml.str(), true);
+    // Ensure the output can be loaded before installing it
+    auto db = rocprofiler::counters::CounterDatabase::from_buffer(std::vector<char>{data});
+    if(!db)
+    {
+        std::cerr << "compiled counter database is not valid\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream output(argv[2], std::ios::binary | std::ios::trunc);
+    output.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if(!output)
+    {
+        std::cerr << "unable to write " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Compiled " << db->size() << " counter definitions and " << db->num_asts()
+              << " expressions into " << argv[2] << "\n";
+    return EXIT_SUCCESS;
+}
@@ -43,7 +43,12 @@
 #include <hsa/hsa_ext_amd.h>
 
 #include <atomic>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
 
 // static assert for rocprofiler_packet ABI compatibility
 static_assert(sizeof(hsa_ext_amd_aql_pm4_packet_t) == sizeof(hsa_kernel_dispatch_packet_t),
@@ -68,12 +73,13 @@ namespace hsa
 {
 namespace
 {
-std::atomic<int64_t>&
-get_balanced_signal_slots()
+// slab slots hold the session plus the std::allocate_shared control block
+constexpr size_t session_slab_slot_size = sizeof(Queue::queue_info_session_t) + 64;
+
+std::shared_ptr<common::memory::slab>
+make_session_slab()
 {
-    constexpr int64_t NUM_SIGNALS = 16;
-    static auto*&     atomic = common::static_object<std::atomic<int64_t>>::construct(NUM_SIGNALS);
-    return *atomic;
+    return std::make_shared<common::memory::slab>(session_slab_slot_size);
 }
 
 template <typename DomainT, typename... Args>
@@ -107,19 +113,20 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
 {
     if(!data) return true;
 
-    // if we have fully finalized, delete the data and return
+    auto& shared_ptr_info    = *static_cast<Queue::session_ptr_t*>(data);
+    auto& queue_info_session = *shared_ptr_info;
+    auto& queue              = queue_info_session.queue;
+
+    // if we have fully finalized, skip the callbacks and retire the session. The queue is still
+    // alive since its destructor waits for all active kernels to complete
     if(registration::get_fini_status() > 0)
     {
-        auto* _session = static_cast<Queue::queue_info_session_t**>(data);
-        delete _session;
+        queue.release_signal(queue_info_session.interrupt_signal);
+        queue.release_signal(queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal);
+        queue.destroy_session(&shared_ptr_info);
         return false;
     }
 
-    get_balanced_signal_slots().fetch_add(1);
-
-    auto& shared_ptr_info    = *static_cast<std::shared_ptr<Queue::queue_info_session_t>*>(data);
-    auto& queue_info_session = *shared_ptr_info;
-
     auto dispatch_time = kernel_dispatch::get_dispatch_time(queue_info_session);
 
     kernel_dispatch::dispatch_complete(queue_info_session, dispatch_time);
@@ -137,7 +144,7 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
         }
     });
 
-    // Delete signals and packets, signal we have completed.
+    // Return signals to the queue for reuse, signal we have completed.
     if(queue_info_session.interrupt_signal.handle != 0u)
     {
 #if !defined(NDEBUG)
@@ -147,12 +154,11 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
 #endif
         hsa::get_core_table()->hsa_signal_store_screlease_fn(queue_info_session.interrupt_signal,
                                                              -1);
-        hsa::get_core_table()->hsa_signal_destroy_fn(queue_info_session.interrupt_signal);
+        queue.release_signal(queue_info_session.interrupt_signal);
     }
     if(queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal.handle != 0u)
     {
-        hsa::get_core_table()->hsa_signal_destroy_fn(
-            queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal);
+        queue.release_signal(queue_info_session.kernel_pkt.ext_amd_aql_pm4.completion_signal);
     }
 
     // we need to decrement this reference count at the end of the functions
@@ -166,8 +172,10 @@ AsyncSignalHandler(hsa_signal_value_t /*signal_v*/, void* data)
         _corr_id->sub_ref_count();
     }
 
-    queue_info_session.queue.async_complete();
-    delete &shared_ptr_info;
+    // the session must be released before async_complete() since the queue may be destroyed
+    // as soon as it has no active kernels
+    queue.destroy_session(&shared_ptr_info);
+    queue.async_complete();
 
     return false;
 }
@@ -245,8 +253,20 @@ WriteInterceptor(const void* packets,
                                ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH,
                                tracing_data_v);
 
-    const auto* packets_arr         = static_cast<const rocprofiler_packet*>(packets);
-    auto        transformed_packets = std::vector<rocprofiler_packet>{};
+    // reuse the per-thread packet storage unless a callback re-entered the interceptor
+    static thread_local auto packet_cache   = std::vector<rocprofiler_packet>{};
+    static thread_local auto packet_reentry = false;
+
+    auto  local_packets       = std::vector<rocprofiler_packet>{};
+    auto& transformed_packets = (packet_reentry) ? local_packets : packet_cache;
+    auto  _packet_dtor        = common::scope_destructor{
+        [&transformed_packets, _reentry = packet_reentry]() {
+            transformed_packets.clear();
+            packet_reentry = _reentry;
+        }};
+    packet_reentry = true;
+
+    const auto* packets_arr = static_cast<const rocprofiler_packet*>(packets);
 
     // Searching accross all the packets given during this write
     for(size_t i = 0; i < pkt_count; ++i)
@@ -307,7 +327,7 @@ WriteInterceptor(const void* packets,
         // create our own signal that we can get a callback on. if there is an original completion
         // signal we will create a barrier packet, assign the original completion signal that that
         // barrier packet, and add it right after the kernel packet
-        queue.create_signal(0, &kernel_pkt.kernel_dispatch.completion_signal);
+        kernel_pkt.kernel_dispatch.completion_signal = queue.acquire_signal();
 
         // computes the "size" based on the offset of reserved_padding field
         constexpr auto kernel_dispatch_info_rt_size =
@@ -355,13 +375,6 @@ WriteInterceptor(const void* packets,
             thr_id,
             ROCPROFILER_EXTERNAL_CORRELATION_REQUEST_KERNEL_DISPATCH);
 
-        // If there is a lot of contention for HSA signals, then schedule out the thread
-        if(get_balanced_signal_slots().fetch_sub(1) <= 0)
-        {
-            sched_yield();
-            std::this_thread::sleep_for(std::chrono::nanoseconds(100));
-        }
-
         // Stores the instrumentation pkt (i.e. AQL packets for counter collection)
         // along with an ID of the client we got the packet from (this will be returned via
         // completed_cb_t)
@@ -433,7 +446,7 @@ WriteInterceptor(const void* packets,
         if(injected_end_pkt)
         {
             // Adding a barrier packet with the original packet's completion signal.
-            queue.create_signal(0, &interrupt_signal);
+            interrupt_signal                                             = queue.acquire_signal();
             completion_signal                                            = interrupt_signal;
             transformed_packets.back().ext_amd_aql_pm4.completion_signal = interrupt_signal;
             CreateBarrierPacket(&interrupt_signal, &interrupt_signal, transformed_packets);
@@ -462,10 +475,8 @@ WriteInterceptor(const void* packets,
                                                      .callback_record  = callback_record,
                                                      .tracing_data     = tracing_data_v};
 
-            auto shared = std::make_shared<Queue::queue_info_session_t>(std::move(info_session));
-
             queue.signal_async_handler(completion_signal,
-                                       new std::shared_ptr<Queue::queue_info_session_t>(shared));
+                                       queue.create_session(std::move(info_session)));
 
             auto tracer_data = callback_record;
             tracing::execute_phase_exit_callbacks(tracing_data_v.callback_contexts,
@@ -487,6 +498,7 @@ WriteInterceptor(const void* packets,
 Queue::Queue(const AgentCache& agent, CoreApiTable table)
 : _core_api(table)
 , _agent(agent)
+, _session_slab(make_session_slab())
 {
     _core_api.hsa_signal_create_fn(0, 0, nullptr, &_active_kernels);
 }
@@ -504,6 +516,7 @@ Queue::Queue(const AgentCache&  agent,
 : _core_api(core_api)
 , _ext_api(ext_api)
 , _agent(agent)
+, _session_slab(make_session_slab())
 {
     ROCP_HSA_TABLE_CALL(FATAL,
                         _ext_api.hsa_amd_queue_intercept_create_fn(_agent.get_hsa_agent(),
@@ -565,6 +578,11 @@ Queue::~Queue()
 {
     sync();
     _core_api.hsa_signal_destroy_fn(_active_kernels);
+
+    auto _lk = std::unique_lock<std::mutex>{_signal_pool_mutex};
+    for(auto itr : _signal_pool)
+        _core_api.hsa_signal_destroy_fn(itr);
+    _signal_pool.clear();
 }
 
 void
@@ -591,6 +609,70 @@ Queue::create_signal(uint32_t attribute, hsa_signal_t* signal) const
         << " :: " << hsa::get_hsa_status_string(status);
 }
 
+hsa_signal_t
+Queue::acquire_signal() const
+{
+    auto _signal   = hsa_signal_t{.handle = 0};
+    auto _try_pool = [this, &_signal]() {
+        auto _lk = std::unique_lock<std::mutex>{_signal_pool_mutex};
+        if(_signal_pool.empty()) return false;
+        _signal = _signal_pool.back();
+        _signal_pool.pop_back();
+        return true;
+    };
+
+    auto _reused = _try_pool();
+
+    // If there is a lot of contention for HSA signals, then schedule out the thread
+    if(!_reused && _signals_in_use.load(std::memory_order_relaxed) >= signal_throttle_count)
+    {
+        sched_yield();
+        std::this_thread::sleep_for(std::chrono::nanoseconds(100));
+        _reused = _try_pool();
+    }
+
+    // a recycled signal may still hold the value it completed with, reset it before it is
+    // handed to a packet
+    if(_reused)
+        _core_api.hsa_signal_store_screlease_fn(_signal, 1);
+    else
+        create_signal(0, &_signal);
+
+    _signals_in_use.fetch_add(1, std::memory_order_relaxed);
+    return _signal;
+}
+
+void
+Queue::release_signal(hsa_signal_t signal) const
+{
+    if(signal.handle == 0) return;
+
+    _signals_in_use.fetch_sub(1, std::memory_order_relaxed);
+
+    auto _lk = std::unique_lock<std::mutex>{_signal_pool_mutex};
+    _signal_pool.emplace_back(signal);
+}
+
+Queue::session_ptr_t*
+Queue::create_session(queue_info_session_t&& session) const
+{
+    using allocator_t = common::memory::slab_allocator<queue_info_session_t>;
+
+    auto* _ptr = _session_ptr_slab.allocate();
+    return new(_ptr) session_ptr_t{
+        std::allocate_shared<queue_info_session_t>(allocator_t{_session_slab}, std::move(session))};
+}
+
+void
+Queue::destroy_session(session_ptr_t* session) const
+{
+    if(!session) return;
+
+    // may release the last reference, returning the session to the session slab
+    session->~session_ptr_t();
+    _session_ptr_slab.deallocate(session);
+}
+
 void
 Queue::sync() const
 {
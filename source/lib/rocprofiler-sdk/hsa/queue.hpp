@@ -28,6 +28,7 @@
 #include <rocprofiler-sdk/fwd.h>
 
 #include "lib/common/container/small_vector.hpp"
+#include "lib/common/memory/slab.hpp"
 #include "lib/common/synchronized.hpp"
 #include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
 #include "lib/rocprofiler-sdk/hsa/aql_packet.hpp"
@@ -46,7 +47,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace rocprofiler
 {
@@ -72,6 +75,7 @@ public:
     using context_array_t      = common::container::small_vector<const context_t*>;
     using callback_t           = void (*)(hsa_status_t status, hsa_queue_t* source, void* data);
     using queue_info_session_t = queue_info_session;
+    using session_ptr_t        = std::shared_ptr<queue_info_session_t>;
 
     // Function prototype used to notify consumers that a kernel has been
     // enqueued. An AQL packet can be returned that will be injected into
@@ -111,6 +115,14 @@ public:
     void create_signal(uint32_t attribute, hsa_signal_t* signal) const;
     void signal_async_handler(const hsa_signal_t& signal, void* data) const;
 
+    // Completion signals and info sessions are recycled per-queue: in steady state,
+    // intercepting a dispatch neither creates an HSA signal nor heap-allocates a session.
+    // acquire_signal returns a signal with a value of 1 (same as create_signal).
+    hsa_signal_t   acquire_signal() const;
+    void           release_signal(hsa_signal_t signal) const;
+    session_ptr_t* create_session(queue_info_session_t&& session) const;
+    void           destroy_session(session_ptr_t* session) const;
+
     template <typename FuncT>
     void signal_callback(FuncT&& func) const;
 
@@ -146,6 +158,10 @@ public:
     void                            set_state(queue_state state);
 
 private:
+    // when no signal is available for reuse and at least this many are in use, the
+    // dispatching thread is scheduled out to let the async handler recycle one
+    static constexpr int64_t signal_throttle_count = 16;
+
     std::atomic<int>                                  _notifiers            = {0};
     std::atomic<int64_t>                              _active_async_packets = {0};
     CoreApiTable                                      _core_api             = {};
@@ -156,6 +172,11 @@ private:
     queue_state                                       _state           = queue_state::normal;
     std::mutex                                        _lock_queue;
     hsa_signal_t                                      _active_kernels = {.handle = 0};
+    mutable std::mutex                                _signal_pool_mutex = {};
+    mutable std::vector<hsa_signal_t>                 _signal_pool       = {};
+    mutable std::atomic<int64_t>                      _signals_in_use    = {0};
+    mutable common::memory::slab                      _session_ptr_slab{sizeof(session_ptr_t)};
+    std::shared_ptr<common::memory::slab>             _session_slab = {};
 };
 
 inline rocprofiler_queue_id_t
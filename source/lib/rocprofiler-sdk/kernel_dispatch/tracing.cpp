@@ -35,6 +35,7 @@
 
 #include <hsa/hsa.h>
 
+#include <optional>
 #include <string_view>
 
 namespace rocprofiler
@@ -52,10 +53,12 @@ get_dispatch_time(const hsa::queue_info_session& session)
 {
     const auto& callback_record = session.callback_record;
     const auto* _rocp_agent     = agent::get_agent(callback_record.dispatch_info.agent_id);
-    auto        _hsa_agent      = agent::get_hsa_agent(_rocp_agent);
+    auto        _hsa_agent      = std::optional<hsa_agent_t>{};
     auto        _signal         = session.kernel_pkt.kernel_dispatch.completion_signal;
     auto        _kern_id        = callback_record.dispatch_info.kernel_id;
 
+    if(_rocp_agent) _hsa_agent = agent::get_hsa_agent(_rocp_agent);
+
     return (_hsa_agent) ? get_dispatch_time(*_hsa_agent, _signal, _kern_id, session.enqueue_ts)
                         : profiling_time{.status = HSA_STATUS_ERROR_INVALID_AGENT};
 }
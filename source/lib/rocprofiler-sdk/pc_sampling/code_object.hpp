@@ -82,10 +82,9 @@ public:
     // Must acquire read lock
     address_range_t find_codeobj_in_range(uint64_t addr) const
     {
-        auto it = this->find(address_range_t{addr, 0, 0});
         // `addr` might originate from an unknown code object.
-        if(it == this->end()) return address_range_t{0, 0, ROCPROFILER_CODE_OBJECT_ID_NONE};
-        return *it;
+        return this->lookup(addr).value_or(
+            address_range_t{0, 0, ROCPROFILER_CODE_OBJECT_ID_NONE});
     }
 
     static CodeobjTableTranslatorSynchronized* Get()
@@ -24,16 +24,25 @@
 #include "lib/common/units.hpp"
 
 #include <rocprofiler-sdk/buffer.h>
+#include <rocprofiler-sdk/experimental/buffer.h>
 #include <rocprofiler-sdk/fwd.h>
 #include <rocprofiler-sdk/registration.h>
 
 #include <gtest/gtest.h>
 
 #include <pthread.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <iostream>
+#include <limits>
 #include <random>
+#include <thread>
 #include <typeinfo>
+#include <vector>
 
 TEST(rocprofiler_lib, buffer)
 {
@@ -76,3 +85,203 @@ TEST(rocprofiler_lib, buffer)
     auto destroy_status = rocprofiler_destroy_buffer(*buffer_id);
     EXPECT_EQ(destroy_status, ROCPROFILER_STATUS_SUCCESS);
 }
+
+TEST(rocprofiler_lib, buffer_per_thread_lanes)
+{
+    namespace buffer = ::rocprofiler::buffer;
+    namespace common = ::rocprofiler::common;
+
+    constexpr size_t num_threads = 8;
+    constexpr size_t num_records = 10000;
+
+    struct thread_record
+    {
+        uint64_t thread_idx = 0;
+        uint64_t value      = 0;
+    };
+
+    struct callback_data
+    {
+        std::array<uint64_t, num_threads> next         = {};
+        size_t                            count        = 0;
+        size_t                            out_of_order = 0;
+    };
+
+    auto buffer_id = buffer::allocate_buffer();
+    ASSERT_TRUE(buffer_id) << "failed to allocate buffer";
+
+    auto* buffer_v = buffer::get_buffer(*buffer_id);
+    ASSERT_NE(buffer_v, nullptr) << "get_buffer returned a nullptr. id=" << buffer_id->handle;
+
+    auto data               = callback_data{};
+    buffer_v->size          = common::units::get_page_size();
+    buffer_v->watermark     = buffer_v->size / 2;
+    buffer_v->policy        = ROCPROFILER_BUFFER_POLICY_LOSSLESS;
+    buffer_v->mode          = ROCPROFILER_BUFFER_MODE_PER_THREAD;
+    buffer_v->callback_data = &data;
+
+    buffer_v->callback = [](rocprofiler_context_id_t,
+                            rocprofiler_buffer_id_t,
+                            rocprofiler_record_header_t** headers,
+                            size_t                        num_headers,
+                            void*                         user_data,
+                            uint64_t) {
+        auto* _data = static_cast<callback_data*>(user_data);
+        for(size_t i = 0; i < num_headers; ++i)
+        {
+            auto* _record = static_cast<thread_record*>(headers[i]->payload);
+            if(_record->value != _data->next.at(_record->thread_idx)) ++_data->out_of_order;
+            _data->next.at(_record->thread_idx) = _record->value + 1;
+            ++_data->count;
+        }
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for(size_t i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([buffer_v, i]() {
+            for(size_t j = 0; j < num_records; ++j)
+            {
+                auto _record = thread_record{i, j};
+                buffer_v->emplace(1, 1, _record);
+            }
+        });
+    }
+
+    for(auto& itr : threads)
+        itr.join();
+
+    auto flush_status = buffer::flush(*buffer_id, true);
+    EXPECT_EQ(flush_status, ROCPROFILER_STATUS_SUCCESS);
+
+    EXPECT_EQ(data.count, num_threads * num_records);
+    EXPECT_EQ(data.out_of_order, 0);
+    EXPECT_EQ(buffer_v->drop_count.load(), 0);
+    EXPECT_LE(buffer_v->lanes.size(), num_threads);
+
+    auto destroy_status = rocprofiler_destroy_buffer(*buffer_id);
+    EXPECT_EQ(destroy_status, ROCPROFILER_STATUS_SUCCESS);
+}
+
+TEST(rocprofiler_lib, buffer_pool)
+{
+    namespace buffer = ::rocprofiler::buffer;
+    namespace common = ::rocprofiler::common;
+
+    constexpr size_t num_threads = 4;
+    constexpr size_t num_records = 20000;
+    constexpr size_t num_buffers = 4;
+
+    struct callback_data
+    {
+        std::atomic<size_t> count = 0;
+    };
+
+    auto buffer_id = buffer::allocate_buffer();
+    ASSERT_TRUE(buffer_id) << "failed to allocate buffer";
+
+    auto* buffer_v = buffer::get_buffer(*buffer_id);
+    ASSERT_NE(buffer_v, nullptr) << "get_buffer returned a nullptr. id=" << buffer_id->handle;
+
+    auto data               = callback_data{};
+    buffer_v->size          = common::units::get_page_size();
+    buffer_v->watermark     = buffer_v->size;
+    buffer_v->policy        = ROCPROFILER_BUFFER_POLICY_LOSSLESS;
+    buffer_v->callback_data = &data;
+    buffer_v->allocate_internal_buffers(num_buffers, 2 * num_buffers * buffer_v->size);
+
+    EXPECT_EQ(buffer_v->buffer_count.load(), num_buffers);
+
+    // a slow callback forces the producers to rotate through (and grow) the pool
+    buffer_v->callback = [](rocprofiler_context_id_t,
+                            rocprofiler_buffer_id_t,
+                            rocprofiler_record_header_t**,
+                            size_t num_headers,
+                            void*  user_data,
+                            uint64_t) {
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+        static_cast<callback_data*>(user_data)->count += num_headers;
+    };
+
+    auto threads = std::vector<std::thread>{};
+    for(size_t i = 0; i < num_threads; ++i)
+    {
+        threads.emplace_back([buffer_v]() {
+            for(size_t j = 0; j < num_records; ++j)
+            {
+                auto _record = uint64_t{j};
+                buffer_v->emplace(1, 1, _record);
+            }
+        });
+    }
+
+    for(auto& itr : threads)
+        itr.join();
+
+    auto flush_status = buffer::flush(*buffer_id, true);
+    EXPECT_EQ(flush_status, ROCPROFILER_STATUS_SUCCESS);
+
+    auto stats = rocprofiler_buffer_stats_t{};
+    EXPECT_EQ(rocprofiler_query_buffer_stats(*buffer_id, &stats), ROCPROFILER_STATUS_SUCCESS);
+    EXPECT_EQ(stats.drop_count, 0);
+    EXPECT_GE(stats.num_buffers, num_buffers);
+    EXPECT_LE(stats.num_buffers, 2 * num_buffers);
+    EXPECT_EQ(data.count.load(), num_threads * num_records);
+
+    auto destroy_status = rocprofiler_destroy_buffer(*buffer_id);
+    EXPECT_EQ(destroy_status, ROCPROFILER_STATUS_SUCCESS);
+}
+
+TEST(rocprofiler_lib, buffer_flush_cost)
+{
+    namespace common = ::rocprofiler::common;
+
+    using buffer_t = common::container::record_header_buffer;
+
+    // the work done by a flush should be proportional to the number of records in the buffer,
+    // not the size of the buffer: the header storage and the view only cover the emplaced records
+    constexpr size_t num_records      = 1000;
+    constexpr size_t num_iterations   = 16;
+    constexpr auto   buffer_sizes_mib = std::array<size_t, 4>{1, 4, 16, 64};
+    constexpr size_t header_capacity =
+        ((num_records + buffer_t::header_chunk_size - 1) / buffer_t::header_chunk_size) *
+        buffer_t::header_chunk_size;
+
+    for(auto itr : buffer_sizes_mib)
+    {
+        auto _buffer = buffer_t{itr * common::units::MiB};
+        EXPECT_EQ(_buffer.header_capacity(), 0) << "buffer size: " << itr << " MiB";
+
+        // the fastest flush is reported since the first iterations touch new pages
+        auto _min_ns = std::numeric_limits<double>::max();
+        for(size_t i = 0; i < num_iterations; ++i)
+        {
+            for(size_t j = 0; j < num_records; ++j)
+            {
+                auto _record = uint64_t{j};
+                ASSERT_TRUE(_buffer.emplace(1, 1, _record));
+            }
+
+            auto _beg       = std::chrono::steady_clock::now();
+            auto _view      = _buffer.get_record_header_view();
+            auto _view_size = _view.size();
+            auto _cleared   = _buffer.clear();
+            auto _end       = std::chrono::steady_clock::now();
+
+            _min_ns =
+                std::min(_min_ns, std::chrono::duration<double, std::nano>(_end - _beg).count());
+
+            EXPECT_EQ(_view_size, num_records);
+            EXPECT_EQ(_cleared, num_records);
+            EXPECT_EQ(_buffer.size(), 0);
+
+            // the header storage is retained across clears and does not grow with the buffer size
+            EXPECT_EQ(_buffer.header_capacity(), header_capacity)
+                << "buffer size: " << itr << " MiB, iteration: " << i;
+        }
+
+        std::cout << "[buffer_flush_cost] buffer size: " << itr << " MiB, records: " << num_records
+                  << ", flush: " << _min_ns << " ns (" << (_min_ns / num_records)
+                  << " ns/record)\n";
+    }
+}
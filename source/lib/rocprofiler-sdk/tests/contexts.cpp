@@ -382,3 +382,84 @@ TEST(contexts, buffer_tracing)
         }
     }
 }
+
+TEST(contexts, active_tracing_snapshot)
+{
+    constexpr auto hip_domain = ROCPROFILER_CALLBACK_TRACING_HIP_RUNTIME_API;
+    constexpr auto hsa_domain = ROCPROFILER_BUFFER_TRACING_HSA_CORE_API;
+    constexpr auto hip_op_a   = rocprofiler_tracing_operation_t{1};
+    constexpr auto hip_op_b   = rocprofiler_tracing_operation_t{2};
+    constexpr auto client_idx = 0;
+
+    context::push_client(client_idx);
+    auto callback_ctx_id = context::allocate_context();
+    auto buffered_ctx_id = context::allocate_context();
+    context::pop_client(client_idx);
+
+    ASSERT_TRUE(callback_ctx_id);
+    ASSERT_TRUE(buffered_ctx_id);
+
+    // callback tracing restricted to a single operation
+    auto* callback_ctx            = context::get_mutable_registered_context(*callback_ctx_id);
+    callback_ctx->callback_tracer = std::make_unique<context::callback_tracing_service>();
+    EXPECT_ROCP_SUCCESS(context::add_domain(callback_ctx->callback_tracer->domains, hip_domain));
+    EXPECT_ROCP_SUCCESS(
+        context::add_domain_op(callback_ctx->callback_tracer->domains, hip_domain, hip_op_a));
+
+    // buffered tracing of every operation in the domain
+    auto* buffered_ctx            = context::get_mutable_registered_context(*buffered_ctx_id);
+    buffered_ctx->buffered_tracer = std::make_unique<context::buffer_tracing_service>();
+    EXPECT_ROCP_SUCCESS(context::add_domain(buffered_ctx->buffered_tracer->domains, hsa_domain));
+
+    auto epoch = context::get_active_tracing_contexts().epoch;
+
+    EXPECT_ROCP_SUCCESS(context::start_context(*callback_ctx_id));
+    {
+        const auto& active = context::get_active_tracing_contexts();
+        EXPECT_EQ(active.epoch, epoch + 1);
+        ASSERT_EQ(active.contexts.size(), 1);
+        EXPECT_EQ(active.contexts.front(), callback_ctx);
+        EXPECT_TRUE(active.callback_domains(hip_domain, hip_op_a));
+        EXPECT_FALSE(active.callback_domains(hip_domain, hip_op_b));
+        EXPECT_FALSE(active.buffered_domains(hsa_domain));
+    }
+
+    EXPECT_ROCP_SUCCESS(context::start_context(*buffered_ctx_id));
+    {
+        const auto& active = context::get_active_tracing_contexts();
+        EXPECT_EQ(active.epoch, epoch + 2);
+        EXPECT_EQ(active.contexts.size(), 2);
+        EXPECT_TRUE(active.callback_domains(hip_domain, hip_op_a));
+        EXPECT_TRUE(active.buffered_domains(hsa_domain, 1));
+        EXPECT_TRUE(active.buffered_domains(hsa_domain, 2));
+    }
+
+    // a context with every operation enabled takes precedence over one with a subset
+    auto merged  = context::domain_context<rocprofiler_callback_tracing_kind_t>{};
+    auto all_ops = context::domain_context<rocprofiler_callback_tracing_kind_t>{};
+    EXPECT_ROCP_SUCCESS(context::add_domain(all_ops, hip_domain));
+    context::merge_domains(merged, callback_ctx->callback_tracer->domains);
+    EXPECT_FALSE(merged(hip_domain, hip_op_b));
+    context::merge_domains(merged, all_ops);
+    EXPECT_TRUE(merged(hip_domain, hip_op_a));
+    EXPECT_TRUE(merged(hip_domain, hip_op_b));
+
+    const auto& previous = context::get_active_tracing_contexts();
+
+    EXPECT_ROCP_SUCCESS(context::stop_context(*callback_ctx_id));
+    {
+        const auto& active = context::get_active_tracing_contexts();
+        EXPECT_EQ(active.epoch, epoch + 3);
+        ASSERT_EQ(active.contexts.size(), 1);
+        EXPECT_EQ(active.contexts.front(), buffered_ctx);
+        EXPECT_FALSE(active.callback_domains(hip_domain, hip_op_a));
+        EXPECT_TRUE(active.buffered_domains(hsa_domain));
+    }
+
+    // readers holding an older snapshot still see a consistent view
+    EXPECT_EQ(previous.contexts.size(), 2);
+
+    EXPECT_ROCP_SUCCESS(context::stop_context(*buffered_ctx_id));
+    EXPECT_TRUE(context::get_active_tracing_contexts().contexts.empty());
+    EXPECT_EQ(context::get_active_tracing_contexts().epoch, epoch + 4);
+}
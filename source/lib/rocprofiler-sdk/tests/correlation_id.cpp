@@ -0,0 +1,162 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+#include "lib/common/environment.hpp"
+#include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/context/correlation_id.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace context = ::rocprofiler::context;
+namespace common  = ::rocprofiler::common;
+
+namespace
+{
+bool
+never_free_enabled()
+{
+    return common::get_env("ROCPROFILER_CORRELATION_ID_NEVER_FREE", false);
+}
+
+// resident set size in bytes
+int64_t
+get_rss()
+{
+    auto ifs      = std::ifstream{"/proc/self/statm"};
+    auto vm_pages = int64_t{0};
+    auto rs_pages = int64_t{0};
+    if(!(ifs >> vm_pages >> rs_pages)) return 0;
+    return rs_pages * sysconf(_SC_PAGESIZE);
+}
+
+// mirrors the lifetime of a correlation id for an API call with no kernel dispatch
+void
+trace_api_call()
+{
+    auto* corr_id = context::correlation_tracing_service::construct(2);
+    corr_id->sub_ref_count();
+    corr_id->sub_ref_count();
+    context::pop_latest_correlation_id(corr_id);
+}
+}  // namespace
+
+TEST(correlation_id, recycle)
+{
+    if(never_free_enabled()) GTEST_SKIP() << "correlation id recycling is disabled";
+
+    auto* first = context::correlation_tracing_service::construct(1);
+    ASSERT_NE(first, nullptr);
+    first->add_kern_count();
+
+    auto first_internal = first->internal;
+    first->sub_ref_count();
+    context::pop_latest_correlation_id(first);
+
+    // the retired correlation id is the most recent entry in the thread-local free-list
+    auto* second = context::correlation_tracing_service::construct(3);
+    EXPECT_EQ(second, first);
+    EXPECT_GT(second->internal, first_internal);
+    EXPECT_EQ(second->get_ref_count(), 3);
+    EXPECT_EQ(second->get_kern_count(), 0);
+    EXPECT_EQ(second->thread_idx, common::get_tid());
+    EXPECT_EQ(context::get_latest_correlation_id(), second);
+
+    for(int i = 0; i < 3; ++i)
+        second->sub_ref_count();
+    context::pop_latest_correlation_id(second);
+}
+
+TEST(correlation_id, cross_thread_retirement)
+{
+    if(never_free_enabled()) GTEST_SKIP() << "correlation id recycling is disabled";
+
+    // correlation ids for kernel dispatches are created on the dispatching thread and retired on
+    // the HSA async signal handler thread. The pool must route them back to the creating thread.
+    constexpr size_t batch_size = 4096;
+    constexpr size_t num_rounds = 256;
+
+    auto batch    = std::vector<context::correlation_id*>{};
+    auto distinct = std::unordered_set<context::correlation_id*>{};
+    batch.reserve(batch_size);
+
+    for(size_t i = 0; i < num_rounds; ++i)
+    {
+        batch.clear();
+        for(size_t j = 0; j < batch_size; ++j)
+        {
+            auto* corr_id = context::correlation_tracing_service::construct(1);
+            context::pop_latest_correlation_id(corr_id);
+            batch.emplace_back(corr_id);
+            distinct.emplace(corr_id);
+        }
+
+        std::thread{[&batch]() {
+            for(auto* itr : batch)
+                itr->sub_ref_count();
+        }}.join();
+    }
+
+    EXPECT_LT(distinct.size(), 4 * batch_size);
+}
+
+// uses 1M correlation ids by default, set ROCPROFILER_CORRELATION_ID_STRESS_ITERATIONS to a larger
+// value (e.g. 100000000) for a long-running stress test
+TEST(correlation_id, stress_flat_rss)
+{
+    if(never_free_enabled()) GTEST_SKIP() << "correlation id recycling is disabled";
+
+    const auto num_iterations =
+        common::get_env<uint64_t>("ROCPROFILER_CORRELATION_ID_STRESS_ITERATIONS", 1000000);
+    const auto num_warmup = std::min<uint64_t>(num_iterations / 10, 1000000);
+
+    for(uint64_t i = 0; i < num_warmup; ++i)
+        trace_api_call();
+
+    auto rss_begin = get_rss();
+    auto t_begin   = std::chrono::steady_clock::now();
+
+    for(uint64_t i = num_warmup; i < num_iterations; ++i)
+        trace_api_call();
+
+    auto t_end   = std::chrono::steady_clock::now();
+    auto rss_end = get_rss();
+    auto elapsed = std::chrono::duration<double, std::nano>(t_end - t_begin).count();
+
+    std::cout << "[correlation_id] " << num_iterations << " correlation ids, "
+              << (elapsed / std::max<uint64_t>(num_iterations - num_warmup, 1)) << " nsec/id, "
+              << "rss growth: " << (rss_end - rss_begin) / 1024 << " KB" << std::endl;
+
+    // never freeing would grow by tens of megabytes for 1M correlation ids and by several
+    // gigabytes for 100M correlation ids
+    constexpr int64_t max_rss_growth = 8 * 1024 * 1024;
+    EXPECT_LT(rss_end - rss_begin, max_rss_growth);
+}
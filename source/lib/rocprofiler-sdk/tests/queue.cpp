@@ -0,0 +1,254 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#include "lib/rocprofiler-sdk/hsa/queue.hpp"
+#include "lib/rocprofiler-sdk/hsa/agent_cache.hpp"
+#include "lib/rocprofiler-sdk/hsa/rocprofiler_packet.hpp"
+
+#include <rocprofiler-sdk/agent.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include <hsa/hsa.h>
+#include <hsa/hsa_api_trace.h>
+#include <hsa/hsa_ext_amd.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+namespace hsa = ::rocprofiler::hsa;
+
+// Minimal stand-in for the HSA runtime: signals are heap-allocated atomics, the intercept
+// queue is a static hsa_queue_t, and async handlers are recorded so that the test decides
+// when a dispatch "completes"
+struct mock_handler
+{
+    hsa_amd_signal_handler handler = nullptr;
+    void*                  arg     = nullptr;
+};
+
+struct mock_runtime
+{
+    std::atomic<uint64_t>           signals_created   = {0};
+    std::atomic<uint64_t>           signals_destroyed = {0};
+    uint64_t                        packets_written   = 0;
+    hsa_queue_t                     queue             = {};
+    std::vector<mock_handler>       handlers          = {};
+    hsa_amd_queue_intercept_handler interceptor       = nullptr;
+    void*                           interceptor_data  = nullptr;
+};
+
+mock_runtime&
+get_mock()
+{
+    static auto _v = mock_runtime{};
+    return _v;
+}
+
+std::atomic<hsa_signal_value_t>*
+get_value(hsa_signal_t signal)
+{
+    return reinterpret_cast<std::atomic<hsa_signal_value_t>*>(signal.handle);
+}
+
+hsa_signal_t
+make_signal(hsa_signal_value_t value)
+{
+    ++get_mock().signals_created;
+    auto* _v = new std::atomic<hsa_signal_value_t>{value};
+    return hsa_signal_t{.handle = reinterpret_cast<uint64_t>(_v)};
+}
+
+// generic lambdas convert to whichever function pointer type the table entry requires
+CoreApiTable
+get_mock_core_table()
+{
+    auto _table = CoreApiTable{};
+
+    _table.hsa_signal_create_fn = [](auto value, auto, auto, hsa_signal_t* signal) {
+        *signal = make_signal(value);
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_signal_destroy_fn = [](hsa_signal_t signal) {
+        ++get_mock().signals_destroyed;
+        delete get_value(signal);
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_signal_store_relaxed_fn = [](hsa_signal_t signal, auto value) {
+        get_value(signal)->store(value);
+    };
+    _table.hsa_signal_store_screlease_fn = [](hsa_signal_t signal, auto value) {
+        get_value(signal)->store(value);
+    };
+    _table.hsa_signal_add_relaxed_fn = [](hsa_signal_t signal, auto value) {
+        get_value(signal)->fetch_add(value);
+    };
+    _table.hsa_signal_subtract_relaxed_fn = [](hsa_signal_t signal, auto value) {
+        get_value(signal)->fetch_sub(value);
+    };
+    _table.hsa_signal_load_scacquire_fn = [](hsa_signal_t signal) {
+        return get_value(signal)->load();
+    };
+    _table.hsa_signal_wait_relaxed_fn = [](hsa_signal_t signal, auto, auto, auto, auto) {
+        return get_value(signal)->load();
+    };
+
+    return _table;
+}
+
+AmdExtTable
+get_mock_ext_table()
+{
+    auto _table = AmdExtTable{};
+
+    _table.hsa_amd_signal_create_fn = [](auto value, auto, auto, auto, hsa_signal_t* signal) {
+        *signal = make_signal(value);
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_amd_signal_async_handler_fn = [](hsa_signal_t, auto, auto, auto handler, void* arg) {
+        get_mock().handlers.emplace_back(mock_handler{handler, arg});
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_amd_agent_iterate_memory_pools_fn = [](auto, auto, auto) {
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_amd_queue_intercept_create_fn =
+        [](auto, auto, auto, auto, auto, auto, auto, hsa_queue_t** queue) {
+            *queue = &get_mock().queue;
+            return HSA_STATUS_SUCCESS;
+        };
+    _table.hsa_amd_profiling_set_profiler_enabled_fn = [](auto, auto) {
+        return HSA_STATUS_SUCCESS;
+    };
+    _table.hsa_amd_queue_intercept_register_fn = [](auto, auto callback, void* data) {
+        get_mock().interceptor      = callback;
+        get_mock().interceptor_data = data;
+        return HSA_STATUS_SUCCESS;
+    };
+
+    return _table;
+}
+
+void
+complete_dispatches()
+{
+    auto _handlers = std::move(get_mock().handlers);
+    get_mock().handlers.clear();
+    for(auto& itr : _handlers)
+        itr.handler(-1, itr.arg);
+}
+}  // namespace
+
+TEST(queue, write_interceptor_overhead)
+{
+    constexpr size_t num_dispatches = 20000;
+    constexpr size_t max_in_flight  = 32;
+
+    auto core_table = get_mock_core_table();
+    auto ext_table  = get_mock_ext_table();
+
+    auto rocp_agent = rocprofiler_agent_t{};
+    rocp_agent.size = sizeof(rocprofiler_agent_t);
+    rocp_agent.id   = rocprofiler_agent_id_t{.handle = 0xdeadbeef};
+    rocp_agent.name = "mock-agent";
+
+    auto agent_cache = hsa::AgentCache{&rocp_agent,
+                                       hsa_agent_t{.handle = 1},
+                                       0,
+                                       hsa_agent_t{.handle = 2},
+                                       ext_table,
+                                       core_table};
+
+    hsa_queue_t* hsa_queue = nullptr;
+    auto         queue     = std::make_unique<hsa::Queue>(agent_cache,
+                                                64,
+                                                HSA_QUEUE_TYPE_MULTI,
+                                                nullptr,
+                                                nullptr,
+                                                0,
+                                                0,
+                                                core_table,
+                                                ext_table,
+                                                &hsa_queue);
+
+    ASSERT_EQ(hsa_queue, &get_mock().queue);
+    ASSERT_NE(get_mock().interceptor, nullptr);
+
+    // a no-op client so that every dispatch goes through the full interception path
+    queue->register_callback(
+        1,
+        [](const auto&, const auto&, auto, auto, auto*, const auto&, const auto*) {
+            return std::unique_ptr<hsa::AQLPacket>{};
+        },
+        [](const auto&, const auto&, auto&, auto&, auto) {});
+
+    auto writer = [](const void*, uint64_t pkt_count) { get_mock().packets_written += pkt_count; };
+
+    auto packet                   = hsa::rocprofiler_packet{};
+    packet.kernel_dispatch.header = HSA_PACKET_TYPE_KERNEL_DISPATCH << HSA_PACKET_HEADER_TYPE;
+
+    packet.kernel_dispatch.workgroup_size_x = 64;
+    packet.kernel_dispatch.grid_size_x      = 64;
+
+    auto dispatch = [&]() {
+        get_mock().interceptor(&packet, 1, 0, get_mock().interceptor_data, writer);
+        if(get_mock().handlers.size() >= max_in_flight) complete_dispatches();
+    };
+
+    // warm up: grows the signal pool and session slab to the in-flight high-water mark
+    for(size_t i = 0; i < 2 * max_in_flight; ++i)
+        dispatch();
+
+    auto created_before = get_mock().signals_created.load();
+    auto t_beg          = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < num_dispatches; ++i)
+        dispatch();
+    auto t_end = std::chrono::steady_clock::now();
+    complete_dispatches();
+
+    auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_beg).count();
+    std::cout << "[queue] write interceptor overhead: " << std::setprecision(4)
+              << (static_cast<double>(elapsed_ns) / num_dispatches) << " ns/dispatch ("
+              << num_dispatches << " dispatches, " << max_in_flight << " in flight)\n"
+              << std::flush;
+
+    // steady state recycles signals instead of creating new ones
+    EXPECT_EQ(get_mock().signals_created.load(), created_before);
+    EXPECT_EQ(get_mock().packets_written, num_dispatches + (2 * max_in_flight));
+    EXPECT_EQ(queue->active_async_packets(), 0);
+
+    // normally destroyed by the queue controller
+    queue->remove_callback(1);
+    core_table.hsa_signal_destroy_fn(queue->ready_signal);
+    core_table.hsa_signal_destroy_fn(queue->block_signal);
+    queue.reset();
+
+    // every signal created by the queue (including pooled ones) is destroyed with it
+    EXPECT_EQ(get_mock().signals_created.load(), get_mock().signals_destroyed.load());
+}
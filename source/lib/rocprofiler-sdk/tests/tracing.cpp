@@ -0,0 +1,316 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+#include "lib/common/environment.hpp"
+#include "lib/common/utility.hpp"
+#include "lib/rocprofiler-sdk/context/context.hpp"
+#include "lib/rocprofiler-sdk/context/domain.hpp"
+#include "lib/rocprofiler-sdk/tracing/fwd.hpp"
+#include "lib/rocprofiler-sdk/tracing/tracing.hpp"
+
+#include <rocprofiler-sdk/callback_tracing.h>
+#include <rocprofiler-sdk/experimental/tracing.h>
+#include <rocprofiler-sdk/external_correlation.h>
+#include <rocprofiler-sdk/fwd.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace context = ::rocprofiler::context;
+namespace tracing = ::rocprofiler::tracing;
+namespace common  = ::rocprofiler::common;
+
+namespace
+{
+constexpr auto benchmark_domain    = ROCPROFILER_CALLBACK_TRACING_HIP_RUNTIME_API;
+constexpr auto benchmark_corr_kind = ROCPROFILER_EXTERNAL_CORRELATION_REQUEST_HIP_RUNTIME_API;
+constexpr auto benchmark_op        = rocprofiler_tracing_operation_t{1};
+
+uint64_t callback_count = 0;
+
+void
+noop_callback(rocprofiler_callback_tracing_record_t, rocprofiler_user_data_t*, void*)
+{
+    ++callback_count;
+}
+
+// mirrors the sequence of tracing calls made by the HIP API wrappers for a function with no
+// arguments (see hip::hip_api_impl::functor)
+void
+traced_noop_api(uint64_t internal_corr_id)
+{
+    auto thr_id            = common::get_tid();
+    auto callback_contexts = tracing::callback_context_data_vec_t{};
+    auto buffered_contexts = tracing::buffered_context_data_vec_t{};
+    auto external_corr_ids = tracing::external_correlation_id_map_t{};
+
+    tracing::populate_contexts(benchmark_domain,
+                               ROCPROFILER_BUFFER_TRACING_NONE,
+                               benchmark_op,
+                               callback_contexts,
+                               buffered_contexts,
+                               external_corr_ids);
+
+    if(callback_contexts.empty()) return;
+
+    auto tracer_data = rocprofiler_callback_tracing_hip_api_data_t{};
+
+    tracing::populate_external_correlation_ids(
+        external_corr_ids, thr_id, benchmark_corr_kind, benchmark_op, internal_corr_id);
+
+    tracing::execute_phase_enter_callbacks(callback_contexts,
+                                           thr_id,
+                                           internal_corr_id,
+                                           external_corr_ids,
+                                           benchmark_domain,
+                                           benchmark_op,
+                                           tracer_data);
+
+    tracing::update_external_correlation_ids(external_corr_ids, thr_id, benchmark_corr_kind);
+
+    tracing::execute_phase_exit_callbacks(
+        callback_contexts, external_corr_ids, benchmark_domain, benchmark_op, tracer_data);
+}
+}  // namespace
+
+TEST(tracing, external_correlation_id_map)
+{
+    auto _data = tracing::external_correlation_id_map_t{};
+    auto _ctxs = std::vector<context::context>(2 * tracing::external_correlation_map_size);
+
+    for(auto& itr : _ctxs)
+    {
+        auto _ret = _data.emplace(&itr, tracing::empty_user_data);
+        EXPECT_TRUE(_ret.second);
+    }
+
+    // emplace does not overwrite an existing entry
+    EXPECT_FALSE(_data.emplace(&_ctxs.front(), rocprofiler_user_data_t{.value = 1}).second);
+    EXPECT_EQ(_data.size(), _ctxs.size());
+
+    for(size_t i = 0; i < _ctxs.size(); ++i)
+        _data.at(&_ctxs.at(i)).value = i;
+
+    for(size_t i = 0; i < _ctxs.size(); ++i)
+        EXPECT_EQ(_data.at(&_ctxs.at(i)).value, i);
+
+    auto unknown = context::context{};
+    EXPECT_EQ(_data.find(&unknown), _data.end());
+    EXPECT_EQ(common::get_val(_data, &unknown), nullptr);
+    EXPECT_THROW(_data.at(&unknown), std::out_of_range);
+
+    EXPECT_EQ(_data.erase(&_ctxs.back()), 1);
+    EXPECT_EQ(_data.erase(&_ctxs.back()), 0);
+    EXPECT_EQ(_data.size(), _ctxs.size() - 1);
+}
+
+// set ROCPROFILER_TRACING_BENCHMARK_ITERATIONS=10000000 for the full benchmark
+TEST(tracing, external_correlation_overhead)
+{
+    const auto num_iterations =
+        common::get_env<uint64_t>("ROCPROFILER_TRACING_BENCHMARK_ITERATIONS", 1000000);
+
+    constexpr uint32_t client_idx = 0;
+    context::push_client(client_idx);
+
+    auto context_ids = std::vector<rocprofiler_context_id_t>{};
+    for(size_t i = 0; i < 8; ++i)
+    {
+        auto ctx_id = context::allocate_context();
+        ASSERT_TRUE(ctx_id);
+
+        auto* ctx = context::get_mutable_registered_context(*ctx_id);
+        ASSERT_NE(ctx, nullptr);
+
+        ctx->callback_tracer = std::make_unique<context::callback_tracing_service>();
+        ASSERT_EQ(context::add_domain(ctx->callback_tracer->domains, benchmark_domain),
+                  ROCPROFILER_STATUS_SUCCESS);
+        ctx->callback_tracer->callback_data.at(benchmark_domain) = {noop_callback, nullptr};
+        context_ids.emplace_back(*ctx_id);
+    }
+
+    context::pop_client(client_idx);
+
+    size_t num_active = 0;
+    for(size_t num_contexts : {1, 2, 8})
+    {
+        for(; num_active < num_contexts; ++num_active)
+            ASSERT_EQ(context::start_context(context_ids.at(num_active)),
+                      ROCPROFILER_STATUS_SUCCESS);
+
+        callback_count = 0;
+        auto t_beg     = std::chrono::steady_clock::now();
+        for(uint64_t i = 0; i < num_iterations; ++i)
+            traced_noop_api(i + 1);
+        auto t_end = std::chrono::steady_clock::now();
+
+        // enter + exit callback for every context
+        EXPECT_EQ(callback_count, 2 * num_contexts * num_iterations);
+
+        auto elapsed_ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_beg).count();
+        std::cout << "[tracing] " << num_contexts << " context(s): " << std::setprecision(4)
+                  << (static_cast<double>(elapsed_ns) / num_iterations) << " ns/call ("
+                  << num_iterations << " calls)\n"
+                  << std::flush;
+    }
+
+    for(auto itr : context_ids)
+        context::stop_context(itr);
+}
+
+TEST(tracing, api_sampling)
+{
+    constexpr auto buffered_domain = ROCPROFILER_BUFFER_TRACING_HIP_RUNTIME_API;
+    constexpr auto num_calls       = uint64_t{1000};
+    constexpr auto other_op        = rocprofiler_tracing_operation_t{benchmark_op + 1};
+
+    constexpr uint32_t client_idx = 0;
+    context::push_client(client_idx);
+
+    auto ctx_id = context::allocate_context();
+    ASSERT_TRUE(ctx_id);
+
+    auto* ctx = context::get_mutable_registered_context(*ctx_id);
+    ASSERT_NE(ctx, nullptr);
+
+    ctx->callback_tracer = std::make_unique<context::callback_tracing_service>();
+    ctx->buffered_tracer = std::make_unique<context::buffer_tracing_service>();
+    ASSERT_EQ(context::add_domain(ctx->callback_tracer->domains, benchmark_domain),
+              ROCPROFILER_STATUS_SUCCESS);
+    ASSERT_EQ(context::add_domain(ctx->buffered_tracer->domains, buffered_domain),
+              ROCPROFILER_STATUS_SUCCESS);
+
+    auto every_nth     = rocprofiler_tracing_sampling_config_t{};
+    every_nth.policy   = ROCPROFILER_TRACING_SAMPLING_EVERY_NTH;
+    every_nth.interval = 10;
+
+    auto first_k     = every_nth;
+    first_k.policy   = ROCPROFILER_TRACING_SAMPLING_FIRST_K_THEN_NTH;
+    first_k.count    = 5;
+    first_k.interval = 100;
+
+    auto token_bucket   = rocprofiler_tracing_sampling_config_t{};
+    token_bucket.policy = ROCPROFILER_TRACING_SAMPLING_TOKEN_BUCKET;
+    token_bucket.count  = 5;
+    token_bucket.period = std::numeric_limits<uint64_t>::max();
+
+    // only benchmark_op is sampled in the buffer tracing service
+    EXPECT_EQ(context::add_sampling(ctx->buffered_tracer->sampling,
+                                    buffered_domain,
+                                    std::vector<uint32_t>{benchmark_op},
+                                    every_nth),
+              ROCPROFILER_STATUS_SUCCESS);
+    // every op is sampled in the callback tracing service
+    EXPECT_EQ(context::add_sampling(ctx->callback_tracer->sampling,
+                                    benchmark_domain,
+                                    std::vector<uint32_t>{},
+                                    first_k),
+              ROCPROFILER_STATUS_SUCCESS);
+
+    // invalid configurations
+    auto invalid_interval     = every_nth;
+    invalid_interval.interval = 0;
+    EXPECT_EQ(context::add_sampling(
+                  ctx->buffered_tracer->sampling, buffered_domain, {}, invalid_interval),
+              ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT);
+    auto invalid_count  = token_bucket;
+    invalid_count.count = 0;
+    EXPECT_EQ(
+        context::add_sampling(ctx->buffered_tracer->sampling, buffered_domain, {}, invalid_count),
+        ROCPROFILER_STATUS_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(context::add_sampling(ctx->buffered_tracer->sampling,
+                                    ROCPROFILER_BUFFER_TRACING_KERNEL_DISPATCH,
+                                    {},
+                                    every_nth),
+              ROCPROFILER_STATUS_ERROR_KIND_NOT_FOUND);
+    EXPECT_EQ(context::add_sampling(ctx->buffered_tracer->sampling,
+                                    buffered_domain,
+                                    std::vector<uint32_t>{context::domain_ops_padding},
+                                    every_nth),
+              ROCPROFILER_STATUS_ERROR_OPERATION_NOT_FOUND);
+
+    context::pop_client(client_idx);
+    ASSERT_EQ(context::start_context(*ctx_id), ROCPROFILER_STATUS_SUCCESS);
+
+    struct sample_counts
+    {
+        uint64_t callback = 0;
+        uint64_t buffered = 0;
+        uint64_t weight   = 0;
+    };
+
+    auto sample_op = [](rocprofiler_tracing_operation_t _op) {
+        auto _counts = sample_counts{};
+        for(uint64_t i = 0; i < num_calls; ++i)
+        {
+            auto data = tracing::tracing_data{};
+            tracing::populate_contexts(benchmark_domain, buffered_domain, _op, data);
+            _counts.callback += data.callback_contexts.size();
+            _counts.buffered += data.buffered_contexts.size();
+            for(const auto& itr : data.buffered_contexts)
+                _counts.weight += itr.sampling_weight;
+        }
+        return _counts;
+    };
+
+    {
+        auto _counts = sample_op(benchmark_op);
+        // first 5 calls, then calls 5, 105, ..., 905 after the first 5
+        EXPECT_EQ(_counts.callback, uint64_t{5 + 10});
+        // calls 0, 10, ..., 990
+        EXPECT_EQ(_counts.buffered, num_calls / 10);
+        // weights cover every call up to and including the last sampled call
+        EXPECT_EQ(_counts.weight, num_calls - 9);
+    }
+
+    {
+        // other_op is not sampled in the buffer tracing service and has its own sampling state
+        // in the callback tracing service
+        auto _counts = sample_op(other_op);
+        EXPECT_EQ(_counts.callback, uint64_t{5 + 10});
+        EXPECT_EQ(_counts.buffered, num_calls);
+        EXPECT_EQ(_counts.weight, num_calls);
+    }
+
+    context::stop_context(*ctx_id);
+
+    // the token bucket is never refilled within this period
+    auto sampler = context::tracing_sampler{token_bucket};
+    auto traced  = uint64_t{0};
+    for(uint64_t i = 0; i < num_calls; ++i)
+    {
+        auto weight = sampler();
+        if(weight > 0)
+        {
+            ++traced;
+            EXPECT_EQ(weight, uint64_t{1});
+        }
+    }
+    EXPECT_EQ(traced, token_bucket.count);
+}
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include "lib/common/container/small_flat_map.hpp"
 #include "lib/common/container/small_vector.hpp"
 
 #include <rocprofiler-sdk/fwd.h>
@@ -39,15 +40,20 @@ struct correlation_tracing_service;
 }  // namespace context
 namespace tracing
 {
+constexpr auto context_data_vec_size         = 2;
+constexpr auto external_correlation_map_size = 8;
+constexpr auto empty_user_data               = rocprofiler_user_data_t{.value = 0};
+
 template <typename Tp, size_t N>
-using small_vector_t                = common::container::small_vector<Tp, N>;
-using correlation_service           = context::correlation_tracing_service;
-using context_t                     = context::context;
-using context_array_t               = common::container::small_vector<const context_t*>;
-using external_correlation_id_map_t = std::unordered_map<const context_t*, rocprofiler_user_data_t>;
+using small_vector_t      = common::container::small_vector<Tp, N>;
+using correlation_service = context::correlation_tracing_service;
+using context_t           = context::context;
+using context_array_t     = common::container::small_vector<const context_t*>;
 
-constexpr auto context_data_vec_size = 2;
-constexpr auto empty_user_data       = rocprofiler_user_data_t{.value = 0};
+// one entry per active context: stored inline (no heap allocation) for up to
+// external_correlation_map_size contexts
+using external_correlation_id_map_t = common::container::
+    small_flat_map<const context_t*, rocprofiler_user_data_t, external_correlation_map_size>;
 
 struct callback_context_data
 {
@@ -58,7 +64,8 @@ struct callback_context_data
 
 struct buffered_context_data
 {
-    const context_t* ctx = nullptr;
+    const context_t* ctx             = nullptr;
+    uint64_t         sampling_weight = 1;  // number of calls the buffer record represents
 };
 
 using callback_context_data_vec_t = small_vector_t<callback_context_data, context_data_vec_size>;
@@ -30,6 +30,7 @@
 #include <rocprofiler-sdk/fwd.h>
 
 #include <functional>
+#include <type_traits>
 #include <unordered_map>
 #include <vector>
 
@@ -56,6 +57,21 @@ context_filter(const context::context* ctx, DomainT domain, Args... args)
     }
 }
 
+/// returns zero if the context does not trace this call to the operation, otherwise the number of
+/// calls which the traced call represents (always one when sampling is not configured)
+template <typename DomainT>
+inline uint64_t
+sample_call(const context::context* ctx, DomainT domain, rocprofiler_tracing_operation_t op)
+{
+    context::tracing_sampler* sampler = nullptr;
+    if constexpr(std::is_same<DomainT, rocprofiler_buffer_tracing_kind_t>::value)
+        sampler = ctx->buffered_tracer->sampling.get(domain, op);
+    else
+        sampler = ctx->callback_tracer->sampling.get(domain, op);
+
+    return (sampler) ? (*sampler)() : 1;
+}
+
 template <typename ClearContainersT = std::false_type>
 inline void
 populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
@@ -73,16 +89,19 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         extern_corr_ids.clear();
     }
 
-    const auto minimal_context_filter = [](const context_t* ctx) {
-        return (ctx->callback_tracer || ctx->buffered_tracer);
-    };
+    // snapshot of the active tracing contexts, only rebuilt when a context is started/stopped
+    const auto& active = context::get_active_tracing_contexts();
 
-    for(const auto* itr : context::get_active_contexts(minimal_context_filter))
-    {
-        if(!itr) continue;
+    // fast path: no active context traces this domain + op
+    const bool is_callback = active.callback_domains(callback_domain_idx, operation_idx);
+    const bool is_buffered = active.buffered_domains(buffered_domain_idx, operation_idx);
+    if(!is_callback && !is_buffered) return;
 
-        // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, callback_domain_idx, operation_idx))
+    for(const auto* itr : active.contexts)
+    {
+        // if the given domain + op is not enabled or this call is not sampled, skip this context
+        if(is_callback && context_filter(itr, callback_domain_idx, operation_idx) &&
+           sample_call(itr, callback_domain_idx, operation_idx) > 0)
         {
             callback_contexts.emplace_back(
                 callback_context_data{itr, rocprofiler_callback_tracing_record_t{}});
@@ -90,9 +109,13 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         }
 
         // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, buffered_domain_idx, operation_idx))
+        if(is_buffered && context_filter(itr, buffered_domain_idx, operation_idx))
         {
-            buffered_contexts.emplace_back(buffered_context_data{itr});
+            // if this call is not sampled, skip this context
+            auto weight = sample_call(itr, buffered_domain_idx, operation_idx);
+            if(weight == 0) continue;
+
+            buffered_contexts.emplace_back(buffered_context_data{itr, weight});
             extern_corr_ids.emplace(itr, empty_user_data);
         }
     }
@@ -114,24 +137,26 @@ populate_contexts(rocprofiler_callback_tracing_kind_t callback_domain_idx,
         extern_corr_ids.clear();
     }
 
-    const auto minimal_context_filter = [](const context_t* ctx) {
-        return (ctx->callback_tracer || ctx->buffered_tracer);
-    };
+    // snapshot of the active tracing contexts, only rebuilt when a context is started/stopped
+    const auto& active = context::get_active_tracing_contexts();
 
-    for(const auto* itr : context::get_active_contexts(minimal_context_filter))
-    {
-        if(!itr) continue;
+    // fast path: no active context traces this domain
+    const bool is_callback = active.callback_domains(callback_domain_idx);
+    const bool is_buffered = active.buffered_domains(buffered_domain_idx);
+    if(!is_callback && !is_buffered) return;
 
-        // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, callback_domain_idx))
+    for(const auto* itr : active.contexts)
+    {
+        // if the given domain is not enabled, skip this context
+        if(is_callback && context_filter(itr, callback_domain_idx))
         {
             callback_contexts.emplace_back(
                 callback_context_data{itr, rocprofiler_callback_tracing_record_t{}});
             extern_corr_ids.emplace(itr, empty_user_data);
         }
 
-        // if the given domain + op is not enabled, skip this context
-        if(context_filter(itr, buffered_domain_idx))
+        // if the given domain is not enabled, skip this context
+        if(is_buffered && context_filter(itr, buffered_domain_idx))
         {
             buffered_contexts.emplace_back(buffered_context_data{itr});
             extern_corr_ids.emplace(itr, empty_user_data);
@@ -294,6 +319,15 @@ execute_phase_exit_callbacks(callback_context_data_vec_t&         callback_conte
     }
 }
 
+template <typename Tp, typename = void>
+struct has_sampling_weight : std::false_type
+{};
+
+template <typename Tp>
+struct has_sampling_weight<Tp, std::void_t<decltype(std::declval<Tp>().sampling_weight)>>
+: std::true_type
+{};
+
 template <typename BufferRecordT, typename OperationT = rocprofiler_tracing_operation_t>
 inline void
 execute_buffer_record_emplace(const buffered_context_data_vec_t&   buffered_contexts,
@@ -323,6 +357,9 @@ execute_buffer_record_emplace(const buffered_context_data_vec_t&   buffered_cont
             auto record_v = base_record;
             // update the record with the correlation
             record_v.correlation_id.external = external_corr_ids.at(itr.ctx);
+            // records of sampled operations carry the number of calls they represent
+            if constexpr(has_sampling_weight<std::decay_t<BufferRecordT>>::value)
+                record_v.sampling_weight = itr.sampling_weight;
 
             buffer_v->emplace(ROCPROFILER_BUFFER_CATEGORY_TRACING, domain, record_v);
         }
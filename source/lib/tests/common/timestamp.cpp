@@ -0,0 +1,136 @@
+// MIT License
+//
+// Copyright (c) 2023-2025 Advanced Micro Devices, Inc. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "lib/common/tsc_clock.hpp"
+#include "lib/common/utility.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace tsc = ::rocprofiler::common::tsc;
+
+namespace
+{
+constexpr size_t num_benchmark_iterations = 10000000;
+
+template <typename FuncT>
+double
+benchmark(FuncT&& _func)
+{
+    // accumulate the timestamps so the calls cannot be optimized away
+    auto _sum = uint64_t{0};
+    auto _beg = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < num_benchmark_iterations; ++i)
+        _sum += _func();
+    auto _end = std::chrono::steady_clock::now();
+
+    EXPECT_GT(_sum, 0);
+    return std::chrono::duration<double, std::nano>(_end - _beg).count() /
+           static_cast<double>(num_benchmark_iterations);
+}
+}  // namespace
+
+TEST(common, tsc_timestamp)
+{
+    if(!tsc::is_supported()) GTEST_SKIP() << "invariant TSC not supported";
+
+    setenv("ROCPROFILER_TIMESTAMP_SOURCE", "tsc", 1);
+    ASSERT_TRUE(tsc::is_enabled());
+
+    // the converted TSC stays within 100 microseconds of CLOCK_BOOTTIME, including across the
+    // re-calibrations every 100 milliseconds
+    constexpr uint64_t tolerance = 100000;
+
+    auto _prev = tsc::timestamp_ns();
+    auto _end  = std::chrono::steady_clock::now() + std::chrono::milliseconds{350};
+    for(size_t i = 0; std::chrono::steady_clock::now() < _end; ++i)
+    {
+        auto _beg = rocprofiler::common::get_ticks(CLOCK_BOOTTIME);
+        // force a re-calibration on some of the iterations
+        auto _val = (i % 16 == 0) ? tsc::resync() : tsc::timestamp_ns();
+        auto _ref = rocprofiler::common::get_ticks(CLOCK_BOOTTIME);
+
+        EXPECT_GE(_val + tolerance, _beg);
+        EXPECT_LE(_val, _ref + tolerance);
+        EXPECT_GE(_val, _prev);
+        _prev = _val;
+
+        std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+}
+
+TEST(common, tsc_timestamp_monotonic)
+{
+    if(!tsc::is_supported()) GTEST_SKIP() << "invariant TSC not supported";
+
+    setenv("ROCPROFILER_TIMESTAMP_SOURCE", "tsc", 1);
+    ASSERT_TRUE(tsc::is_enabled());
+
+    // the timestamps of each thread never decrease while another thread keeps re-calibrating
+    auto _done   = std::atomic<bool>{false};
+    auto _resync = std::thread{[&_done]() {
+        while(!_done.load(std::memory_order_relaxed))
+            tsc::resync();
+    }};
+
+    auto _readers = std::vector<std::thread>{};
+    for(size_t n = 0; n < 4; ++n)
+    {
+        _readers.emplace_back([]() {
+            auto _prev = tsc::timestamp_ns();
+            for(size_t i = 0; i < 1000000; ++i)
+            {
+                auto _val = tsc::timestamp_ns();
+                ASSERT_GE(_val, _prev) << "iteration " << i;
+                _prev = _val;
+            }
+        });
+    }
+
+    for(auto& itr : _readers)
+        itr.join();
+    _done.store(true, std::memory_order_relaxed);
+    _resync.join();
+}
+
+TEST(common, tsc_timestamp_benchmark)
+{
+    if(!tsc::is_supported()) GTEST_SKIP() << "invariant TSC not supported";
+
+    setenv("ROCPROFILER_TIMESTAMP_SOURCE", "tsc", 1);
+    ASSERT_TRUE(tsc::is_enabled());
+
+    auto _clock_gettime_ns =
+        benchmark([]() { return rocprofiler::common::get_ticks(CLOCK_BOOTTIME); });
+    auto _tsc_ns = benchmark([]() { return tsc::timestamp_ns(); });
+
+    std::cout << "clock_gettime(CLOCK_BOOTTIME): " << _clock_gettime_ns << " ns/call\n"
+              << "TSC:                           " << _tsc_ns << " ns/call\n"
+              << std::flush;
+}
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+
+# MIT License
+#
+# Copyright (c) 2024-2025 Advanced Micro Devices, Inc. All rights reserved.
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+# THE SOFTWARE.
+
+import sys
+import pytest
+
+# transpose 2 500 10: two threads with 2 + 500 kernel dispatches each
+num_dispatches = 1004
+num_iterations = 1000
+
+
+def test_no_trace_records(json_data):
+    data = json_data["rocprofiler-sdk-tool"]
+
+    # the aggregated tracing types do not write individual records
+    assert len(data["buffer_records"].get("kernel_dispatch", [])) == 0
+    assert len(data["buffer_records"].get("hip_api", [])) == 0
+
+
+def test_summary_data(json_data, kernel_rename):
+    data = json_data["rocprofiler-sdk-tool"]
+
+    domains = [itr.domain for itr in data.summary]
+    assert "KERNEL_DISPATCH" in domains
+    assert "HIP_API" in domains
+
+    for itr in data.summary:
+        if itr.domain != "KERNEL_DISPATCH":
+            continue
+
+        assert itr.stats.count == num_dispatches
+        names = [oitr.key for oitr in itr.stats.operations]
+        if kernel_rename:
+            assert "run/iteration" in names
+        else:
+            assert "run/iteration" not in names
+
+
+def test_kernel_stats(kernel_stats_data, kernel_rename):
+    assert len(kernel_stats_data) > 0
+
+    calls = dict([[row["Name"], int(row["Calls"])] for row in kernel_stats_data])
+    assert sum(calls.values()) == num_dispatches
+
+    if kernel_rename:
+        assert calls["run/iteration"] == num_iterations
+    else:
+        # the dispatches are aggregated per kernel, not per renamed range
+        assert "run/iteration" not in calls
+        for name in calls.keys():
+            assert not name.startswith("run/"), f"{name}"
+
+    for row in kernel_stats_data:
+        quantiles = [int(row[itr]) for itr in ("P50Ns", "P90Ns", "P99Ns", "P999Ns")]
+        assert int(row["MinNs"]) <= quantiles[0], f"{row}"
+        assert quantiles == sorted(quantiles), f"{row}"
+        assert quantiles[-1] <= int(row["MaxNs"]), f"{row}"
+
+
+def test_histograms(histogram_data, kernel_stats_data):
+    assert len(histogram_data) > 0
+
+    # the bucket counts of each kernel add up to its number of calls
+    counts = {}
+    for row in histogram_data:
+        assert int(row["Bucket_Lower_Bound_Ns"]) <= int(row["Bucket_Upper_Bound_Ns"])
+        assert int(row["Count"]) > 0
+        if row["Domain"] == "KERNEL_DISPATCH":
+            counts[row["Name"]] = counts.get(row["Name"], 0) + int(row["Count"])
+
+    calls = dict([[row["Name"], int(row["Calls"])] for row in kernel_stats_data])
+    assert counts == calls
+
+
+if __name__ == "__main__":
+    exit_code = pytest.main(["-x", __file__] + sys.argv[1:])
+    sys.exit(exit_code)
@@ -50,6 +50,26 @@ def pytest_addoption(parser):
         help="Path to CSV file containing agents information.",
     )
 
+    parser.addoption(
+        "--input-aggregate-csv",
+        action="store",
+        help="Path to CSV file containing the per-instruction PC sample aggregates.",
+    )
+
+    parser.addoption(
+        "--input-json",
+        action="store",
+        help="Path to JSON file.",
+    )
+
+    parser.addoption(
+        "--reservoir-size",
+        action="store",
+        type=int,
+        default=0,
+        help="Number of raw PC samples retained in aggregation mode.",
+    )
+
 
 @pytest.fixture
 def input_samples_csv(request):
@@ -85,3 +105,31 @@ def input_agent_info_csv(request):
     filename = request.config.getoption("--input-agent-info-csv")
     with open(filename, "r") as inp:
         return pd.read_csv(inp)
+
+
+@pytest.fixture
+def input_aggregate_csv(request):
+    filename = request.config.getoption("--input-aggregate-csv")
+    if not os.path.isfile(filename):
+        # see input_samples_csv
+        print("PC sampling unavailable")
+    else:
+        with open(filename, "r") as inp:
+            return pd.read_csv(
+                inp,
+                na_filter=False,
+                keep_default_na=False,
+                dtype={"Instruction": str, "Instruction_Comment": str},
+            )
+
+
+@pytest.fixture
+def input_json(request):
+    filename = request.config.getoption("--input-json")
+    with open(filename, "r") as inp:
+        return dotdict(collapse_dict_list(json.load(inp)))
+
+
+@pytest.fixture
+def reservoir_size(request):
+    return request.config.getoption("--reservoir-size")
@@ -81,6 +81,63 @@ def test_multi_agent_support(
     ).all()
 
 
+def test_aggregate(
+    input_samples_csv: pd.DataFrame,
+    input_aggregate_csv: pd.DataFrame,
+    input_json,
+    reservoir_size,
+):
+    data = input_json["rocprofiler-sdk-tool"]
+
+    # only the reservoir of raw samples is written
+    assert len(input_samples_csv) > 0
+    assert len(input_samples_csv) <= reservoir_size
+    assert len(data["buffer_records"]["pc_sample_host_trap"]) == len(input_samples_csv)
+
+    # most sampled instructions first
+    assert len(input_aggregate_csv) > 0
+    counts = input_aggregate_csv["Sample_Count"].to_list()
+    assert counts == sorted(counts, reverse=True)
+    assert (input_aggregate_csv["Sample_Count"] > 0).all()
+    assert sum(counts) >= len(input_samples_csv)
+
+    assert (input_aggregate_csv["Active_Lanes_Min"] >= 1).all()
+    assert (
+        input_aggregate_csv["Active_Lanes_Min"] <= input_aggregate_csv["Active_Lanes_Mean"]
+    ).all()
+    assert (
+        input_aggregate_csv["Active_Lanes_Mean"] <= input_aggregate_csv["Active_Lanes_Max"]
+    ).all()
+    assert (input_aggregate_csv["Active_Lanes_Max"] <= 64).all()
+    assert (
+        input_aggregate_csv["First_Sample_Timestamp"]
+        <= input_aggregate_csv["Last_Sample_Timestamp"]
+    ).all()
+
+    # every retained sample belongs to an aggregated instruction
+    instructions = set(input_aggregate_csv["Instruction"].to_list())
+    for instruction in input_samples_csv["Instruction"]:
+        if instruction:
+            assert instruction in instructions, f"{instruction}"
+
+    # the JSON output holds the same table in the same order
+    json_table = data["pc_sample_host_trap_aggregate"]
+    assert len(json_table) == len(input_aggregate_csv)
+    for json_row, (_, csv_row) in zip(json_table, input_aggregate_csv.iterrows()):
+        assert json_row["code_object_id"] == csv_row["Code_Object_Id"]
+        assert json_row["code_object_offset"] == csv_row["Code_Object_Offset"]
+        assert json_row["sample_count"] == csv_row["Sample_Count"]
+        assert json_row["active_lanes_min"] == csv_row["Active_Lanes_Min"]
+        assert json_row["active_lanes_max"] == csv_row["Active_Lanes_Max"]
+        assert json_row["first_sample_timestamp"] == csv_row["First_Sample_Timestamp"]
+        assert json_row["last_sample_timestamp"] == csv_row["Last_Sample_Timestamp"]
+        if json_row["inst_index"] >= 0:
+            assert (
+                data["strings"]["pc_sample_instructions"][json_row["inst_index"]]
+                == csv_row["Instruction"]
+            )
+
+
 if __name__ == "__main__":
     exit_code = pytest.main(["-x", __file__] + sys.argv[1:])
     sys.exit(exit_code)
@@ -58,6 +58,11 @@ def validate_stats(row):
     assert max_v > avg_v if cnt_v > 1 else max_v == int(avg_v), f"{row}"
     assert stddev_v > 0.0 if cnt_v > 1 else int(stddev_v) == 0, f"{row}"
 
+    percentiles = [int(row[itr]) for itr in ("P50Ns", "P90Ns", "P99Ns", "P999Ns")]
+    assert min_v <= percentiles[0], f"{row}"
+    assert percentiles[-1] <= max_v, f"{row}"
+    assert percentiles == sorted(percentiles), f"{row}"
+
 
 def test_api_trace(
     hsa_input_data,
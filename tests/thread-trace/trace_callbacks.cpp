@@ -73,7 +73,7 @@ tool_codeobj_tracing_callback(rocprofiler_callback_tracing_record_t record,
 
         std::ofstream file(tool.out_dir + name, std::ios::binary);
         assert(file.is_open() && "Could not open codeobj file for writing");
-        file.write((char*) binary.buffer.data(), binary.buffer.size());
+        file.write(binary.view->data(), static_cast<std::streamsize>(binary.view->size()));
     }
     else
     {